@@ -134,13 +134,41 @@ def df_fdds_dispersion(primary, auxiliary, cache, leg_points=10, leg_lambda=0.3,
     total_uc = 0
     total_c = 0
 
-    for point, weight in zip(*np.polynomial.legendre.leggauss(leg_points)):
-
-        omega = leg_lambda * (1.0 - point) / (1.0 + point)
+    # Uncoupled amplitudes are formed in batches of frequencies that share one pass over the (ia|Q)
+    # tensors; the A amplitudes of a batch are held while the B ones are built. Only this part is
+    # batched, the coupled solve below is still done one frequency at a time with naux x naux work.
+    # About twelve naux x naux matrices are held besides the batches: the metric and its inverse,
+    # W_A, W_B, the S^(+-1/2) temporaries and the per-frequency coupled work. When two frequencies
+    # do not fit beside them, the amplitudes are formed one frequency at a time within the whole
+    # budget, as they were before batching.
+    naux = auxiliary.nbf()
+    nwork = 12
+    points, weights = np.polynomial.legendre.leggauss(leg_points)
+    omegas = [leg_lambda * (1.0 - point) / (1.0 + point) for point in points]
+    nbatch = max(1, min(leg_points, fdds_obj.omega_batch_size(nwork)))
+
+    X_A_batch = []
+    X_B_batch = []
+    for nw, (point, weight) in enumerate(zip(points, weights)):
+
+        omega = omegas[nw]
         lambda_scale = ((2.0 * leg_lambda) / (point + 1.0)**2)
 
+        # Uncoupled amplitudes of the next batch
+        if nbatch == 1:
+            del X_A_batch, X_B_batch
+            X_A_batch = [fdds_obj.form_unc_amplitude("A", omega)]
+            X_B_batch = [fdds_obj.form_unc_amplitude("B", omega)]
+        elif nw % nbatch == 0:
+            del X_A_batch, X_B_batch
+            batch_omegas = omegas[nw:nw + nbatch]
+            # omega_batch_size() leaves at least this much for the A batch, and the A batch for B
+            doubles = int(core.get_memory() * 0.8 / 8) - nwork * naux * naux
+            X_A_batch = fdds_obj.form_unc_amplitudes("A", batch_omegas, doubles)
+            X_B_batch = fdds_obj.form_unc_amplitudes("B", batch_omegas, doubles - len(batch_omegas) * naux * naux)
+
         # Monomer A
-        X_A = fdds_obj.form_unc_amplitude("A", omega)
+        X_A = X_A_batch[nw % nbatch]
 
         # Coupled A
         X_A_coupled = X_A.clone()
@@ -154,7 +182,7 @@ def df_fdds_dispersion(primary, auxiliary, cache, leg_points=10, leg_lambda=0.3,
         X_A_coupled.axpy(-1.0, core.triplet(XSW_A, amplitude, X_A, False, False, False))
         del XSW_A, amplitude
 
-        X_B = fdds_obj.form_unc_amplitude("B", omega)
+        X_B = X_B_batch[nw % nbatch]
         # print(np.linalg.norm(X_B))
 
         # Coupled B
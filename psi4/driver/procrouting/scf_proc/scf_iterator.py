@@ -218,6 +218,8 @@ def scf_initialize(self):
         core.timer_on("HF: Guess")
         self.guess()
         core.timer_off("HF: Guess")
+        # Energy of the guess density, filled in by the first iteration
+        self.guess_energy_ = None
         # Print out initial docc/socc/etc data
         if self.get_print():                    
             lack_occupancy = core.get_local_option('SCF', 'GUESS') in ['SAD']
@@ -449,6 +451,9 @@ def scf_iterate(self, e_conv=None, d_conv=None):
             ("DF-" if is_dfjk else "", reference, "SAD" if
              ((self.iteration_ == 0) and self.sad_) else self.iteration_, SCFE, Ediff, Dnorm, '/'.join(status)))
 
+        if getattr(self, 'guess_energy_', 0.0) is None:
+            self.guess_energy_ = SCFE
+
         # if a an excited MOM is requested but not started, don't stop yet
         if self.MOM_excited_ and not self.MOM_performed_:
             continue
@@ -692,6 +697,11 @@ def scf_print_energies(self):
     if hasattr(self.molecule(), 'EFP'):
         core.print_out("    EFP Energy =                      {:24.16f}\n".format(eefp))
     core.print_out("    Total Energy =                    {:24.16f}\n".format(total_energy))
+
+    if getattr(self, 'guess_energy_', None) is not None:
+        core.print_out("\n   => Guess Quality <=\n\n")
+        core.print_out("    Guess Energy Error =              {:24.16f}\n".format(self.guess_energy_ - total_energy))
+        core.print_out("    Iterations to Convergence =       {:24d}\n".format(self.iteration_))
     
     if core.get_option('SCF', 'PE'):
         core.print_out(self.pe_state.cppe_state.summary_string)
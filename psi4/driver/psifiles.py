@@ -213,6 +213,7 @@ PSIF_DFOCC_IABC             =  279  # DFOCC (IA|BC)
 PSIF_DFOCC_ABIC             =  280  # DFOCC <AB|IC>
 PSIF_DFOCC_MIABC            =  281  # DFOCC M_iabc
 PSIF_DFOCC_TEMP             =  282  # DFOCC temporary storage
+PSIF_DPD_SORT               =  283  # DPD out-of-core sort scratch
 PSIF_SAD                    =  300  # A SAD file (File for SAD related quantities
 PSIF_CI_HD_FILE             =  350  # DETCI H diagonal
 PSIF_CI_C_FILE              =  351  # DETCI CI coeffs
@@ -291,6 +291,7 @@
 #define PSIF_DFOCC_ABIC          280  /*- DFOCC <AB|IC> -*/
 #define PSIF_DFOCC_MIABC         281  /*- DFOCC M_iabc -*/
 #define PSIF_DFOCC_TEMP          282  /*- DFOCC temporary storage -*/
+#define PSIF_DPD_SORT            283  /*- DPD out-of-core sort scratch -*/
 
 #define PSIF_SAD                 300  /*- A SAD file (File for SAD related quantities -*/
 
@@ -343,6 +343,11 @@ SharedWavefunction py_psi_dfocc(SharedWavefunction ref_wfn) {
     return dfoccwave::dfoccwave(ref_wfn, Process::environment.options);
 }
 
+SharedWavefunction py_psi_libfock(SharedWavefunction ref_wfn) {
+    py_psi_prepare_options_for_module("CPHF");
+    return libfock::libfock(ref_wfn, Process::environment.options);
+}
+
 SharedWavefunction py_psi_mcscf(SharedWavefunction ref_wfn) {
     py_psi_prepare_options_for_module("MCSCF");
     return mcscf::mcscf(ref_wfn, Process::environment.options);
@@ -1346,6 +1351,7 @@ PYBIND11_MODULE(core, core) {
     core.def("cceom", py_psi_cceom, "Runs the equation of motion coupled cluster code, for excited states.");
     core.def("occ", py_psi_occ, "Runs the orbital optimized CC codes.");
     core.def("dfocc", py_psi_dfocc, "Runs the density-fitted orbital optimized CC codes.");
+    core.def("libfock", py_psi_libfock, "Runs the libfock CPHF/CIS/TDA application set by the CPHF MODULE option.");
     core.def("adc", py_psi_adc, "Runs the ADC propagator code, for excited states.");
     core.def("opt_clean", py_psi_opt_clean, "Cleans up the optimizer's scratch files.");
     core.def("get_options", py_psi_get_options, py::return_value_policy::reference, "Get options");
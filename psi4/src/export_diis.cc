@@ -27,6 +27,7 @@
  */
 
 #include "psi4/pybind11.h"
+#include <pybind11/stl.h>
 
 #include "psi4/libdiis/diisentry.h"
 #include "psi4/libdiis/diismanager.h"
@@ -35,8 +36,41 @@ using namespace psi;
 namespace py = pybind11;
 
 void export_diis(py::module &m) {
-    py::class_<DIISManager, std::shared_ptr<DIISManager> >(m, "DIISManager", "docstring")
-        .def(py::init<>())
+    py::class_<DIISManager, std::shared_ptr<DIISManager> > diis(m, "DIISManager", "docstring");
+
+    py::enum_<DIISManager::RemovalPolicy>(diis, "RemovalPolicy", "How vectors are removed from a full subspace")
+        .value("LargestError", DIISManager::LargestError)
+        .value("OldestAdded", DIISManager::OldestAdded)
+        .export_values();
+
+    py::enum_<DIISManager::StoragePolicy>(diis, "StoragePolicy", "Where the subspace vectors are kept")
+        .value("InCore", DIISManager::InCore)
+        .value("OnDisk", DIISManager::OnDisk)
+        .export_values();
+
+    diis.def(py::init<>())
+        .def(py::init<int, const std::string&, DIISManager::RemovalPolicy, DIISManager::StoragePolicy>())
+        .def("set_error_vector_size",
+             [](DIISManager& diis, SharedMatrix error) { diis.set_error_vector_size(error); },
+             "Sets the error vector size from a matrix of its shape")
+        .def("set_vector_size", [](DIISManager& diis, SharedMatrix state) { diis.set_vector_size(state); },
+             "Sets the vector size from a matrix of its shape")
+        .def("add_entry", [](DIISManager& diis, SharedMatrix state, SharedMatrix error) {
+                 return diis.add_entry(state, error);
+             },
+             "Adds a vector and its error vector to the subspace")
+        .def("extrapolate", [](DIISManager& diis, SharedMatrix extrapolated) { return diis.extrapolate(extrapolated); },
+             "Writes the DIIS extrapolation into the matrix")
+        .def("diis_coefficients", &DIISManager::diis_coefficients,
+             "The DIIS coefficients of the current subspace, in subspace order")
+        .def("error_dot_products", &DIISManager::error_dot_products,
+             "The matrix of error vector dot products of the current subspace")
+        .def("extrapolate_with_coefficients",
+             [](DIISManager& diis, const std::vector<double>& coefficients, SharedMatrix extrapolated) {
+                 return diis.extrapolate_with_coefficients(coefficients, extrapolated);
+             },
+             "Writes the combination of the subspace vectors with the given coefficients into the matrix")
+        .def("subspace_size", &DIISManager::subspace_size, "The number of vectors in the subspace")
         .def("reset_subspace", &DIISManager::reset_subspace, "docstring")
         .def("delete_diis_file", &DIISManager::delete_diis_file, "docstring");
 }
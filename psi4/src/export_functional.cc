@@ -309,5 +309,10 @@ void export_functional(py::module &m) {
         .def("project_densities", &sapt::FDDS_Dispersion::project_densities,
              "Projects a density from the primary AO to auxiliary AO space.")
         .def("form_unc_amplitude", &sapt::FDDS_Dispersion::form_unc_amplitude,
-             "Forms the uncoupled amplitudes for either monomer.");
+             "Forms the uncoupled amplitudes for either monomer.")
+        .def("form_unc_amplitudes", &sapt::FDDS_Dispersion::form_unc_amplitudes,
+             "Forms the uncoupled amplitudes of several frequencies for either monomer in one pass, within the\n"
+             "given number of doubles.")
+        .def("omega_batch_size", &sapt::FDDS_Dispersion::omega_batch_size,
+             "Number of frequencies whose amplitudes fit in memory at once.");
 }
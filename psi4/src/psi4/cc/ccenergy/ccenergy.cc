@@ -111,7 +111,8 @@ double CCEnergyWavefunction::compute_energy() {
         spaces.push_back(moinfo_.bvirtpi);
         spaces.push_back(moinfo_.bvir_sym);
         delete[] dpd_list[0];
-        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, 0, cachefiles.data(), cachelist, nullptr, 4, spaces);
+        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, params_.cachetype, cachefiles.data(), cachelist,
+                              nullptr, 4, spaces);
         dpd_set_default(0);
 
         if (params_.df) {
@@ -481,6 +482,10 @@ double CCEnergyWavefunction::compute_energy() {
 
     if (params_.brueckner) Process::environment.globals["BRUECKNER CONVERGED"] = rotate();
 
+    if (params_.cachetype == 2 || params_.print > 1) global_dpd_->file4_cache_print_stats("outfile");
+    if (params_.cachetype == 2)
+        Process::environment.globals["CC CACHE NON-LFU EVICTIONS"] = global_dpd_->file4_cache_nonlfu_evictions();
+
     if (params_.aobasis != "NONE") dpd_close(1);
     dpd_close(0);
 
@@ -46,6 +46,7 @@ struct Params {
     int restart;
     long int memory;
     int cachelev;
+    int cachetype;
     int aobasis;
     std::string wfn;
     int ref;
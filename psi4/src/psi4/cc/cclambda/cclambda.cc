@@ -148,7 +148,7 @@ double CCLambdaWavefunction::compute_energy() {
         spaces.push_back(moinfo.occ_sym);
         spaces.push_back(moinfo.virtpi);
         spaces.push_back(moinfo.vir_sym);
-        dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, nullptr, 2, spaces);
+        dpd_init(0, moinfo.nirreps, params.memory, params.cachetype, cachefiles, cachelist, nullptr, 2, spaces);
 
         if (params.aobasis) { /* Set up new DPD for AO-basis algorithm */
             std::vector<int *> aospaces;
@@ -173,7 +173,7 @@ double CCLambdaWavefunction::compute_energy() {
         spaces.push_back(moinfo.bvirtpi);
         spaces.push_back(moinfo.bvir_sym);
 
-        dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, nullptr, 4, spaces);
+        dpd_init(0, moinfo.nirreps, params.memory, params.cachetype, cachefiles, cachelist, nullptr, 4, spaces);
 
         if (params.aobasis) { /* Set up new DPD's for AO-basis algorithm */
             std::vector<int *> aospaces;
@@ -308,6 +308,8 @@ double CCLambdaWavefunction::compute_energy() {
 
     if (params.local) local_done();
 
+    if (params.cachetype == 2 || params.print > 1) global_dpd_->file4_cache_print_stats("outfile");
+
     dpd_close(0);
 
     if (params.ref == 2)
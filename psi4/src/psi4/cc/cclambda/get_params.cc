@@ -92,6 +92,8 @@ void CCLambdaWavefunction::get_params(Options &options) {
     params.cachelev = 2;
     params.cachelev = options.get_int("CACHELEVEL");
 
+    params.cachetype = (options.get_str("CACHETYPE") == "COST") ? 2 : 0;
+
     params.sekino = 0;
     params.sekino = options.get_bool("SEKINO");
 
@@ -424,6 +426,7 @@ void CCLambdaWavefunction::get_params(Options &options) {
     outfile->Printf("\tConvergence       = %3.1e\n", params.convergence);
     outfile->Printf("\tRestart           =     %s\n", params.restart ? "Yes" : "No");
     outfile->Printf("\tCache Level       =     %1d\n", params.cachelev);
+    outfile->Printf("\tCache Type        =  %4s\n", params.cachetype == 2 ? "COST" : "LRU");
     outfile->Printf("\tModel III         =     %s\n", params.sekino ? "Yes" : "No");
     outfile->Printf("\tDIIS              =     %s\n", params.diis ? "Yes" : "No");
     outfile->Printf("\tAO Basis          =     %s\n", params.aobasis ? "Yes" : "No");
@@ -29,9 +29,12 @@
 /*! \file \ingroup CCTRIPLES
     \brief Enter brief description of file here
 */
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -53,7 +56,8 @@
 namespace psi {
 namespace cctriples {
 
-struct ET_RHF_thread_data {
+/* Quantities shared read-only by all threads */
+struct ET_RHF_data {
     dpdfile2 *fIJ;
     dpdfile2 *fAB;
     dpdfile2 *fIA;
@@ -61,25 +65,104 @@ struct ET_RHF_thread_data {
     dpdbuf4 *T2;
     dpdbuf4 *Eints;
     dpdbuf4 *Dints;
-    dpdbuf4 *Fints_local;
-    double *ET_local;
-    int Gi;
-    int Gj;
-    int Gk;
-    int first_ijk;
-    int last_ijk;
+    dpdbuf4 *Fints;
+    int Fincore; /* all of F <ia|bc> is held in core */
 };
 
-void ET_RHF_thread(ET_RHF_thread_data *);
+/* Per-thread scratch space, allocated once before the threaded loop and
+   reused for every ijk handled by the thread */
+struct ET_RHF_workspace {
+    double **buf[6];                   /* W0, W1, V, X, Y, Z */
+    std::vector<double *> rows[6];     /* row pointers into buf */
+    std::vector<double **> blocks[6];  /* per-irrep [ab][c] blocks */
+    int Gijk;                          /* symmetry the blocks are set up for */
+    size_t size;                       /* words in use for the current Gijk */
+    double **slab[3];                  /* F_{Id}^{ab} for I, J and K */
+    std::vector<double *> Fptr[3];     /* per-Gd blocks of the slabs */
+    std::vector<double *> slab_rows;
+};
+
+/* One unit of work: a fixed (I,J) pair with I >= J and all K <= J */
+struct ET_RHF_task {
+    int Gi, i;
+    int Gj, j;
+    long int nk;
+};
+
+/* Words needed for all of F_{Id}^{ab} of one occupied orbital in irrep Gi */
+static size_t ET_RHF_slab_size(dpdbuf4 *Fints, int Gi) {
+    size_t size = 0;
+    for (int Gd = 0; Gd < moinfo.nirreps; Gd++) size += (size_t)moinfo.virtpi[Gd] * Fints->params->coltot[Gi ^ Gd];
+    return size;
+}
+
+/* Words needed for one [ab][c] intermediate of symmetry Gijk */
+static size_t ET_RHF_W_size(dpdbuf4 *Fints, int Gijk) {
+    size_t size = 0;
+    for (int Gab = 0; Gab < moinfo.nirreps; Gab++)
+        size += (size_t)Fints->params->coltot[Gab] * moinfo.virtpi[Gab ^ Gijk];
+    return size;
+}
+
+/* Point the per-irrep blocks of the six intermediates at the flat buffers for symmetry Gijk */
+static void ET_RHF_set_blocks(ET_RHF_workspace &ws, dpdbuf4 *Fints, int Gijk) {
+    int nirreps = moinfo.nirreps;
+    if (ws.Gijk == Gijk) return;
+    for (int m = 0; m < 6; m++) {
+        size_t offset = 0, row = 0;
+        for (int Gab = 0; Gab < nirreps; Gab++) {
+            int ncols = moinfo.virtpi[Gab ^ Gijk];
+            ws.blocks[m][Gab] = ws.rows[m].data() + row;
+            for (int ab = 0; ab < Fints->params->coltot[Gab]; ab++, row++) {
+                ws.rows[m][row] = ws.buf[m][0] + offset;
+                offset += ncols;
+            }
+        }
+        ws.size = offset;
+    }
+    ws.Gijk = Gijk;
+}
+
+/* Point F[Gd] at the F_{Id}^{ab} block (rows d of irrep Gd, columns ab) of
+   occupied orbital I, reading it into slab n of the workspace unless all of
+   F is in core */
+static void ET_RHF_get_F(ET_RHF_data &data, ET_RHF_workspace &ws, int n, int I, int Gi) {
+    dpdbuf4 *Fints = data.Fints;
+    int nirreps = moinfo.nirreps;
+    size_t offset = 0;
+
+    for (int Gd = 0; Gd < nirreps; Gd++) {
+        int Gid = Gi ^ Gd;
+        int nrows = moinfo.virtpi[Gd];
+        int ncols = Fints->params->coltot[Gid];
+        if (!nrows || !ncols) {
+            ws.Fptr[n][Gd] = nullptr;
+            continue;
+        }
+        if (data.Fincore) {
+            ws.Fptr[n][Gd] = Fints->matrix[Gid][Fints->row_offset[Gid][I]];
+            continue;
+        }
+        ws.Fptr[n][Gd] = ws.slab[n][0] + offset;
+        for (int d = 0; d < nrows; d++) ws.slab_rows[d] = ws.Fptr[n][Gd] + (size_t)d * ncols;
+#pragma omp critical
+        {
+            Fints->matrix[Gid] = ws.slab_rows.data();
+            global_dpd_->buf4_mat_irrep_rd_block(Fints, Gid, Fints->row_offset[Gid][I], nrows);
+        }
+        offset += (size_t)nrows * ncols;
+    }
+}
+
+double ET_RHF_ijk(ET_RHF_data &data, ET_RHF_workspace &ws, int Gi, int i, int Gj, int j, int Gk, int k);
 
 double ET_RHF() {
-    int i, j, k, I, J, K, Gi, Gj, Gk, h, nirreps, cnt;
-    int nijk, nthreads, thread, *ijk_part;
+    int i, j, k, I, J, K, Gi, Gj, Gk, h, nirreps;
+    int nijk, nthreads, thread;
     int *occpi, *virtpi, *occ_off, *vir_off;
-    double ET, *ET_array;
+    double ET;
     dpdfile2 fIJ, fAB, fIA, T1;
-    dpdbuf4 T2, Eints, Dints, *Fints_array;
-    FILE *ijkfile;
+    dpdbuf4 T2, Eints, Dints, Fints;
 
     timer_on("ET_RHF");
 
@@ -91,39 +174,6 @@ double ET_RHF() {
 
     nthreads = params.nthreads;
 
-    long int mem_avail = dpd_memfree();
-    // Find the size of 4 abc-blocks of the largest irrep
-    long int max_a = 0;
-    for (h = 0; h < nirreps; ++h)
-        if (virtpi[h] > max_a) max_a = virtpi[h];
-    long int thread_mem_estimate = 4 * max_a * max_a * max_a;
-
-    outfile->Printf("    Memory available in words        : %15ld\n", mem_avail);
-    outfile->Printf("    ~Words needed per explicit thread: %15ld\n", thread_mem_estimate);
-
-    // subtract at least 1/2 for non-abc quantities (mainly 2 ijab's + other buffers)
-    double tval = (double)mem_avail / (double)thread_mem_estimate;
-    int possible_nthreads = tval - 0.5;
-    if (possible_nthreads < 1) possible_nthreads = 1;
-
-    // note keyword is not detected in cctriples section if cctriples is called
-    // by ccenergy directly as in energy(ccsd't') at present.
-    if (possible_nthreads < nthreads) {
-        nthreads = possible_nthreads;
-        outfile->Printf("    Reducing threads due to memory limitations.\n");
-    }
-
-    outfile->Printf("    Number of threads for explicit ijk threading: %4d\n\n", nthreads);
-
-// Don't parallelize mkl if explicit threads are used; should be added for acml too.
-#ifdef USING_LAPACK_MKL
-    int old_threads = mkl_get_max_threads();
-    mkl_set_num_threads(1);
-    outfile->Printf("    MKL num_threads set to 1 for explicit threading.\n\n");
-#endif
-
-    std::vector<ET_RHF_thread_data> thread_data_array(nthreads);
-
     global_dpd_->file2_init(&fIJ, PSIF_CC_OEI, 0, 0, 0, "fIJ");
     global_dpd_->file2_init(&fAB, PSIF_CC_OEI, 0, 1, 1, "fAB");
     global_dpd_->file2_init(&fIA, PSIF_CC_OEI, 0, 0, 1, "fIA");
@@ -151,30 +201,95 @@ double ET_RHF() {
         global_dpd_->buf4_mat_irrep_init(&Dints, h);
         global_dpd_->buf4_mat_irrep_rd(&Dints, h);
     }
-    auto mode = std::ostream::trunc;
-    auto printer = std::make_shared<PsiOutStream>("ijk.dat", mode);
-    // ffile(&ijkfile,"ijk.dat", 0);
+    global_dpd_->buf4_init(&Fints, PSIF_CC_FINTS, 0, 10, 5, 10, 5, 0, "F <ia|bc>");
+
+    /* Memory estimate: each thread needs six [ab][c] intermediates, plus three
+       F_{Id}^{ab} slabs unless the whole of F <ia|bc> can be kept in core.
+       Prefer keeping F in core (no I/O inside the threaded loop) as long as
+       that does not cost threads. */
+    long int mem_avail = dpd_memfree();
+    size_t Wsize = 0, slab_size = 0, Fsize = 0;
+    for (h = 0; h < nirreps; h++) {
+        Wsize = std::max(Wsize, ET_RHF_W_size(&Fints, h));
+        slab_size = std::max(slab_size, ET_RHF_slab_size(&Fints, h));
+        Fsize += (size_t)Fints.params->rowtot[h] * Fints.params->coltot[h];
+    }
+    Wsize = std::max(Wsize, (size_t)1);
+    slab_size = std::max(slab_size, (size_t)1);
+    long int thread_mem_incore = 6 * Wsize;
+    long int thread_mem_slabs = 6 * Wsize + 3 * slab_size;
+
+    int Fincore = 0;
+    if ((long int)Fsize + nthreads * thread_mem_incore <= mem_avail) {
+        Fincore = 1;
+    } else {
+        int possible_nthreads = mem_avail / thread_mem_slabs;
+        if (possible_nthreads < 1) possible_nthreads = 1;
+        // note keyword is not detected in cctriples section if cctriples is called
+        // by ccenergy directly as in energy(ccsd't') at present.
+        if (possible_nthreads < nthreads) {
+            nthreads = possible_nthreads;
+            outfile->Printf("    Reducing threads due to memory limitations.\n");
+        }
+    }
 
-    /* each thread gets its own F buffer to assign memory and read blocks
-       into and its own energy double - all else shared */
-    Fints_array = (dpdbuf4 *)malloc(nthreads * sizeof(dpdbuf4));
-    for (thread = 0; thread < nthreads; ++thread)
-        global_dpd_->buf4_init(&(Fints_array[thread]), PSIF_CC_FINTS, 0, 10, 5, 10, 5, 0, "F <ia|bc>");
-    ET_array = (double *)malloc(nthreads * sizeof(double));
-    ijk_part = new int[nthreads];
+    outfile->Printf("    Memory available in words        : %15ld\n", mem_avail);
+    outfile->Printf("    ~Words needed per explicit thread: %15ld\n", Fincore ? thread_mem_incore : thread_mem_slabs);
+    outfile->Printf("    F <ia|bc> integrals              : %15s\n", Fincore ? "in core" : "read per ij");
+    outfile->Printf("    Number of threads for explicit ijk threading: %4d\n\n", nthreads);
+
+// Don't parallelize mkl if explicit threads are used; should be added for acml too.
+#ifdef USING_LAPACK_MKL
+    int old_threads = mkl_get_max_threads();
+    mkl_set_num_threads(1);
+    outfile->Printf("    MKL num_threads set to 1 for explicit threading.\n\n");
+#endif
+
+    if (Fincore) {
+        for (h = 0; h < nirreps; h++) {
+            global_dpd_->buf4_mat_irrep_init(&Fints, h);
+            global_dpd_->buf4_mat_irrep_rd(&Fints, h);
+        }
+    }
+
+    ET_RHF_data data;
+    data.fIJ = &fIJ;
+    data.fAB = &fAB;
+    data.fIA = &fIA;
+    data.T1 = &T1;
+    data.T2 = &T2;
+    data.Eints = &Eints;
+    data.Dints = &Dints;
+    data.Fints = &Fints;
+    data.Fincore = Fincore;
+
+    size_t nab = 0;
+    int max_virtpi = 0;
+    for (h = 0; h < nirreps; h++) {
+        nab += Fints.params->coltot[h];
+        max_virtpi = std::max(max_virtpi, virtpi[h]);
+    }
 
+    std::vector<ET_RHF_workspace> work(nthreads);
     for (thread = 0; thread < nthreads; ++thread) {
-        thread_data_array[thread].fIJ = &fIJ;
-        thread_data_array[thread].fAB = &fAB;
-        thread_data_array[thread].fIA = &fIA;
-        thread_data_array[thread].T1 = &T1;
-        thread_data_array[thread].T2 = &T2;
-        thread_data_array[thread].Eints = &Eints;
-        thread_data_array[thread].Dints = &Dints;
-        thread_data_array[thread].Fints_local = &(Fints_array[thread]);
-        thread_data_array[thread].ET_local = &(ET_array[thread]);
+        ET_RHF_workspace &ws = work[thread];
+        for (int m = 0; m < 6; m++) {
+            ws.buf[m] = global_dpd_->dpd_block_matrix(1, Wsize);
+            ws.rows[m].resize(nab);
+            ws.blocks[m].resize(nirreps);
+        }
+        for (int n = 0; n < 3; n++) {
+            ws.slab[n] = Fincore ? nullptr : global_dpd_->dpd_block_matrix(1, slab_size);
+            ws.Fptr[n].resize(nirreps);
+        }
+        ws.slab_rows.resize(max_virtpi);
+        ws.Gijk = -1;
+        ws.size = 0;
     }
 
+    auto mode = std::ostream::trunc;
+    auto printer = std::make_shared<PsiOutStream>("ijk.dat", mode);
+
     /* Compute total number of IJK combinations */
     nijk = 0;
     for (Gi = 0; Gi < nirreps; Gi++)
@@ -192,62 +307,79 @@ double ET_RHF() {
                 }
     printer->Printf("Total number of IJK combinations =: %d\n", nijk);
 
-    ET = 0.0;
-    for (Gi = 0; Gi < nirreps; Gi++) {
-        for (Gj = 0; Gj < nirreps; Gj++) {
-            for (Gk = 0; Gk < nirreps; Gk++) {
-                nijk = 0;  // total number of ijk for these irreps
-                for (i = 0; i < occpi[Gi]; i++) {
-                    I = occ_off[Gi] + i;
-                    for (j = 0; j < occpi[Gj]; j++) {
-                        J = occ_off[Gj] + j;
-                        for (k = 0; k < occpi[Gk]; k++) {
-                            K = occ_off[Gk] + k;
-                            if (I >= J && J >= K) nijk++;
-                        }
-                    }
-                }
-                printer->Printf("Num. of IJK with (Gi,Gj,Gk)=(%d,%d,%d) =: %d\n", Gi, Gj, Gk, nijk);
-                if (nijk == 0) continue;
-
-                for (thread = 0; thread < nthreads; ++thread) {
-                    thread_data_array[thread].Gi = Gi;
-                    thread_data_array[thread].Gj = Gj;
-                    thread_data_array[thread].Gk = Gk;
-                    ET_array[thread] = 0.0;
-                    ijk_part[thread] = nijk / nthreads;  // number of ijk for each thread
-                    if (thread < (nijk % nthreads)) ++ijk_part[thread];
+    /* Build the (I,J) task list; each task loops over all K <= J.  The F
+       slabs of I and J are read once per task.  Tasks are handed out
+       dynamically, largest first, so that no thread idles behind a static
+       partition of the ijk space. */
+    std::vector<ET_RHF_task> tasks;
+    for (Gi = 0; Gi < nirreps; Gi++)
+        for (i = 0; i < occpi[Gi]; i++) {
+            I = occ_off[Gi] + i;
+            for (Gj = 0; Gj < nirreps; Gj++)
+                for (j = 0; j < occpi[Gj]; j++) {
+                    J = occ_off[Gj] + j;
+                    if (I < J) continue;
+                    ET_RHF_task task;
+                    task.Gi = Gi;
+                    task.i = i;
+                    task.Gj = Gj;
+                    task.j = j;
+                    task.nk = J + 1;
+                    tasks.push_back(task);
                 }
+        }
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [](const ET_RHF_task &a, const ET_RHF_task &b) { return a.nk > b.nk; });
+    printer->Printf("Number of IJ tasks =: %zu\n", tasks.size());
 
-                cnt = 0;
-                for (thread = 0; thread < nthreads; ++thread) {
-                    if (!ijk_part[thread]) continue;  // there are more threads than nijk
-                    thread_data_array[thread].first_ijk = cnt;
-                    cnt += ijk_part[thread];
-                    thread_data_array[thread].last_ijk = cnt - 1;
-                }
-
-                /* execute threads */
-                for (thread = 0; thread < nthreads; ++thread) {
-                    if (!ijk_part[thread]) continue;
-                    printer->Printf("    thread %d: first_ijk=%d,  last_ijk=%d\n", thread,
-                                    thread_data_array[thread].first_ijk, thread_data_array[thread].last_ijk);
-                }
+    std::vector<double> ET_task(tasks.size(), 0.0);
+    long int ntasks = tasks.size();
 
 #pragma omp parallel num_threads(nthreads)
-                {
-                    int ithread = 0;
+    {
+        int ithread = 0;
 #ifdef _OPENMP
-                    ithread = omp_get_thread_num();
+        ithread = omp_get_thread_num();
 #endif
-                    if (ijk_part[ithread]) ET_RHF_thread(&thread_data_array[ithread]);
+        ET_RHF_workspace &ws = work[ithread];
+
+#pragma omp for schedule(dynamic, 1)
+        for (long int t = 0; t < ntasks; t++) {
+            const ET_RHF_task &task = tasks[t];
+            int I = occ_off[task.Gi] + task.i;
+            int J = occ_off[task.Gj] + task.j;
+
+            ET_RHF_get_F(data, ws, 0, I, task.Gi);
+            ET_RHF_get_F(data, ws, 1, J, task.Gj);
+
+            double ET_ij = 0.0;
+            for (int Gk = 0; Gk < nirreps; Gk++) {
+                ET_RHF_set_blocks(ws, &Fints, task.Gi ^ task.Gj ^ Gk);
+                for (int k = 0; k < occpi[Gk]; k++) {
+                    int K = occ_off[Gk] + k;
+                    if (J < K) break;
+                    ET_RHF_get_F(data, ws, 2, K, Gk);
+                    ET_ij += ET_RHF_ijk(data, ws, task.Gi, task.i, task.Gj, task.j, Gk, k);
                 }
+            }
+            ET_task[t] = ET_ij;
+        }
+    }
 
-                for (thread = 0; thread < nthreads; ++thread) ET += ET_array[thread];
+    /* Sum in task order so the result does not depend on the schedule */
+    ET = 0.0;
+    for (long int t = 0; t < ntasks; t++) ET += ET_task[t];
 
-            } /* Gk */
-        }     /* Gj */
-    }         /* Gi */
+    for (thread = 0; thread < nthreads; ++thread) {
+        ET_RHF_workspace &ws = work[thread];
+        for (int m = 0; m < 6; m++) global_dpd_->free_dpd_block(ws.buf[m], 1, Wsize);
+        if (!Fincore)
+            for (int n = 0; n < 3; n++) global_dpd_->free_dpd_block(ws.slab[n], 1, slab_size);
+    }
+
+    if (Fincore)
+        for (h = 0; h < nirreps; h++) global_dpd_->buf4_mat_irrep_close(&Fints, h);
+    global_dpd_->buf4_close(&Fints);
 
     for (h = 0; h < nirreps; h++) {
         global_dpd_->buf4_mat_irrep_close(&T2, h);
@@ -268,12 +400,6 @@ double ET_RHF() {
     global_dpd_->file2_close(&fAB);
     global_dpd_->file2_close(&fIA);
 
-    for (thread = 0; thread < nthreads; ++thread) global_dpd_->buf4_close(&(Fints_array[thread]));
-
-    free(Fints_array);
-    free(ET_array);
-    delete[] ijk_part;
-
     timer_off("ET_RHF");
 
 #ifdef USING_LAPACK_MKL
@@ -283,28 +409,30 @@ double ET_RHF() {
     return ET;
 }
 
-void ET_RHF_thread(ET_RHF_thread_data *data) {
-    int h, nirreps, cnt_ijk;
-    int Gp, p, nump;
+/* Contribution of a single ijk to the (T) energy.  The F slabs of I, J and
+   K must already be set up in ws.Fptr[0..2] and the blocks of ws for
+   Gi^Gj^Gk. */
+double ET_RHF_ijk(ET_RHF_data &data, ET_RHF_workspace &ws, int Gi, int i, int Gj, int j, int Gk, int k) {
+    int h, nirreps;
     int nrows, ncols, nlinks;
     int Gijk, Gid, Gkd, Gjd, Gil, Gkl, Gjl;
     int Gab, Gba, Gbc, Gcb, Gac, Gca;
     int ab, ba, bc, cb, ac, ca;
     int cd, bd, ad, lc, lb, la;
     int il, jl, kl;
-    int Gi, Gj, Gk, Ga, Gb, Gc, Gd, Gl;
+    int Ga, Gb, Gc, Gd, Gl;
     int Gij, Gji, Gjk, Gkj, Gik, Gki;
     int I, J, K, A, B, C, D, L;
-    int i, j, k, a, b, c, d, l;
+    int a, b, c, d, l;
     int ij, ji, ik, ki, jk, kj;
     int *occpi, *virtpi, *occ_off, *vir_off;
     double t_ia, t_jb, t_kc, D_jkbc, D_ikac, D_ijab;
     double f_ia, f_jb, f_kc, t_jkbc, t_ikac, t_ijab;
-    double dijk, value1, value2, value3, value4, value5, value6, denom, *ET_local;
+    double dijk, value1, value2, value3, value4, value5, value6, denom, ET;
     double ***W0, ***W1, ***V, ***X, ***Y, ***Z;
+    double **Fi, **Fj, **Fk;
     dpdbuf4 *T2, *Eints, *Dints, *Fints;
     dpdfile2 *fIJ, *fAB, *fIA, *T1;
-    int nijk, nthreads, first_ijk, last_ijk, thr_id;
 
     nirreps = moinfo.nirreps;
     occpi = moinfo.occpi;
@@ -312,572 +440,491 @@ void ET_RHF_thread(ET_RHF_thread_data *data) {
     occ_off = moinfo.occ_off;
     vir_off = moinfo.vir_off;
 
-    fIJ = data->fIJ;
-    fAB = data->fAB;
-    fIA = data->fIA;
-    T1 = data->T1;
-    T2 = data->T2;
-    Eints = data->Eints;
-    Dints = data->Dints;
-    Fints = data->Fints_local;
-    ET_local = data->ET_local;  // pointer to where thread E goes
-    Gi = data->Gi;
-    Gj = data->Gj;
-    Gk = data->Gk;
-    first_ijk = data->first_ijk;
-    last_ijk = data->last_ijk;
-
-    W0 = (double ***)malloc(nirreps * sizeof(double **));
-    W1 = (double ***)malloc(nirreps * sizeof(double **));
-    V = (double ***)malloc(nirreps * sizeof(double **));
-    X = (double ***)malloc(nirreps * sizeof(double **));
-    Y = (double ***)malloc(nirreps * sizeof(double **));
-    Z = (double ***)malloc(nirreps * sizeof(double **));
+    fIJ = data.fIJ;
+    fAB = data.fAB;
+    fIA = data.fIA;
+    T1 = data.T1;
+    T2 = data.T2;
+    Eints = data.Eints;
+    Dints = data.Dints;
+    Fints = data.Fints;
+
+    W0 = ws.blocks[0].data();
+    W1 = ws.blocks[1].data();
+    V = ws.blocks[2].data();
+    X = ws.blocks[3].data();
+    Y = ws.blocks[4].data();
+    Z = ws.blocks[5].data();
+    Fi = ws.Fptr[0].data();
+    Fj = ws.Fptr[1].data();
+    Fk = ws.Fptr[2].data();
 
     Gkj = Gjk = Gk ^ Gj;
     Gji = Gij = Gi ^ Gj;
     Gik = Gki = Gi ^ Gk;
     Gijk = Gi ^ Gj ^ Gk;
 
-    cnt_ijk = -1;
-    for (i = 0; i < occpi[Gi]; i++) {
-        I = occ_off[Gi] + i;
-        for (j = 0; j < occpi[Gj]; j++) {
-            J = occ_off[Gj] + j;
-            for (k = 0; k < occpi[Gk]; k++) {
-                K = occ_off[Gk] + k;
-                if (I >= J && J >= K) {
-                    ++cnt_ijk;
-                    /* check to see if this ijk is for this thread */
-                    if ((cnt_ijk < first_ijk) || (cnt_ijk > last_ijk)) continue;
-
-                    ij = T2->params->rowidx[I][J];
-                    ji = T2->params->rowidx[J][I];
-                    ik = T2->params->rowidx[I][K];
-                    ki = T2->params->rowidx[K][I];
-                    jk = T2->params->rowidx[J][K];
-                    kj = T2->params->rowidx[K][J];
-
-                    dijk = 0.0;
-                    if (fIJ->params->rowtot[Gi]) dijk += fIJ->matrix[Gi][i][i];
-                    if (fIJ->params->rowtot[Gj]) dijk += fIJ->matrix[Gj][j][j];
-                    if (fIJ->params->rowtot[Gk]) dijk += fIJ->matrix[Gk][k][k];
-
-                    /* Malloc space for the W intermediate */
-
-                    // timer_on("malloc");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
-
-                        W0[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
-                        W1[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
-                    }
-                    // timer_off("malloc");
+    I = occ_off[Gi] + i;
+    J = occ_off[Gj] + j;
+    K = occ_off[Gk] + k;
 
-                    // timer_on("N7 Terms");
-
-                    /* +F_idab * t_kjcd */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gab = Gid = Gi ^ Gd;
-                        Gc = Gkj ^ Gd;
-
-                        /* Set up F integrals */
-                        Fints->matrix[Gid] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gid]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gid, Fints->row_offset[Gid][I], virtpi[Gd]);
-
-                        /* Set up T2 amplitudes */
-                        cd = T2->col_offset[Gkj][Gc];
+    ET = 0.0;
 
-                        /* Set up multiplication parameters */
-                        nrows = Fints->params->coltot[Gid];
-                        ncols = virtpi[Gc];
-                        nlinks = virtpi[Gd];
+    ij = T2->params->rowidx[I][J];
+    ji = T2->params->rowidx[J][I];
+    ik = T2->params->rowidx[I][K];
+    ki = T2->params->rowidx[K][I];
+    jk = T2->params->rowidx[J][K];
+    kj = T2->params->rowidx[K][J];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gid][0][0]), nrows,
-                                    &(T2->matrix[Gkj][kj][cd]), nlinks, 0.0, &(W0[Gab][0][0]), ncols);
+    dijk = 0.0;
+    if (fIJ->params->rowtot[Gi]) dijk += fIJ->matrix[Gi][i][i];
+    if (fIJ->params->rowtot[Gj]) dijk += fIJ->matrix[Gj][j][j];
+    if (fIJ->params->rowtot[Gk]) dijk += fIJ->matrix[Gk][k][k];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gid], virtpi[Gd], Fints->params->coltot[Gid]);
-                    }
+    /* Clear the W intermediate; the workspace is reused from the previous ijk */
+    ::memset(ws.buf[0][0], 0, ws.size * sizeof(double));
 
-                    /* -E_jklc * t_ilab */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gab = Gil = Gi ^ Gl;
-                        Gc = Gjk ^ Gl;
+    // timer_on("N7 Terms");
 
-                        /* Set up E integrals */
-                        lc = Eints->col_offset[Gjk][Gl];
+    /* +F_idab * t_kjcd */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gab = Gid = Gi ^ Gd;
+        Gc = Gkj ^ Gd;
 
-                        /* Set up T2 amplitudes */
-                        il = T2->row_offset[Gil][I];
+        /* Set up F integrals */
 
-                        /* Set up multiplication parameters */
-                        nrows = T2->params->coltot[Gil];
-                        ncols = virtpi[Gc];
-                        nlinks = occpi[Gl];
+        /* Set up T2 amplitudes */
+        cd = T2->col_offset[Gkj][Gc];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gil][il][0]), nrows,
-                                    &(Eints->matrix[Gjk][jk][lc]), ncols, 1.0, &(W0[Gab][0][0]), ncols);
-                    }
+        /* Set up multiplication parameters */
+        nrows = Fints->params->coltot[Gid];
+        ncols = virtpi[Gc];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[ab][c] --> W[ac][b] */
-                    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fi[Gd], nrows,
+                    &(T2->matrix[Gkj][kj][cd]), nlinks, 0.0, &(W0[Gab][0][0]), ncols);
 
-                    /* +F_idac * t_jkbd */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gac = Gid = Gi ^ Gd;
-                        Gb = Gjk ^ Gd;
+    }
 
-                        Fints->matrix[Gid] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gid]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gid, Fints->row_offset[Gid][I], virtpi[Gd]);
+    /* -E_jklc * t_ilab */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gab = Gil = Gi ^ Gl;
+        Gc = Gjk ^ Gl;
 
-                        bd = T2->col_offset[Gjk][Gb];
+        /* Set up E integrals */
+        lc = Eints->col_offset[Gjk][Gl];
 
-                        nrows = Fints->params->coltot[Gid];
-                        ncols = virtpi[Gb];
-                        nlinks = virtpi[Gd];
+        /* Set up T2 amplitudes */
+        il = T2->row_offset[Gil][I];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gid][0][0]), nrows,
-                                    &(T2->matrix[Gjk][jk][bd]), nlinks, 1.0, &(W1[Gac][0][0]), ncols);
+        /* Set up multiplication parameters */
+        nrows = T2->params->coltot[Gil];
+        ncols = virtpi[Gc];
+        nlinks = occpi[Gl];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gid], virtpi[Gd], Fints->params->coltot[Gid]);
-                    }
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gil][il][0]), nrows,
+                    &(Eints->matrix[Gjk][jk][lc]), ncols, 1.0, &(W0[Gab][0][0]), ncols);
+    }
 
-                    /* -E_kjlb * t_ilac */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gac = Gil = Gi ^ Gl;
-                        Gb = Gkj ^ Gl;
+    /* Sort W[ab][c] --> W[ac][b] */
+    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
 
-                        lb = Eints->col_offset[Gkj][Gl];
+    /* +F_idac * t_jkbd */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gac = Gid = Gi ^ Gd;
+        Gb = Gjk ^ Gd;
 
-                        il = T2->row_offset[Gil][I];
 
-                        nrows = T2->params->coltot[Gil];
-                        ncols = virtpi[Gb];
-                        nlinks = occpi[Gl];
+        bd = T2->col_offset[Gjk][Gb];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gil][il][0]), nrows,
-                                    &(Eints->matrix[Gkj][kj][lb]), ncols, 1.0, &(W1[Gac][0][0]), ncols);
-                    }
+        nrows = Fints->params->coltot[Gid];
+        ncols = virtpi[Gb];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[ac][b] --> W[ca][b] */
-                    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fi[Gd], nrows,
+                    &(T2->matrix[Gjk][jk][bd]), nlinks, 1.0, &(W1[Gac][0][0]), ncols);
 
-                    /* +F_kdca * t_jibd */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gca = Gkd = Gk ^ Gd;
-                        Gb = Gji ^ Gd;
+    }
 
-                        Fints->matrix[Gkd] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gkd]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gkd, Fints->row_offset[Gkd][K], virtpi[Gd]);
+    /* -E_kjlb * t_ilac */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gac = Gil = Gi ^ Gl;
+        Gb = Gkj ^ Gl;
 
-                        bd = T2->col_offset[Gji][Gb];
+        lb = Eints->col_offset[Gkj][Gl];
 
-                        nrows = Fints->params->coltot[Gkd];
-                        ncols = virtpi[Gb];
-                        nlinks = virtpi[Gd];
+        il = T2->row_offset[Gil][I];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gkd][0][0]), nrows,
-                                    &(T2->matrix[Gji][ji][bd]), nlinks, 1.0, &(W0[Gca][0][0]), ncols);
+        nrows = T2->params->coltot[Gil];
+        ncols = virtpi[Gb];
+        nlinks = occpi[Gl];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gkd], virtpi[Gd], Fints->params->coltot[Gkd]);
-                    }
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gil][il][0]), nrows,
+                    &(Eints->matrix[Gkj][kj][lb]), ncols, 1.0, &(W1[Gac][0][0]), ncols);
+    }
 
-                    /* -E_ijlb * t_klca */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gca = Gkl = Gk ^ Gl;
-                        Gb = Gij ^ Gl;
+    /* Sort W[ac][b] --> W[ca][b] */
+    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
 
-                        lb = Eints->col_offset[Gij][Gl];
+    /* +F_kdca * t_jibd */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gca = Gkd = Gk ^ Gd;
+        Gb = Gji ^ Gd;
 
-                        kl = T2->row_offset[Gkl][K];
 
-                        nrows = T2->params->coltot[Gkl];
-                        ncols = virtpi[Gb];
-                        nlinks = occpi[Gl];
+        bd = T2->col_offset[Gji][Gb];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gkl][kl][0]), nrows,
-                                    &(Eints->matrix[Gij][ij][lb]), ncols, 1.0, &(W0[Gca][0][0]), ncols);
-                    }
+        nrows = Fints->params->coltot[Gkd];
+        ncols = virtpi[Gb];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[ca][b] --> W[cb][a] */
-                    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fk[Gd], nrows,
+                    &(T2->matrix[Gji][ji][bd]), nlinks, 1.0, &(W0[Gca][0][0]), ncols);
 
-                    /* +F_kdcb * t_ijad */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gcb = Gkd = Gk ^ Gd;
-                        Ga = Gij ^ Gd;
+    }
 
-                        Fints->matrix[Gkd] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gkd]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gkd, Fints->row_offset[Gkd][K], virtpi[Gd]);
+    /* -E_ijlb * t_klca */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gca = Gkl = Gk ^ Gl;
+        Gb = Gij ^ Gl;
 
-                        ad = T2->col_offset[Gij][Ga];
+        lb = Eints->col_offset[Gij][Gl];
 
-                        nrows = Fints->params->coltot[Gkd];
-                        ncols = virtpi[Ga];
-                        nlinks = virtpi[Gd];
+        kl = T2->row_offset[Gkl][K];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gkd][0][0]), nrows,
-                                    &(T2->matrix[Gij][ij][ad]), nlinks, 1.0, &(W1[Gcb][0][0]), ncols);
+        nrows = T2->params->coltot[Gkl];
+        ncols = virtpi[Gb];
+        nlinks = occpi[Gl];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gkd], virtpi[Gd], Fints->params->coltot[Gkd]);
-                    }
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gkl][kl][0]), nrows,
+                    &(Eints->matrix[Gij][ij][lb]), ncols, 1.0, &(W0[Gca][0][0]), ncols);
+    }
 
-                    /* -E_jila * t_klcb */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gcb = Gkl = Gk ^ Gl;
-                        Ga = Gji ^ Gl;
+    /* Sort W[ca][b] --> W[cb][a] */
+    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
 
-                        la = Eints->col_offset[Gji][Gl];
+    /* +F_kdcb * t_ijad */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gcb = Gkd = Gk ^ Gd;
+        Ga = Gij ^ Gd;
 
-                        kl = T2->row_offset[Gkl][K];
 
-                        nrows = T2->params->coltot[Gkl];
-                        ncols = virtpi[Ga];
-                        nlinks = occpi[Gl];
+        ad = T2->col_offset[Gij][Ga];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gkl][kl][0]), nrows,
-                                    &(Eints->matrix[Gji][ji][la]), ncols, 1.0, &(W1[Gcb][0][0]), ncols);
-                    }
+        nrows = Fints->params->coltot[Gkd];
+        ncols = virtpi[Ga];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[cb][a] --> W[bc][a] */
-                    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fk[Gd], nrows,
+                    &(T2->matrix[Gij][ij][ad]), nlinks, 1.0, &(W1[Gcb][0][0]), ncols);
 
-                    /* +F_jdbc * t_ikad */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gbc = Gjd = Gj ^ Gd;
-                        Ga = Gik ^ Gd;
+    }
 
-                        Fints->matrix[Gjd] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gjd]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gjd, Fints->row_offset[Gjd][J], virtpi[Gd]);
+    /* -E_jila * t_klcb */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gcb = Gkl = Gk ^ Gl;
+        Ga = Gji ^ Gl;
 
-                        ad = T2->col_offset[Gik][Ga];
+        la = Eints->col_offset[Gji][Gl];
 
-                        nrows = Fints->params->coltot[Gjd];
-                        ncols = virtpi[Ga];
-                        nlinks = virtpi[Gd];
+        kl = T2->row_offset[Gkl][K];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gjd][0][0]), nrows,
-                                    &(T2->matrix[Gik][ik][ad]), nlinks, 1.0, &(W0[Gbc][0][0]), ncols);
+        nrows = T2->params->coltot[Gkl];
+        ncols = virtpi[Ga];
+        nlinks = occpi[Gl];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gjd], virtpi[Gd], Fints->params->coltot[Gjd]);
-                    }
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gkl][kl][0]), nrows,
+                    &(Eints->matrix[Gji][ji][la]), ncols, 1.0, &(W1[Gcb][0][0]), ncols);
+    }
 
-                    /* -E_kila * t_jlbc */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gbc = Gjl = Gj ^ Gl;
-                        Ga = Gki ^ Gl;
+    /* Sort W[cb][a] --> W[bc][a] */
+    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
 
-                        la = Eints->col_offset[Gki][Gl];
+    /* +F_jdbc * t_ikad */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gbc = Gjd = Gj ^ Gd;
+        Ga = Gik ^ Gd;
 
-                        jl = T2->row_offset[Gjl][J];
 
-                        nrows = T2->params->coltot[Gjl];
-                        ncols = virtpi[Ga];
-                        nlinks = occpi[Gl];
+        ad = T2->col_offset[Gik][Ga];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gjl][jl][0]), nrows,
-                                    &(Eints->matrix[Gki][ki][la]), ncols, 1.0, &(W0[Gbc][0][0]), ncols);
-                    }
+        nrows = Fints->params->coltot[Gjd];
+        ncols = virtpi[Ga];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[bc][a] --> W[ba][c] */
-                    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fj[Gd], nrows,
+                    &(T2->matrix[Gik][ik][ad]), nlinks, 1.0, &(W0[Gbc][0][0]), ncols);
 
-                    /* +F_jdba * t_kicd */
-                    for (Gd = 0; Gd < nirreps; Gd++) {
-                        Gba = Gjd = Gj ^ Gd;
-                        Gc = Gki ^ Gd;
+    }
 
-                        Fints->matrix[Gjd] = global_dpd_->dpd_block_matrix(virtpi[Gd], Fints->params->coltot[Gjd]);
-#pragma omp critical
-                        global_dpd_->buf4_mat_irrep_rd_block(Fints, Gjd, Fints->row_offset[Gjd][J], virtpi[Gd]);
+    /* -E_kila * t_jlbc */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gbc = Gjl = Gj ^ Gl;
+        Ga = Gki ^ Gl;
 
-                        cd = T2->col_offset[Gki][Gc];
+        la = Eints->col_offset[Gki][Gl];
 
-                        nrows = Fints->params->coltot[Gjd];
-                        ncols = virtpi[Gc];
-                        nlinks = virtpi[Gd];
+        jl = T2->row_offset[Gjl][J];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, &(Fints->matrix[Gjd][0][0]), nrows,
-                                    &(T2->matrix[Gki][ki][cd]), nlinks, 1.0, &(W1[Gba][0][0]), ncols);
+        nrows = T2->params->coltot[Gjl];
+        ncols = virtpi[Ga];
+        nlinks = occpi[Gl];
 
-                        global_dpd_->free_dpd_block(Fints->matrix[Gjd], virtpi[Gd], Fints->params->coltot[Gjd]);
-                    }
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gjl][jl][0]), nrows,
+                    &(Eints->matrix[Gki][ki][la]), ncols, 1.0, &(W0[Gbc][0][0]), ncols);
+    }
 
-                    /* -E_iklc * t_jlba */
-                    for (Gl = 0; Gl < nirreps; Gl++) {
-                        Gba = Gjl = Gj ^ Gl;
-                        Gc = Gik ^ Gl;
+    /* Sort W[bc][a] --> W[ba][c] */
+    global_dpd_->sort_3d(W0, W1, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, acb, 0);
 
-                        lc = Eints->col_offset[Gik][Gl];
+    /* +F_jdba * t_kicd */
+    for (Gd = 0; Gd < nirreps; Gd++) {
+        Gba = Gjd = Gj ^ Gd;
+        Gc = Gki ^ Gd;
 
-                        jl = T2->row_offset[Gjl][J];
 
-                        nrows = T2->params->coltot[Gjl];
-                        ncols = virtpi[Gc];
-                        nlinks = occpi[Gl];
+        cd = T2->col_offset[Gki][Gc];
 
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gjl][jl][0]), nrows,
-                                    &(Eints->matrix[Gik][ik][lc]), ncols, 1.0, &(W1[Gba][0][0]), ncols);
-                    }
+        nrows = Fints->params->coltot[Gjd];
+        ncols = virtpi[Gc];
+        nlinks = virtpi[Gd];
 
-                    /* Sort W[ba][c] --> W[ab][c] */
-                    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
-                                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
-                                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 't', nrows, ncols, nlinks, 1.0, Fj[Gd], nrows,
+                    &(T2->matrix[Gki][ki][cd]), nlinks, 1.0, &(W1[Gba][0][0]), ncols);
 
-                    // timer_off("N7 Terms");
+    }
 
-                    // timer_on("malloc");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
-                        global_dpd_->free_dpd_block(W1[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
+    /* -E_iklc * t_jlba */
+    for (Gl = 0; Gl < nirreps; Gl++) {
+        Gba = Gjl = Gj ^ Gl;
+        Gc = Gik ^ Gl;
 
-                        V[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
-                    }
-                    // timer_off("malloc");
+        lc = Eints->col_offset[Gik][Gl];
 
-                    /* Copy W intermediate into V */
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+        jl = T2->row_offset[Gjl][J];
 
-                        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
-                            for (c = 0; c < virtpi[Gc]; c++) {
-                                V[Gab][ab][c] = W0[Gab][ab][c];
-                            }
-                        }
-                    }
+        nrows = T2->params->coltot[Gjl];
+        ncols = virtpi[Gc];
+        nlinks = occpi[Gl];
 
-                    // timer_on("EST Terms");
-
-                    /* Add EST terms to V */
+        if (nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, -1.0, &(T2->matrix[Gjl][jl][0]), nrows,
+                    &(Eints->matrix[Gik][ik][lc]), ncols, 1.0, &(W1[Gba][0][0]), ncols);
+    }
 
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+    /* Sort W[ba][c] --> W[ab][c] */
+    global_dpd_->sort_3d(W1, W0, nirreps, Gijk, Fints->params->coltot, Fints->params->colidx,
+                         Fints->params->colorb, Fints->params->rsym, Fints->params->ssym, vir_off,
+                         vir_off, virtpi, vir_off, Fints->params->colidx, bac, 0);
 
-                        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
-                            A = Fints->params->colorb[Gab][ab][0];
-                            Ga = Fints->params->rsym[A];
-                            a = A - vir_off[Ga];
-                            B = Fints->params->colorb[Gab][ab][1];
-                            Gb = Fints->params->ssym[B];
-                            b = B - vir_off[Gb];
+    // timer_off("N7 Terms");
 
-                            Gbc = Gb ^ Gc;
-                            Gac = Ga ^ Gc;
+    /* Copy W intermediate into V */
+    for (Gab = 0; Gab < nirreps; Gab++) {
+        Gc = Gab ^ Gijk;
 
-                            for (c = 0; c < virtpi[Gc]; c++) {
-                                C = vir_off[Gc] + c;
+        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
+            for (c = 0; c < virtpi[Gc]; c++) {
+                V[Gab][ab][c] = W0[Gab][ab][c];
+            }
+        }
+    }
 
-                                bc = Dints->params->colidx[B][C];
-                                ac = Dints->params->colidx[A][C];
+    // timer_on("EST Terms");
 
-                                /* +t_ia * D_jkbc + f_ia * t_jkbc */
-                                if (Gi == Ga && Gjk == Gbc) {
-                                    t_ia = D_jkbc = 0.0;
+    /* Add EST terms to V */
 
-                                    if (T1->params->rowtot[Gi] && T1->params->coltot[Gi]) {
-                                        t_ia = T1->matrix[Gi][i][a];
-                                        f_ia = fIA->matrix[Gi][i][a];
-                                    }
+    for (Gab = 0; Gab < nirreps; Gab++) {
+        Gc = Gab ^ Gijk;
 
-                                    if (Dints->params->rowtot[Gjk] && Dints->params->coltot[Gjk]) {
-                                        D_jkbc = Dints->matrix[Gjk][jk][bc];
-                                        t_jkbc = T2->matrix[Gjk][jk][bc];
-                                    }
+        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
+            A = Fints->params->colorb[Gab][ab][0];
+            Ga = Fints->params->rsym[A];
+            a = A - vir_off[Ga];
+            B = Fints->params->colorb[Gab][ab][1];
+            Gb = Fints->params->ssym[B];
+            b = B - vir_off[Gb];
 
-                                    V[Gab][ab][c] += t_ia * D_jkbc + f_ia * t_jkbc;
-                                }
+            Gbc = Gb ^ Gc;
+            Gac = Ga ^ Gc;
 
-                                /* +t_jb * D_ikac */
-                                if (Gj == Gb && Gik == Gac) {
-                                    t_jb = D_ikac = 0.0;
+            for (c = 0; c < virtpi[Gc]; c++) {
+                C = vir_off[Gc] + c;
 
-                                    if (T1->params->rowtot[Gj] && T1->params->coltot[Gj]) {
-                                        t_jb = T1->matrix[Gj][j][b];
-                                        f_jb = fIA->matrix[Gj][j][b];
-                                    }
+                bc = Dints->params->colidx[B][C];
+                ac = Dints->params->colidx[A][C];
 
-                                    if (Dints->params->rowtot[Gik] && Dints->params->coltot[Gik]) {
-                                        D_ikac = Dints->matrix[Gik][ik][ac];
-                                        t_ikac = T2->matrix[Gik][ik][ac];
-                                    }
+                /* +t_ia * D_jkbc + f_ia * t_jkbc */
+                if (Gi == Ga && Gjk == Gbc) {
+                    t_ia = D_jkbc = 0.0;
 
-                                    V[Gab][ab][c] += t_jb * D_ikac + f_jb * t_ikac;
-                                }
+                    if (T1->params->rowtot[Gi] && T1->params->coltot[Gi]) {
+                        t_ia = T1->matrix[Gi][i][a];
+                        f_ia = fIA->matrix[Gi][i][a];
+                    }
 
-                                /* +t_kc * D_ijab */
-                                if (Gk == Gc && Gij == Gab) {
-                                    t_kc = D_ijab = 0.0;
+                    if (Dints->params->rowtot[Gjk] && Dints->params->coltot[Gjk]) {
+                        D_jkbc = Dints->matrix[Gjk][jk][bc];
+                        t_jkbc = T2->matrix[Gjk][jk][bc];
+                    }
 
-                                    if (T1->params->rowtot[Gk] && T1->params->coltot[Gk]) {
-                                        t_kc = T1->matrix[Gk][k][c];
-                                        f_kc = fIA->matrix[Gk][k][c];
-                                    }
+                    V[Gab][ab][c] += t_ia * D_jkbc + f_ia * t_jkbc;
+                }
 
-                                    if (Dints->params->rowtot[Gij] && Dints->params->coltot[Gij]) {
-                                        D_ijab = Dints->matrix[Gij][ij][ab];
-                                        t_ijab = T2->matrix[Gij][ij][ab];
-                                    }
+                /* +t_jb * D_ikac */
+                if (Gj == Gb && Gik == Gac) {
+                    t_jb = D_ikac = 0.0;
 
-                                    V[Gab][ab][c] += t_kc * D_ijab + f_kc * t_ijab;
-                                }
+                    if (T1->params->rowtot[Gj] && T1->params->coltot[Gj]) {
+                        t_jb = T1->matrix[Gj][j][b];
+                        f_jb = fIA->matrix[Gj][j][b];
+                    }
 
-                                V[Gab][ab][c] /= (1 + (A == B) + (B == C) + (A == C));
-                            }
-                        }
+                    if (Dints->params->rowtot[Gik] && Dints->params->coltot[Gik]) {
+                        D_ikac = Dints->matrix[Gik][ik][ac];
+                        t_ikac = T2->matrix[Gik][ik][ac];
                     }
 
-                    // timer_off("EST Terms");
+                    V[Gab][ab][c] += t_jb * D_ikac + f_jb * t_ikac;
+                }
 
-                    // timer_on("malloc");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+                /* +t_kc * D_ijab */
+                if (Gk == Gc && Gij == Gab) {
+                    t_kc = D_ijab = 0.0;
 
-                        X[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
-                        Y[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
-                        Z[Gab] = global_dpd_->dpd_block_matrix(Fints->params->coltot[Gab], virtpi[Gc]);
+                    if (T1->params->rowtot[Gk] && T1->params->coltot[Gk]) {
+                        t_kc = T1->matrix[Gk][k][c];
+                        f_kc = fIA->matrix[Gk][k][c];
                     }
-                    // timer_off("malloc");
 
-                    // timer_on("XYZ");
-                    /* Build X, Y, and Z intermediates */
+                    if (Dints->params->rowtot[Gij] && Dints->params->coltot[Gij]) {
+                        D_ijab = Dints->matrix[Gij][ij][ab];
+                        t_ijab = T2->matrix[Gij][ij][ab];
+                    }
 
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+                    V[Gab][ab][c] += t_kc * D_ijab + f_kc * t_ijab;
+                }
 
-                        Gba = Gab;
+                V[Gab][ab][c] /= (1 + (A == B) + (B == C) + (A == C));
+            }
+        }
+    }
 
-                        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
-                            A = Fints->params->colorb[Gab][ab][0];
-                            Ga = Fints->params->rsym[A];
-                            a = A - vir_off[Ga];
-                            B = Fints->params->colorb[Gab][ab][1];
-                            Gb = Fints->params->ssym[B];
-                            b = B - vir_off[Gb];
+    // timer_off("EST Terms");
 
-                            Gac = Gca = Ga ^ Gc;
-                            Gbc = Gcb = Gb ^ Gc;
+    // timer_on("XYZ");
+    /* Build X, Y, and Z intermediates */
 
-                            ba = Dints->params->colidx[B][A];
+    for (Gab = 0; Gab < nirreps; Gab++) {
+        Gc = Gab ^ Gijk;
 
-                            for (c = 0; c < virtpi[Gc]; c++) {
-                                C = vir_off[Gc] + c;
+        Gba = Gab;
 
-                                ac = Dints->params->colidx[A][C];
-                                ca = Dints->params->colidx[C][A];
-                                bc = Dints->params->colidx[B][C];
-                                cb = Dints->params->colidx[C][B];
+        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
+            A = Fints->params->colorb[Gab][ab][0];
+            Ga = Fints->params->rsym[A];
+            a = A - vir_off[Ga];
+            B = Fints->params->colorb[Gab][ab][1];
+            Gb = Fints->params->ssym[B];
+            b = B - vir_off[Gb];
 
-                                X[Gab][ab][c] = W0[Gab][ab][c] * V[Gab][ab][c] + W0[Gac][ac][b] * V[Gac][ac][b] +
-                                                W0[Gba][ba][c] * V[Gba][ba][c] + W0[Gbc][bc][a] * V[Gbc][bc][a] +
-                                                W0[Gca][ca][b] * V[Gca][ca][b] + W0[Gcb][cb][a] * V[Gcb][cb][a];
+            Gac = Gca = Ga ^ Gc;
+            Gbc = Gcb = Gb ^ Gc;
 
-                                Y[Gab][ab][c] = V[Gab][ab][c] + V[Gbc][bc][a] + V[Gca][ca][b];
+            ba = Dints->params->colidx[B][A];
 
-                                Z[Gab][ab][c] = V[Gac][ac][b] + V[Gba][ba][c] + V[Gcb][cb][a];
-                            }
-                        }
-                    }
-                    // timer_off("XYZ");
+            for (c = 0; c < virtpi[Gc]; c++) {
+                C = vir_off[Gc] + c;
 
-                    // timer_on("malloc");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+                ac = Dints->params->colidx[A][C];
+                ca = Dints->params->colidx[C][A];
+                bc = Dints->params->colidx[B][C];
+                cb = Dints->params->colidx[C][B];
 
-                        global_dpd_->free_dpd_block(V[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
-                    }
-                    // timer_off("malloc");
-
-                    // timer_on("Energy");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
-                        Gba = Gab;
-
-                        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
-                            A = Fints->params->colorb[Gab][ab][0];
-                            Ga = Fints->params->rsym[A];
-                            a = A - vir_off[Ga];
-                            B = Fints->params->colorb[Gab][ab][1];
-                            Gb = Fints->params->ssym[B];
-                            b = B - vir_off[Gb];
-
-                            if (A >= B) {
-                                Gac = Gca = Ga ^ Gc;
-                                Gbc = Gcb = Gb ^ Gc;
-
-                                ba = Dints->params->colidx[B][A];
-
-                                for (c = 0; c < virtpi[Gc]; c++) {
-                                    C = vir_off[Gc] + c;
-
-                                    if (B >= C) {
-                                        ac = Dints->params->colidx[A][C];
-                                        ca = Dints->params->colidx[C][A];
-                                        bc = Dints->params->colidx[B][C];
-                                        cb = Dints->params->colidx[C][B];
-
-                                        value1 = Y[Gab][ab][c] - 2.0 * Z[Gab][ab][c];
-                                        value2 = Z[Gab][ab][c] - 2.0 * Y[Gab][ab][c];
-                                        value3 = W0[Gab][ab][c] + W0[Gbc][bc][a] + W0[Gca][ca][b];
-                                        value4 = W0[Gac][ac][b] + W0[Gba][ba][c] + W0[Gcb][cb][a];
-                                        value5 = 3.0 * X[Gab][ab][c];
-                                        value6 = 2 - ((I == J) + (J == K) + (I == K));
-
-                                        denom = dijk;
-                                        if (fAB->params->rowtot[Ga]) denom -= fAB->matrix[Ga][a][a];
-                                        if (fAB->params->rowtot[Gb]) denom -= fAB->matrix[Gb][b][b];
-                                        if (fAB->params->rowtot[Gc]) denom -= fAB->matrix[Gc][c][c];
-
-                                        *ET_local += (value1 * value3 + value2 * value4 + value5) * value6 / denom;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    // timer_off("Energy");
+                X[Gab][ab][c] = W0[Gab][ab][c] * V[Gab][ab][c] + W0[Gac][ac][b] * V[Gac][ac][b] +
+                                W0[Gba][ba][c] * V[Gba][ba][c] + W0[Gbc][bc][a] * V[Gbc][bc][a] +
+                                W0[Gca][ca][b] * V[Gca][ca][b] + W0[Gcb][cb][a] * V[Gcb][cb][a];
 
-                    /* Free the W and V intermediates */
-                    // timer_on("malloc");
-                    for (Gab = 0; Gab < nirreps; Gab++) {
-                        Gc = Gab ^ Gijk;
+                Y[Gab][ab][c] = V[Gab][ab][c] + V[Gbc][bc][a] + V[Gca][ca][b];
 
-                        global_dpd_->free_dpd_block(W0[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
-                        global_dpd_->free_dpd_block(X[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
-                        global_dpd_->free_dpd_block(Y[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
-                        global_dpd_->free_dpd_block(Z[Gab], Fints->params->coltot[Gab], virtpi[Gc]);
+                Z[Gab][ab][c] = V[Gac][ac][b] + V[Gba][ba][c] + V[Gcb][cb][a];
+            }
+        }
+    }
+    // timer_off("XYZ");
+
+    // timer_on("Energy");
+    for (Gab = 0; Gab < nirreps; Gab++) {
+        Gc = Gab ^ Gijk;
+        Gba = Gab;
+
+        for (ab = 0; ab < Fints->params->coltot[Gab]; ab++) {
+            A = Fints->params->colorb[Gab][ab][0];
+            Ga = Fints->params->rsym[A];
+            a = A - vir_off[Ga];
+            B = Fints->params->colorb[Gab][ab][1];
+            Gb = Fints->params->ssym[B];
+            b = B - vir_off[Gb];
+
+            if (A >= B) {
+                Gac = Gca = Ga ^ Gc;
+                Gbc = Gcb = Gb ^ Gc;
+
+                ba = Dints->params->colidx[B][A];
+
+                for (c = 0; c < virtpi[Gc]; c++) {
+                    C = vir_off[Gc] + c;
+
+                    if (B >= C) {
+                        ac = Dints->params->colidx[A][C];
+                        ca = Dints->params->colidx[C][A];
+                        bc = Dints->params->colidx[B][C];
+                        cb = Dints->params->colidx[C][B];
+
+                        value1 = Y[Gab][ab][c] - 2.0 * Z[Gab][ab][c];
+                        value2 = Z[Gab][ab][c] - 2.0 * Y[Gab][ab][c];
+                        value3 = W0[Gab][ab][c] + W0[Gbc][bc][a] + W0[Gca][ca][b];
+                        value4 = W0[Gac][ac][b] + W0[Gba][ba][c] + W0[Gcb][cb][a];
+                        value5 = 3.0 * X[Gab][ab][c];
+                        value6 = 2 - ((I == J) + (J == K) + (I == K));
+
+                        denom = dijk;
+                        if (fAB->params->rowtot[Ga]) denom -= fAB->matrix[Ga][a][a];
+                        if (fAB->params->rowtot[Gb]) denom -= fAB->matrix[Gb][b][b];
+                        if (fAB->params->rowtot[Gc]) denom -= fAB->matrix[Gc][c][c];
+
+                        ET += (value1 * value3 + value2 * value4 + value5) * value6 / denom;
                     }
-                    // timer_off("malloc");
                 }
-            } /* k */
-        }     /* j */
-    }         /* i */
+            }
+        }
+    }
+    // timer_off("Energy");
+
+
+    return ET;
 }
 
 }  // namespace cctriples
@@ -46,9 +46,15 @@
 **
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
 #include "psi4/pybind11.h"
 
 #include "psi4/libciomr/libciomr.h"
@@ -79,6 +85,49 @@ extern void xexy(double *x, double *y, int size);
 extern int calc_orb_diff(int cnt, unsigned char *I, unsigned char *J, int *I_alpha_diff, int *J_alpha_diff, int *sign,
                          int *same, int extended);
 
+namespace {
+/*
+** What is known about the CI vector buffers on disk.  Two CIvect objects can
+** point at the same files (nodfile), so this is kept per unit and buffer, not
+** per object.  It is only touched by the calling thread; io_lock is held
+** around every libpsio buffer call, including those on the helper threads.
+*/
+struct DiskBuffers {
+    std::mutex io_lock;
+    std::map<std::pair<int, int>, size_t> generation; /* times each buffer was written */
+    std::set<std::pair<int, int>> zero;               /* buffers holding only zeros */
+};
+
+DiskBuffers &disk_buffers() {
+    static DiskBuffers disk;
+    return disk;
+}
+
+/*
+** Record a write of n doubles to a disk buffer.  Returns false if the data
+** are all zero and so is the buffer already, so the write can be skipped.
+*/
+bool disk_write_needed(int unit, int buf, const double *data, size_t n) {
+    auto &disk = disk_buffers();
+    auto id = std::make_pair(unit, buf);
+    bool zero = std::all_of(data, data + n, [](double x) { return x == 0.0; });
+    if (zero && disk.zero.count(id)) return false;
+    if (zero)
+        disk.zero.insert(id);
+    else
+        disk.zero.erase(id);
+    disk.generation[id]++;
+    return true;
+}
+
+/* Forget what is known about the buffers of a unit, e.g. when it is closed */
+void disk_forget_unit(int unit) {
+    auto &disk = disk_buffers();
+    for (auto it = disk.zero.begin(); it != disk.zero.end();)
+        it = (it->first == unit) ? disk.zero.erase(it) : std::next(it);
+}
+}  // namespace
+
 #define MIN0(a, b) (((a) < (b)) ? (a) : (b))
 #define MAX0(a, b) (((a) > (b)) ? (a) : (b))
 
@@ -156,6 +205,9 @@ void CIvect::common_init() {
     first_unit_ = 0;
     print_lvl_ = 0;
     fopen_ = false;
+    io_unit_ = -1;
+    io_disk_buf_ = -1;
+    io_generation_ = 0;
 }
 
 void CIvect::set(int incor, int maxvect, int nunits, int funit, struct ci_blks *CIblks) {
@@ -418,6 +470,7 @@ void CIvect::set(size_t vl, int nb, int incor, int ms0, int *iac, int *ibc, int
 }
 
 CIvect::~CIvect() {
+    io_wait();
     if (num_blocks_) {
         if (buf_locked_) free(buffer_);
         for (int i = 0; i < num_blocks_; i++) {
@@ -1719,6 +1772,7 @@ void CIvect::init_io_files(bool open_old) {
 
     for (i = 0; i < nunits_; i++) {
         if (!psio_open_check((size_t)units_[i])) {
+            disk_forget_unit(units_[i]);
             if (open_old) {
                 psio_open((size_t)units_[i], PSIO_OPEN_OLD);
             } else {
@@ -1743,14 +1797,29 @@ void CIvect::close_io_files(int keep) {
         return;
     }
 
+    io_wait();
     for (size_t i = 0; i < nunits_; i++) {
         psio_close(units_[i], keep);
+        disk_forget_unit(units_[i]);
     }
     fopen_ = false;
 }
 
+/*
+** CIvect::disk_buf(): Disk buffer number of a section of a CI vector,
+** translated in case we renumbered after collapse.
+*/
+int CIvect::disk_buf(int ivect, int ibuf) {
+    int buf = ivect * buf_per_vect_ + ibuf;
+    buf += new_first_buf_;
+    if (buf >= buf_total_) buf -= buf_total_;
+    return buf;
+}
+
 /*
 ** CIvect::read(): Read in a section of a CI vector from external storage.
+** A buffer known to be all zeros is not read, and one already fetched by
+** prefetch() is taken from memory.
 **
 ** Parameters:
 **    ivect  = vector number
@@ -1761,9 +1830,8 @@ void CIvect::close_io_files(int keep) {
 ** Returns: 1 for success, 0 for failure
 */
 int CIvect::read(int ivect, int ibuf) {
-    int unit, buf, k, i;
+    int unit, buf;
     size_t size;
-    int blk;
     char key[20];
 
     timer_on("CIWave: CIvect read");
@@ -1781,17 +1849,23 @@ int CIvect::read(int ivect, int ibuf) {
     }
 
     if (icore_ == 1) ibuf = 0;
-    buf = ivect * buf_per_vect_ + ibuf;
-
+    buf = disk_buf(ivect, ibuf);
     size = buf_size_[ibuf] * (size_t)sizeof(double);
-
-    /* translate buffer number in case we renumbered after collapse * */
-    buf += new_first_buf_;
-    if (buf >= buf_total_) buf -= buf_total_;
     sprintf(key, "buffer_ %d", buf);
     unit = file_number_[buf];
 
-    psio_read_entry((size_t)unit, key, (char *)buffer_, size);
+    io_wait();
+    auto &disk = disk_buffers();
+    auto id = std::make_pair(unit, buf);
+    if (disk.zero.count(id)) {
+        memset(buffer_, 0, size);
+    } else if (io_unit_ == unit && io_disk_buf_ == buf && disk.generation[id] == io_generation_) {
+        memcpy(buffer_, io_buffer_.data(), size);
+    } else {
+        std::lock_guard<std::mutex> guard(disk.io_lock);
+        psio_read_entry((size_t)unit, key, (char *)buffer_, size);
+    }
+    if (io_unit_ == unit && io_disk_buf_ == buf) io_disk_buf_ = -1;
 
     cur_vect_ = ivect;
     cur_buf_ = ibuf;
@@ -1803,6 +1877,7 @@ int CIvect::read(int ivect, int ibuf) {
 
 /*
 ** CIvect::write(): Write a section of a CI vector to external storage.
+** Rewriting a buffer of zeros over a buffer of zeros is skipped.
 **
 ** Parameters:
 **    ivect  = vector number
@@ -1813,9 +1888,8 @@ int CIvect::read(int ivect, int ibuf) {
 ** Returns: 1 for success, 0 for failure
 */
 int CIvect::write(int ivect, int ibuf) {
-    int unit, buf, i;
+    int unit, buf;
     size_t size;
-    int blk;
     char key[20];
 
     // If we are just an incore buffer
@@ -1825,23 +1899,18 @@ int CIvect::write(int ivect, int ibuf) {
 
     if (ivect >= maxvect_) throw PSIEXCEPTION("(CIvect::write): ivect >= maxvect");
     if (ivect > nvect_) throw PSIEXCEPTION("(CIvect::write): ivect > nvect");
-    // {
-    //    outfile->Printf( "(CIvect::write): ivect >= maxvect\n");
-    //    timer_off("CIWave: CIvect write");
-    //    return(0);
-    //    }
 
     if (icore_ == 1) ibuf = 0;
-    buf = ivect * buf_per_vect_ + ibuf;
+    buf = disk_buf(ivect, ibuf);
     size = buf_size_[ibuf] * (size_t)sizeof(double);
-
-    /* translate buffer number in case we renumbered after collapse * */
-    buf += new_first_buf_;
-    if (buf >= buf_total_) buf -= buf_total_;
     sprintf(key, "buffer_ %d", buf);
     unit = file_number_[buf];
 
-    psio_write_entry((size_t)unit, key, (char *)buffer_, size);
+    io_wait();
+    if (disk_write_needed(unit, buf, buffer_, buf_size_[ibuf])) {
+        std::lock_guard<std::mutex> guard(disk_buffers().io_lock);
+        psio_write_entry((size_t)unit, key, (char *)buffer_, size);
+    }
 
     if (ivect >= nvect_) nvect_ = ivect + 1;
     cur_vect_ = ivect;
@@ -1852,6 +1921,90 @@ int CIvect::write(int ivect, int ibuf) {
     return (1);
 }
 
+/*
+** CIvect::prefetch(): Start reading a section of a CI vector in the
+** background, so that the read() of it that follows does not wait on the
+** disk.  Only one section is fetched at a time.  libpsio is only safe
+** against other CIvect buffer I/O while this runs, so callers finish with
+** read() or io_wait() before anything else uses libpsio.
+**
+** Parameters:
+**    ivect  = vector number
+**    ibuf   = buffer number, as for read()
+*/
+void CIvect::prefetch(int ivect, int ibuf) {
+    if (nunits_ < 1 || ivect < 0 || ibuf < 0) return;
+    if (icore_ == 1) ibuf = 0;
+    int buf = disk_buf(ivect, ibuf);
+    int unit = file_number_[buf];
+    size_t size = buf_size_[ibuf] * (size_t)sizeof(double);
+    auto &disk = disk_buffers();
+    auto id = std::make_pair(unit, buf);
+
+    if (disk.zero.count(id)) return;
+    if (io_unit_ == unit && io_disk_buf_ == buf && disk.generation[id] == io_generation_) return;
+
+    io_wait();
+    io_buffer_.resize(buffer_size_);
+    io_unit_ = unit;
+    io_disk_buf_ = buf;
+    io_generation_ = disk.generation[id];
+
+    std::string key = "buffer_ " + std::to_string(buf);
+    double *dest = io_buffer_.data();
+    io_thread_ = std::thread([unit, key, dest, size, &disk]() {
+        std::lock_guard<std::mutex> guard(disk.io_lock);
+        psio_read_entry((size_t)unit, key.c_str(), (char *)dest, size);
+    });
+}
+
+/*
+** CIvect::write_behind(): As write(), but the data are copied aside and
+** written in the background, so the in-core buffer can be reused at once.
+** The same rules as for prefetch() apply.
+*/
+void CIvect::write_behind(int ivect, int ibuf) {
+    if (nunits_ < 1) return;
+
+    if (ivect >= maxvect_) throw PSIEXCEPTION("(CIvect::write_behind): ivect >= maxvect");
+    if (ivect > nvect_) throw PSIEXCEPTION("(CIvect::write_behind): ivect > nvect");
+
+    if (icore_ == 1) ibuf = 0;
+    int buf = disk_buf(ivect, ibuf);
+    int unit = file_number_[buf];
+    size_t size = buf_size_[ibuf] * (size_t)sizeof(double);
+
+    io_wait();
+    if (disk_write_needed(unit, buf, buffer_, buf_size_[ibuf])) {
+        io_buffer_.resize(buffer_size_);
+        memcpy(io_buffer_.data(), buffer_, size);
+        io_disk_buf_ = -1;
+
+        std::string key = "buffer_ " + std::to_string(buf);
+        double *src = io_buffer_.data();
+        auto &disk = disk_buffers();
+        io_thread_ = std::thread([unit, key, src, size, &disk]() {
+            std::lock_guard<std::mutex> guard(disk.io_lock);
+            psio_write_entry((size_t)unit, key.c_str(), (char *)src, size);
+        });
+    }
+
+    if (ivect >= nvect_) nvect_ = ivect + 1;
+    cur_vect_ = ivect;
+    cur_buf_ = ibuf;
+}
+
+/*
+** CIvect::io_wait(): Finish any background read or write of this vector.
+*/
+void CIvect::io_wait() {
+    if (io_thread_.joinable()) {
+        timer_on("CIWave: CIvect I/O wait");
+        io_thread_.join();
+        timer_off("CIWave: CIvect I/O wait");
+    }
+}
+
 /*
 ** CIvect::schmidt_add()
 **
@@ -2781,6 +2934,10 @@ void CIvect::gather(int ivec, int nvec, int nroot, double **alpha, CIvect &C) {
         zero_arr(buffer_, buf_size_[buf]);
         for (oldvec = 0; oldvec < nvec; oldvec++) {
             C.read(oldvec, buf);
+            if (oldvec + 1 < nvec)
+                C.prefetch(oldvec + 1, buf);
+            else if (buf + 1 < buf_per_vect_)
+                C.prefetch(0, buf + 1);
             xpeay(buffer_, alpha[oldvec][nroot], C.buffer_, buf_size_[buf]);
             /* outfile->Printf("coef[%d][%d] = %10.7f\n",oldvec,nroot,alpha[oldvec][nroot]); */
         }
@@ -3305,6 +3462,7 @@ double CIvect::dcalc_evangelisti(int rootnum, int num_vecs, double lambda, CIvec
 void CIvect::write_new_first_buf() {
     int unit;
 
+    io_wait();
     unit = first_unit_;
     psio_write_entry((size_t)unit, "New First Buffer", (char *)&new_first_buf_, sizeof(int));
 }
@@ -3321,6 +3479,7 @@ int CIvect::read_new_first_buf() {
     int unit;
     int nfb;
 
+    io_wait();
     unit = first_unit_;
     if (psio_tocscan((size_t)unit, "New First Buffer") == nullptr) return (-1);
     psio_read_entry((size_t)unit, "New First Buffer", (char *)&nfb, sizeof(int));
@@ -3344,6 +3503,7 @@ int CIvect::read_num_vecs() {
     int unit;
     int nv;
 
+    io_wait();
     unit = first_unit_;
     if (psio_tocscan((size_t)unit, "Num Vectors") == nullptr) return (-1);
     psio_read_entry((size_t)unit, "Num Vectors", (char *)&nv, sizeof(int));
@@ -3357,6 +3517,7 @@ int CIvect::read_num_vecs() {
 void CIvect::write_num_vecs(int nv) {
     int unit;
 
+    io_wait();
     unit = first_unit_;
     psio_write_entry((size_t)unit, "Num Vectors", (char *)&nv, sizeof(int));
     write_toc();
@@ -3372,6 +3533,7 @@ void CIvect::write_num_vecs(int nv) {
 void CIvect::write_toc() {
     int i, unit;
 
+    io_wait();
     for (i = 0; i < nunits_; i++) {
         psio_tocwrite(units_[i]);
     }
@@ -33,6 +33,9 @@
 #ifndef _psi_src_bin_detci_civect_h
 #define _psi_src_bin_detci_civect_h
 
+#include <thread>
+#include <vector>
+
 #include "psi4/pybind11.h"
 
 // Forward declarations
@@ -124,6 +127,14 @@ class CIvect {
     int print_lvl_;                /* print level*/
     bool fopen_;                   /* Are CIVec files open? */
 
+    std::thread io_thread_;         /* helper for prefetch/write-behind    */
+    std::vector<double> io_buffer_; /* data being prefetched or written    */
+    int io_unit_;                   /* unit and disk buffer prefetched     */
+    int io_disk_buf_;               /*   into io_buffer_, -1 if none       */
+    size_t io_generation_;          /* writes of that buffer at prefetch   */
+
+    int disk_buf(int ivect, int ibuf);
+
     double ssq(struct stringwr *alplist, struct stringwr *betlist, double **CL, double **CR, int nas, int nbs,
                int Ja_list, int Jb_list);
 
@@ -162,6 +173,9 @@ class CIvect {
     void close_io_files(int keep);
     int read(int tvec, int ibuf);
     int write(int tvec, int ibuf);
+    void prefetch(int tvec, int ibuf);
+    void write_behind(int tvec, int ibuf);
+    void io_wait();
     void buf_lock(double *a);
     void buf_unlock();
     double *buf_malloc();
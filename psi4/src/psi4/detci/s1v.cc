@@ -51,6 +51,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/wavefunction.h"
@@ -64,6 +65,31 @@ extern void b2brepl(unsigned char **occs, int *Jcnt, int **Jij, int **Joij, int
 
 #define INDEX(i, j) ((i > j) ? (ioff[(i)] + (j)) : (ioff[(j)] + (i)))
 
+/*
+** S1_GATHER()
+**
+** S(Ia,Ib) += \sum_Jb C(Ia,Jb) F(Jb) for one column Ib of S. The nonzero
+** F(Jb) are packed first, so each row of C is a short gather.
+*/
+static void s1_gather(double **C, double **S, double *F, int *Fidx, double *Fval, int nas, int Ib_idx,
+                      int Jb_list_nbs) {
+    int nnz = 0;
+    for (int Jb_idx = 0; Jb_idx < Jb_list_nbs; Jb_idx++) {
+        if (F[Jb_idx] == 0.0) continue;
+        Fidx[nnz] = Jb_idx;
+        Fval[nnz++] = F[Jb_idx];
+    }
+    if (!nnz) return;
+
+    for (int Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
+        double *CI0 = C[Ia_idx];
+        double tval = 0.0;
+#pragma omp simd reduction(+ : tval)
+        for (int n = 0; n < nnz; n++) tval += CI0[Fidx[n]] * Fval[n];
+        S[Ia_idx][Ib_idx] += tval;
+    }
+}
+
 /*
 ** S1_BLOCK_VFCI():
 **
@@ -84,77 +110,55 @@ extern void b2brepl(unsigned char **occs, int *Jcnt, int **Jij, int **Joij, int
 ** Modified 5/10/96 for new sparse-F method
 */
 void s1_block_vfci(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                   double *tei, double *F, int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs) {
-    struct stringwr *Ib, *Kb;
-    size_t Ia_idx, Ib_idx, Kb_idx, Jb_idx;
-    size_t Ibcnt, Kbcnt, Kb_list, Ib_ex, Kb_ex;
-    size_t *Ibridx, *Kbridx;
-    int *Ibij, *Kbij;
-    signed char *Ibsgn, *Kbsgn;
-    int ij, kl, ijkl;
-    double Kb_sgn, Jb_sgn;
-    double tval;
+                   double *tei, int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs,
+                   int nthreads) {
+    /* each I_b fills its own column of S, so threads split the I_b's, each with its own F */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Fvec(Jb_list_nbs), Fval(Jb_list_nbs);
+        std::vector<int> Fidx(Jb_list_nbs);
+        double *F = Fvec.data();
 
-    /* loop over I_b */
-    for (Ib = betlist[Ib_list], Ib_idx = 0; Ib_idx < nbs; Ib_idx++, Ib++) {
-        zero_arr(F, Jb_list_nbs);
-
-        /* loop over excitations E^b_{kl} from |B(I_b)> */
-        for (Kb_list = 0; Kb_list < nlists; Kb_list++) {
-            Ibcnt = Ib->cnt[Kb_list];
-            Ibridx = Ib->ridx[Kb_list];
-            Ibsgn = Ib->sgn[Kb_list];
-            Ibij = Ib->ij[Kb_list];
-            for (Ib_ex = 0; Ib_ex < Ibcnt; Ib_ex++) {
-                kl = *Ibij++;
-                Kb_idx = *Ibridx++;
-                Kb_sgn = (double)*Ibsgn++;
-
-                /* B(K_b) = sgn(kl) * E^b_{kl} |B(I_b)> */
-                Kb = betlist[Kb_list] + Kb_idx;
-                if (Kb_list == Jb_list) F[Kb_idx] += Kb_sgn * oei[kl];
+        /* loop over I_b */
+#pragma omp for schedule(dynamic)
+        for (int Ib_idx = 0; Ib_idx < nbs; Ib_idx++) {
+            struct stringwr *Ib = betlist[Ib_list] + Ib_idx;
+            zero_arr(F, Jb_list_nbs);
 
-                /* loop over excitations E^b_{ij} from |B(K_b)> */
-                /* Jb_list pre-determined because of C blocking */
-                Kbcnt = Kb->cnt[Jb_list];
-                Kbridx = Kb->ridx[Jb_list];
-                Kbsgn = Kb->sgn[Jb_list];
-                Kbij = Kb->ij[Jb_list];
-                for (Kb_ex = 0; Kb_ex < Kbcnt; Kb_ex++) {
-                    Jb_idx = *Kbridx++;
-                    Jb_sgn = (double)*Kbsgn++;
-                    ij = *Kbij++;
-                    ijkl = INDEX(ij, kl);
-                    F[Jb_idx] += 0.5 * Kb_sgn * Jb_sgn * tei[ijkl];
-                }
-            } /* end loop over Ib excitations */
-        }     /* end loop over Kb_list */
-
-        /*
-        for (Ia_idx=0; Ia_idx < nas; Ia_idx++) {
-           tval = 0.0;
-           for (Jb_idx=0; Jb_idx < Jb_list_nbs; Jb_idx++) {
-              tval += C[Ia_idx][Jb_idx] * F[Jb_idx];
-              }
-           S[Ia_idx][Ib_idx] += tval;
-           }
-        */
-
-        /* need to improve mem access pattern here! Above vers may be better! */
-        /* min op cnt may also be better */
-        for (Jb_idx = 0; Jb_idx < Jb_list_nbs; Jb_idx++) {
-            if ((tval = F[Jb_idx]) == 0.0) continue;
-
-#ifdef USE_BLAS
-            C_DAXPY(nas, tval, (C[0] + Jb_idx), Jb_list_nbs, (S[0] + Ib_idx), nbs);
-#else
-            for (Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
-                S[Ia_idx][Ib_idx] += tval * C[Ia_idx][Jb_idx];
-            }
-#endif
-        }
+            /* loop over excitations E^b_{kl} from |B(I_b)> */
+            for (size_t Kb_list = 0; Kb_list < nlists; Kb_list++) {
+                size_t Ibcnt = Ib->cnt[Kb_list];
+                size_t *Ibridx = Ib->ridx[Kb_list];
+                signed char *Ibsgn = Ib->sgn[Kb_list];
+                int *Ibij = Ib->ij[Kb_list];
+                for (size_t Ib_ex = 0; Ib_ex < Ibcnt; Ib_ex++) {
+                    int kl = *Ibij++;
+                    size_t Kb_idx = *Ibridx++;
+                    double Kb_sgn = (double)*Ibsgn++;
+
+                    /* B(K_b) = sgn(kl) * E^b_{kl} |B(I_b)> */
+                    struct stringwr *Kb = betlist[Kb_list] + Kb_idx;
+                    if (Kb_list == Jb_list) F[Kb_idx] += Kb_sgn * oei[kl];
+
+                    /* loop over excitations E^b_{ij} from |B(K_b)> */
+                    /* Jb_list pre-determined because of C blocking */
+                    size_t Kbcnt = Kb->cnt[Jb_list];
+                    size_t *Kbridx = Kb->ridx[Jb_list];
+                    signed char *Kbsgn = Kb->sgn[Jb_list];
+                    int *Kbij = Kb->ij[Jb_list];
+                    for (size_t Kb_ex = 0; Kb_ex < Kbcnt; Kb_ex++) {
+                        size_t Jb_idx = *Kbridx++;
+                        double Jb_sgn = (double)*Kbsgn++;
+                        int ij = *Kbij++;
+                        int ijkl = INDEX(ij, kl);
+                        F[Jb_idx] += 0.5 * Kb_sgn * Jb_sgn * tei[ijkl];
+                    }
+                } /* end loop over Ib excitations */
+            }     /* end loop over Kb_list */
 
-    } /* end loop over Ib */
+            s1_gather(C, S, F, Fidx.data(), Fval.data(), nas, Ib_idx, Jb_list_nbs);
+        } /* end loop over Ib */
+    }
 }
 
 /*
@@ -178,85 +182,64 @@ void s1_block_vfci(struct stringwr **alplist, struct stringwr **betlist, double
 ** Modified 5/10/96 for new sparse-F method
 */
 void s1_block_vras(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                   double *tei, double *F, int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs) {
-    struct stringwr *Ib, *Kb;
-    size_t Ia_idx, Ib_idx, Kb_idx, Jb_idx;
-    size_t Ibcnt, Kbcnt, Kb_list, Ib_ex, Kb_ex;
-    size_t *Ibridx, *Kbridx;
-    int *Ibij, *Kbij, *Iboij, *Kboij;
-    signed char *Ibsgn, *Kbsgn;
-    int ij, kl, ijkl, oij, okl;
-    double Kb_sgn, Jb_sgn;
-    double tval;
-
-    /* loop over I_b */
-    for (Ib = betlist[Ib_list], Ib_idx = 0; Ib_idx < nbs; Ib_idx++, Ib++) {
-        zero_arr(F, Jb_list_nbs);
-
-        /* loop over excitations E^b_{kl} from |B(I_b)> */
-        for (Kb_list = 0; Kb_list < nlists; Kb_list++) {
-            Ibcnt = Ib->cnt[Kb_list];
-            Ibridx = Ib->ridx[Kb_list];
-            Ibsgn = Ib->sgn[Kb_list];
-            Ibij = Ib->ij[Kb_list];
-            Iboij = Ib->oij[Kb_list];
-            for (Ib_ex = 0; Ib_ex < Ibcnt; Ib_ex++) {
-                kl = *Ibij++;
-                okl = *Iboij++;
-                Kb_idx = *Ibridx++;
-                Kb_sgn = (double)*Ibsgn++;
+                   double *tei, int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs,
+                   int nthreads) {
+    /* each I_b fills its own column of S, so threads split the I_b's, each with its own F */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Fvec(Jb_list_nbs), Fval(Jb_list_nbs);
+        std::vector<int> Fidx(Jb_list_nbs);
+        double *F = Fvec.data();
 
-                /* B(K_b) = sgn(kl) * E^b_{kl} |B(I_b)> */
-                Kb = betlist[Kb_list] + Kb_idx;
-                /* note okl on next line, not kl */
-                if (Kb_list == Jb_list) F[Kb_idx] += Kb_sgn * oei[okl];
+        /* loop over I_b */
+#pragma omp for schedule(dynamic)
+        for (int Ib_idx = 0; Ib_idx < nbs; Ib_idx++) {
+            struct stringwr *Ib = betlist[Ib_list] + Ib_idx;
+            zero_arr(F, Jb_list_nbs);
 
-                /* loop over excitations E^b_{ij} from |B(K_b)> */
-                /* Jb_list pre-determined because of C blocking */
-                Kbcnt = Kb->cnt[Jb_list];
-                Kbridx = Kb->ridx[Jb_list];
-                Kbsgn = Kb->sgn[Jb_list];
-                Kbij = Kb->ij[Jb_list];
-                Kboij = Kb->oij[Jb_list];
-                for (Kb_ex = 0; Kb_ex < Kbcnt; Kb_ex++) {
-                    Jb_idx = *Kbridx++;
-                    Jb_sgn = (double)*Kbsgn++;
-                    ij = *Kbij++;
-                    oij = *Kboij++;
-                    ijkl = INDEX(ij, kl);
-                    if (oij > okl)
-                        F[Jb_idx] += Kb_sgn * Jb_sgn * tei[ijkl];
-                    else if (oij == okl)
-                        F[Jb_idx] += 0.5 * Kb_sgn * Jb_sgn * tei[ijkl];
-                }
-            } /* end loop over Ib excitations */
-        }     /* end loop over Kb_list */
-
-        /*
-        for (Ia_idx=0; Ia_idx < nas; Ia_idx++) {
-           tval = 0.0;
-           for (Jb_idx=0; Jb_idx < Jb_list_nbs; Jb_idx++) {
-              tval += C[Ia_idx][Jb_idx] * F[Jb_idx];
-              }
-           S[Ia_idx][Ib_idx] += tval;
-           }
-        */
-
-        /* need to improve mem access pattern here! Above vers may be better!  */
-        /* min op cnt may also be better */
-        for (Jb_idx = 0; Jb_idx < Jb_list_nbs; Jb_idx++) {
-            if ((tval = F[Jb_idx]) == 0.0) continue;
-
-#ifdef USE_BLAS
-            C_DAXPY(nas, tval, (C[0] + Jb_idx), Jb_list_nbs, (S[0] + Ib_idx), nbs);
-#else
-            for (Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
-                S[Ia_idx][Ib_idx] += tval * C[Ia_idx][Jb_idx];
-            }
-#endif
-        }
+            /* loop over excitations E^b_{kl} from |B(I_b)> */
+            for (size_t Kb_list = 0; Kb_list < nlists; Kb_list++) {
+                size_t Ibcnt = Ib->cnt[Kb_list];
+                size_t *Ibridx = Ib->ridx[Kb_list];
+                signed char *Ibsgn = Ib->sgn[Kb_list];
+                int *Ibij = Ib->ij[Kb_list];
+                int *Iboij = Ib->oij[Kb_list];
+                for (size_t Ib_ex = 0; Ib_ex < Ibcnt; Ib_ex++) {
+                    int kl = *Ibij++;
+                    int okl = *Iboij++;
+                    size_t Kb_idx = *Ibridx++;
+                    double Kb_sgn = (double)*Ibsgn++;
+
+                    /* B(K_b) = sgn(kl) * E^b_{kl} |B(I_b)> */
+                    struct stringwr *Kb = betlist[Kb_list] + Kb_idx;
+                    /* note okl on next line, not kl */
+                    if (Kb_list == Jb_list) F[Kb_idx] += Kb_sgn * oei[okl];
+
+                    /* loop over excitations E^b_{ij} from |B(K_b)> */
+                    /* Jb_list pre-determined because of C blocking */
+                    size_t Kbcnt = Kb->cnt[Jb_list];
+                    size_t *Kbridx = Kb->ridx[Jb_list];
+                    signed char *Kbsgn = Kb->sgn[Jb_list];
+                    int *Kbij = Kb->ij[Jb_list];
+                    int *Kboij = Kb->oij[Jb_list];
+                    for (size_t Kb_ex = 0; Kb_ex < Kbcnt; Kb_ex++) {
+                        size_t Jb_idx = *Kbridx++;
+                        double Jb_sgn = (double)*Kbsgn++;
+                        int ij = *Kbij++;
+                        int oij = *Kboij++;
+                        int ijkl = INDEX(ij, kl);
+                        if (oij > okl)
+                            F[Jb_idx] += Kb_sgn * Jb_sgn * tei[ijkl];
+                        else if (oij == okl)
+                            F[Jb_idx] += 0.5 * Kb_sgn * Jb_sgn * tei[ijkl];
+                    }
+                } /* end loop over Ib excitations */
+            }     /* end loop over Kb_list */
+
+            s1_gather(C, S, F, Fidx.data(), Fval.data(), nas, Ib_idx, Jb_list_nbs);
 
-    } /* end loop over Ib */
+        } /* end loop over Ib */
+    }
 }
 
 /*
@@ -36,6 +36,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/wavefunction.h"
@@ -64,73 +65,70 @@ int form_ilist_rotf(int *Cnt, int **Ridx, signed char **Sn, int **Ij, int nas, i
 */
 void s3_block_vdiag(struct stringwr *alplist, struct stringwr *betlist, double **C, double **S, double *tei, int nas,
                     int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym, int Jb_sym, double **Cprime,
-                    double *F, double *V, double *Sgn, int *L, int *R, int norbs, int *orbsym) {
-    struct stringwr *Ia;
-    size_t Ia_ex;
-    int ij, i, j, t, kl, I, J, RJ;
-    double tval, VS, *CprimeI0, *CI0;
-    int jlen, Jacnt, *Iaij, Ia_idx;
-    size_t *Iaridx;
-    signed char *Iasgn;
-    double *Tptr;
-    int npthreads, rc, status;
-
-    /* loop over i, j */
-    for (i = 0; i < norbs; i++) {
-        for (j = 0; j <= i; j++) {
-            if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
-            ij = ioff[i] + j;
-            jlen = form_ilist(betlist, Jb_list, nbs, ij, L, R, Sgn);
-
-            if (!jlen) continue;
-            /*  outfile->Printf("S3_BLOCK_VDIAG: ij = %d\t jlen = %d\n", ij, jlen);
-             */
-            Tptr = tei + ioff[ij];
-
-            /* gather operation */
-            for (I = 0; I < cnas; I++) {
-                CprimeI0 = Cprime[I];
-                CI0 = C[I];
-                for (J = 0; J < jlen; J++) {
-                    tval = Sgn[J];
-                    CprimeI0[J] = CI0[L[J]] * tval;
+                    double *Sgn, int *L, int *R, int norbs, int *orbsym, int nthreads) {
+    /* The string list of each ij is formed once and shared; the gather over
+     * C and the I_a loop are then split over threads.  Each I_a owns its row
+     * of S and the R[J] of one ij are distinct, so no two threads write the
+     * same element. */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Vvec(nbs);
+        double *V = Vvec.data();
+        int jlen;
+
+        /* loop over i, j */
+        for (int i = 0; i < norbs; i++) {
+            for (int j = 0; j <= i; j++) {
+                if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
+                int ij = ioff[i] + j;
+#pragma omp single copyprivate(jlen)
+                jlen = form_ilist(betlist, Jb_list, nbs, ij, L, R, Sgn);
+
+                if (!jlen) continue;
+
+                double *Tptr = tei + ioff[ij];
+
+                /* gather operation */
+#pragma omp for
+                for (int I = 0; I < cnas; I++) {
+                    double *CprimeI0 = Cprime[I];
+                    double *CI0 = C[I];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) CprimeI0[J] = CI0[L[J]] * Sgn[J];
                 }
-            }
 
-            for (Ia = alplist, Ia_idx = 0; Ia_idx < nas; Ia_idx++, Ia++) {
-                /* loop over excitations E^a_{kl} from |A(I_a)> */
-                Jacnt = Ia->cnt[Ja_list];
-                Iaridx = Ia->ridx[Ja_list];
-                Iasgn = Ia->sgn[Ja_list];
-                Iaij = Ia->ij[Ja_list];
-
-                zero_arr(V, jlen);
-                for (Ia_ex = 0; Ia_ex < Jacnt && (kl = *Iaij++) <= ij; Ia_ex++) {
-                    I = *Iaridx++;
-                    tval = *Iasgn++;
-                    if (ij == kl) tval *= 0.5;
-                    VS = Tptr[kl] * tval;
-                    CprimeI0 = Cprime[I];
-
-#ifdef USE_BS
-                    C_DAXPY(jlen, VS, CprimeI0, 1, V, 1);
-#else
-                    for (J = 0; J < jlen; J++) {
-                        V[J] += VS * CprimeI0[J];
+                /* loop over Ia */
+#pragma omp for schedule(dynamic)
+                for (int Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
+                    /* loop over excitations E^a_{kl} from |A(I_a)> */
+                    struct stringwr *Ia = alplist + Ia_idx;
+                    int Jacnt = Ia->cnt[Ja_list];
+                    size_t *Iaridx = Ia->ridx[Ja_list];
+                    signed char *Iasgn = Ia->sgn[Ja_list];
+                    int *Iaij = Ia->ij[Ja_list];
+
+                    zero_arr(V, jlen);
+                    int kl;
+                    for (int Ia_ex = 0; Ia_ex < Jacnt && (kl = *Iaij++) <= ij; Ia_ex++) {
+                        int I = *Iaridx++;
+                        double tval = *Iasgn++;
+                        if (ij == kl) tval *= 0.5;
+                        double VS = Tptr[kl] * tval;
+                        double *CprimeI0 = Cprime[I];
+#pragma omp simd
+                        for (int J = 0; J < jlen; J++) V[J] += VS * CprimeI0[J];
                     }
-#endif
-                }
 
-                /* scatter */
-                for (J = 0; J < jlen; J++) {
-                    RJ = R[J];
-                    S[Ia_idx][RJ] += V[J];
-                }
+                    /* scatter */
+                    double *SI0 = S[Ia_idx];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) SI0[R[J]] += V[J];
 
-            } /* end loop over Ia */
+                } /* end loop over Ia */
 
-        } /* end loop over j */
-    }     /* end loop over i */
+            } /* end loop over j */
+        }     /* end loop over i */
+    }
 }
 
 /*
@@ -142,75 +140,65 @@ void s3_block_vdiag(struct stringwr *alplist, struct stringwr *betlist, double *
 */
 void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C, double **S, double *tei, int nas,
                 int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym, int Jb_sym, double **Cprime,
-                double *F, double *V, double *Sgn, int *L, int *R, int norbs, int *orbsym) {
-    struct stringwr *Ia;
-    size_t Ia_ex;
-    int ij, i, j, kl, ijkl, I, J, RJ;
-    double tval, VS, *CprimeI0, *CI0;
-    int jlen, Ia_idx, Jacnt, *Iaij;
-    size_t *Iaridx;
-    signed char *Iasgn;
-    double *Tptr;
-
-    /* loop over i, j */
-    for (i = 0; i < norbs; i++) {
-        for (j = 0; j <= i; j++) {
-            if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
-            ij = ioff[i] + j;
-            jlen = form_ilist(betlist, Jb_list, nbs, ij, L, R, Sgn);
-
-            if (!jlen) continue;
-
-            Tptr = tei + ioff[ij];
-
-            /* gather operation */
-            for (I = 0; I < cnas; I++) {
-                CprimeI0 = Cprime[I];
-                CI0 = C[I];
-                for (J = 0; J < jlen; J++) {
-                    tval = Sgn[J];
-                    CprimeI0[J] = CI0[L[J]] * tval;
+                double *Sgn, int *L, int *R, int norbs, int *orbsym, int nthreads) {
+    /* threaded as s3_block_vdiag() */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Vvec(nbs);
+        double *V = Vvec.data();
+        int jlen;
+
+        /* loop over i, j */
+        for (int i = 0; i < norbs; i++) {
+            for (int j = 0; j <= i; j++) {
+                if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
+                int ij = ioff[i] + j;
+#pragma omp single copyprivate(jlen)
+                jlen = form_ilist(betlist, Jb_list, nbs, ij, L, R, Sgn);
+
+                if (!jlen) continue;
+
+                /* gather operation */
+#pragma omp for
+                for (int I = 0; I < cnas; I++) {
+                    double *CprimeI0 = Cprime[I];
+                    double *CI0 = C[I];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) CprimeI0[J] = CI0[L[J]] * Sgn[J];
                 }
-            }
 
-            timer_on("CIWave: s3_mt");
-            for (Ia = alplist, Ia_idx = 0; Ia_idx < nas; Ia_idx++, Ia++) {
-                /* loop over excitations E^a_{kl} from |A(I_a)> */
-                Jacnt = Ia->cnt[Ja_list];
-                Iaridx = Ia->ridx[Ja_list];
-                Iasgn = Ia->sgn[Ja_list];
-                Iaij = Ia->ij[Ja_list];
-
-                zero_arr(V, jlen);
-
-                for (Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
-                    kl = *Iaij++;
-                    I = *Iaridx++;
-                    tval = *Iasgn++;
-                    ijkl = INDEX(ij, kl);
-                    VS = tval * tei[ijkl];
-                    CprimeI0 = Cprime[I];
-
-#ifdef UBLAS
-                    C_DAXPY(jlen, VS, CprimeI0, 1, V, 1);
-#else
-                    for (J = 0; J < jlen; J++) {
-                        V[J] += VS * CprimeI0[J];
+                /* loop over Ia */
+#pragma omp for schedule(dynamic)
+                for (int Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
+                    /* loop over excitations E^a_{kl} from |A(I_a)> */
+                    struct stringwr *Ia = alplist + Ia_idx;
+                    int Jacnt = Ia->cnt[Ja_list];
+                    size_t *Iaridx = Ia->ridx[Ja_list];
+                    signed char *Iasgn = Ia->sgn[Ja_list];
+                    int *Iaij = Ia->ij[Ja_list];
+
+                    zero_arr(V, jlen);
+                    for (int Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
+                        int kl = *Iaij++;
+                        int I = *Iaridx++;
+                        double tval = *Iasgn++;
+                        int ijkl = INDEX(ij, kl);
+                        double VS = tval * tei[ijkl];
+                        double *CprimeI0 = Cprime[I];
+#pragma omp simd
+                        for (int J = 0; J < jlen; J++) V[J] += VS * CprimeI0[J];
                     }
-#endif
-                }
 
-                /* scatter */
-                for (J = 0; J < jlen; J++) {
-                    RJ = R[J];
-                    S[Ia_idx][RJ] += V[J];
-                }
+                    /* scatter */
+                    double *SI0 = S[Ia_idx];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) SI0[R[J]] += V[J];
 
-            } /* end loop over Ia */
-            timer_off("CIWave: s3_mt");
+                } /* end loop over Ia */
 
-        } /* end loop over j */
-    }     /* end loop over i */
+            } /* end loop over j */
+        }     /* end loop over i */
+    }
 }
 
 int form_ilist(struct stringwr *alplist, int Ja_list, int nas, int kl, int *L, int *R, double *Sgn) {
@@ -259,76 +247,69 @@ int form_ilist(struct stringwr *alplist, int Ja_list, int nas, int kl, int *L, i
 
 void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed char **Sn[2], double **C, double **S,
                          double *tei, int nas, int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym,
-                         int Jb_sym, double **Cprime, double *F, double *V, double *Sgn, int *L, int *R, int norbs,
-                         int *orbsym) {
-    int Ia_ex;
-    int ij, i, j, kl, I, J, RJ;
-    double tval, VS, *CprimeI0, *CI0;
-    int jlen, Ia_idx, Jacnt, *Iaij;
-    int *Iaridx;
-    signed char *Iasgn;
-    double *Tptr;
-
-    /* loop over i, j */
-    for (i = 0; i < norbs; i++) {
-        for (j = 0; j <= i; j++) {
-            if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
-            ij = ioff[i] + j;
-            jlen = form_ilist_rotf(Cnt[1], Ridx[1], Sn[1], Ij[1], nbs, ij, L, R, Sgn);
-
-            if (!jlen) continue;
-
-            Tptr = tei + ioff[ij];
-
-            /* gather operation */
-            for (I = 0; I < cnas; I++) {
-                CprimeI0 = Cprime[I];
-                CI0 = C[I];
-                for (J = 0; J < jlen; J++) {
-                    tval = Sgn[J];
-                    CprimeI0[J] = CI0[L[J]] * tval;
+                         int Jb_sym, double **Cprime, double *Sgn, int *L, int *R, int norbs, int *orbsym,
+                         int nthreads) {
+    /* threaded as s3_block_vdiag() */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Vvec(nbs);
+        double *V = Vvec.data();
+        int jlen;
+
+        /* loop over i, j */
+        for (int i = 0; i < norbs; i++) {
+            for (int j = 0; j <= i; j++) {
+                if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
+                int ij = ioff[i] + j;
+#pragma omp single copyprivate(jlen)
+                jlen = form_ilist_rotf(Cnt[1], Ridx[1], Sn[1], Ij[1], nbs, ij, L, R, Sgn);
+
+                if (!jlen) continue;
+
+                double *Tptr = tei + ioff[ij];
+
+                /* gather operation */
+#pragma omp for
+                for (int I = 0; I < cnas; I++) {
+                    double *CprimeI0 = Cprime[I];
+                    double *CI0 = C[I];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) CprimeI0[J] = CI0[L[J]] * Sgn[J];
                 }
-            }
 
-            /* loop over Ia */
-            for (Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
-                /* loop over excitations E^a_{kl} from |A(I_a)> */
-                Jacnt = Cnt[0][Ia_idx];
-                Iaridx = Ridx[0][Ia_idx];
-                Iasgn = Sn[0][Ia_idx];
-                Iaij = Ij[0][Ia_idx];
-
-                zero_arr(V, jlen);
-
-                /* rotf doesn't yet ensure kl's in order */
-                for (Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
-                    kl = *Iaij++;
-                    I = *Iaridx++;
-                    tval = *Iasgn++;
-                    if (kl > ij) continue;
-                    if (ij == kl) tval *= 0.5;
-                    VS = Tptr[kl] * tval;
-                    CprimeI0 = Cprime[I];
-
-#ifdef USE_BLAS
-                    C_DAXPY(jlen, VS, CprimeI0, 1, V, 1);
-#else
-                    for (J = 0; J < jlen; J++) {
-                        V[J] += VS * CprimeI0[J];
+                /* loop over Ia */
+#pragma omp for schedule(dynamic)
+                for (int Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
+                    /* loop over excitations E^a_{kl} from |A(I_a)> */
+                    int Jacnt = Cnt[0][Ia_idx];
+                    int *Iaridx = Ridx[0][Ia_idx];
+                    signed char *Iasgn = Sn[0][Ia_idx];
+                    int *Iaij = Ij[0][Ia_idx];
+
+                    zero_arr(V, jlen);
+                    /* rotf doesn't yet ensure kl's in order */
+                    for (int Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
+                        int kl = *Iaij++;
+                        int I = *Iaridx++;
+                        double tval = *Iasgn++;
+                        if (kl > ij) continue;
+                        if (ij == kl) tval *= 0.5;
+                        double VS = Tptr[kl] * tval;
+                        double *CprimeI0 = Cprime[I];
+#pragma omp simd
+                        for (int J = 0; J < jlen; J++) V[J] += VS * CprimeI0[J];
                     }
-#endif
-                }
 
-                /* scatter */
-                for (J = 0; J < jlen; J++) {
-                    RJ = R[J];
-                    S[Ia_idx][RJ] += V[J];
-                }
+                    /* scatter */
+                    double *SI0 = S[Ia_idx];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) SI0[R[J]] += V[J];
 
-            } /* end loop over Ia */
+                } /* end loop over Ia */
 
-        } /* end loop over j */
-    }     /* end loop over i */
+            } /* end loop over j */
+        }     /* end loop over i */
+    }
 }
 
 /*
@@ -340,73 +321,64 @@ void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed char **
 */
 void s3_block_vrotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed char **Sn[2], double **C, double **S, double *tei,
                     int nas, int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym, int Jb_sym,
-                    double **Cprime, double *F, double *V, double *Sgn, int *L, int *R, int norbs, int *orbsym) {
-    int Ia_ex;
-    int ij, i, j, kl, ijkl, I, J, RJ;
-    double tval, VS, *CprimeI0, *CI0;
-    int jlen, Ia_idx, Jacnt, *Iaij;
-    int *Iaridx;
-    signed char *Iasgn;
-    double *Tptr;
-
-    /* loop over i, j */
-    for (i = 0; i < norbs; i++) {
-        for (j = 0; j <= i; j++) {
-            if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
-            ij = ioff[i] + j;
-            jlen = form_ilist_rotf(Cnt[1], Ridx[1], Sn[1], Ij[1], nbs, ij, L, R, Sgn);
-
-            if (!jlen) continue;
-
-            Tptr = tei + ioff[ij];
-
-            /* gather operation */
-            for (I = 0; I < cnas; I++) {
-                CprimeI0 = Cprime[I];
-                CI0 = C[I];
-                for (J = 0; J < jlen; J++) {
-                    tval = Sgn[J];
-                    CprimeI0[J] = CI0[L[J]] * tval;
+                    double **Cprime, double *Sgn, int *L, int *R, int norbs, int *orbsym, int nthreads) {
+    /* threaded as s3_block_vdiag() */
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Vvec(nbs);
+        double *V = Vvec.data();
+        int jlen;
+
+        /* loop over i, j */
+        for (int i = 0; i < norbs; i++) {
+            for (int j = 0; j <= i; j++) {
+                if ((orbsym[i] ^ orbsym[j] ^ Jb_sym ^ Ib_sym) != 0) continue;
+                int ij = ioff[i] + j;
+#pragma omp single copyprivate(jlen)
+                jlen = form_ilist_rotf(Cnt[1], Ridx[1], Sn[1], Ij[1], nbs, ij, L, R, Sgn);
+
+                if (!jlen) continue;
+
+                /* gather operation */
+#pragma omp for
+                for (int I = 0; I < cnas; I++) {
+                    double *CprimeI0 = Cprime[I];
+                    double *CI0 = C[I];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) CprimeI0[J] = CI0[L[J]] * Sgn[J];
                 }
-            }
 
-            /* loop over Ia */
-            for (Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
-                /* loop over excitations E^a_{kl} from |A(I_a)> */
-                Jacnt = Cnt[0][Ia_idx];
-                Iaridx = Ridx[0][Ia_idx];
-                Iasgn = Sn[0][Ia_idx];
-                Iaij = Ij[0][Ia_idx];
-
-                zero_arr(V, jlen);
-
-                for (Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
-                    kl = *Iaij++;
-                    I = *Iaridx++;
-                    tval = *Iasgn++;
-                    ijkl = INDEX(ij, kl);
-                    VS = tval * tei[ijkl];
-                    CprimeI0 = Cprime[I];
-
-#ifdef USE_BLAS
-                    C_DAXPY(jlen, VS, CprimeI0, 1, V, 1);
-#else
-                    for (J = 0; J < jlen; J++) {
-                        V[J] += VS * CprimeI0[J];
+                /* loop over Ia */
+#pragma omp for schedule(dynamic)
+                for (int Ia_idx = 0; Ia_idx < nas; Ia_idx++) {
+                    /* loop over excitations E^a_{kl} from |A(I_a)> */
+                    int Jacnt = Cnt[0][Ia_idx];
+                    int *Iaridx = Ridx[0][Ia_idx];
+                    signed char *Iasgn = Sn[0][Ia_idx];
+                    int *Iaij = Ij[0][Ia_idx];
+
+                    zero_arr(V, jlen);
+                    for (int Ia_ex = 0; Ia_ex < Jacnt; Ia_ex++) {
+                        int kl = *Iaij++;
+                        int I = *Iaridx++;
+                        double tval = *Iasgn++;
+                        int ijkl = INDEX(ij, kl);
+                        double VS = tval * tei[ijkl];
+                        double *CprimeI0 = Cprime[I];
+#pragma omp simd
+                        for (int J = 0; J < jlen; J++) V[J] += VS * CprimeI0[J];
                     }
-#endif
-                }
 
-                /* scatter */
-                for (J = 0; J < jlen; J++) {
-                    RJ = R[J];
-                    S[Ia_idx][RJ] += V[J];
-                }
+                    /* scatter */
+                    double *SI0 = S[Ia_idx];
+#pragma omp simd
+                    for (int J = 0; J < jlen; J++) SI0[R[J]] += V[J];
 
-            } /* end loop over Ia */
+                } /* end loop over Ia */
 
-        } /* end loop over j */
-    }     /* end loop over i */
+            } /* end loop over j */
+        }     /* end loop over i */
+    }
 }
 
 int form_ilist_rotf(int *Cnt, int **Ridx, signed char **Sn, int **Ij, int nas, int kl, int *L, int *R, double *Sgn) {
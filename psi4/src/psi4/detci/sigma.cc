@@ -45,6 +45,8 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <utility>
+#include <vector>
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/vector.h"
@@ -67,19 +69,19 @@ extern void s3_block_bz(int Ialist, int Iblist, int Jalist, int Jblist, int nas,
 extern void set_row_ptrs(int rows, int cols, double **matrix);
 
 extern void s1_block_vfci(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                          double *tei, double *F, int nlists, int nas, int nbs, int Ib_list, int Jb_list,
-                          int Jb_list_nbs);
+                          double *tei, int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs,
+                          int nthreads);
 extern void s1_block_vras(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                          double *tei, double *F, int nlists, int nas, int nbs, int sbc, int cbc, int cnbs);
+                          double *tei, int nlists, int nas, int nbs, int sbc, int cbc, int cnbs, int nthreads);
 extern void s1_block_vras_rotf(int *Cnt[2], int **Ij[2], int **Oij[2], int **Ridx[2], signed char **Sgn[2],
                                unsigned char **Toccs, double **C, double **S, double *oei, double *tei, double *F,
                                int nlists, int nas, int nbs, int Ib_list, int Jb_list, int Jb_list_nbs,
                                struct olsen_graph *BetaG, struct calcinfo *CIinfo, unsigned char ***Occs);
 extern void s2_block_vfci(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                          double *tei, double *F, int nlists, int nas, int nbs, int Ia_list, int Ja_list,
-                          int Ja_list_nas);
+                          double *tei, int nlists, int nas, int nbs, int Ia_list, int Ja_list, int Ja_list_nas,
+                          int nthreads);
 extern void s2_block_vras(struct stringwr **alplist, struct stringwr **betlist, double **C, double **S, double *oei,
-                          double *tei, double *F, int nlists, int nas, int nbs, int sac, int cac, int cnas);
+                          double *tei, int nlists, int nas, int nbs, int sac, int cac, int cnas, int nthreads);
 extern void s2_block_vras_rotf(int *Cnt[2], int **Ij[2], int **Oij[2], int **Ridx[2], signed char **Sgn[2],
                                unsigned char **Toccs, double **C, double **S, double *oei, double *tei, double *F,
                                int nlists, int nas, int nbs, int Ia_list, int Ja_list, int Ja_list_nbs,
@@ -87,18 +89,18 @@ extern void s2_block_vras_rotf(int *Cnt[2], int **Ij[2], int **Oij[2], int **Rid
                                unsigned char ***Occs);
 extern void s3_block_vdiag(struct stringwr *alplist, struct stringwr *betlist, double **C, double **S, double *tei,
                            int nas, int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym, int Jb_sym,
-                           double **Cprime, double *F, double *V, double *Sgn, int *L, int *R, int norbs, int *orbsym);
+                           double **Cprime, double *Sgn, int *L, int *R, int norbs, int *orbsym, int nthreads);
 extern void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C, double **S, double *tei, int nas,
                        int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym, int Jb_sym,
-                       double **Cprime, double *F, double *V, double *Sgn, int *L, int *R, int norbs, int *orbsym);
+                       double **Cprime, double *Sgn, int *L, int *R, int norbs, int *orbsym, int nthreads);
 extern void s3_block_vrotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed char **Sn[2], double **C, double **S,
                            double *tei, int nas, int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list, int Ib_sym,
-                           int Jb_sym, double **Cprime, double *F, double *V, double *Sgn, int *L, int *R, int norbs,
-                           int *orbsym);
+                           int Jb_sym, double **Cprime, double *Sgn, int *L, int *R, int norbs, int *orbsym,
+                           int nthreads);
 extern void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2], signed char **Sn[2], double **C, double **S,
                                 double *tei, int nas, int nbs, int cnas, int Ib_list, int Ja_list, int Jb_list,
-                                int Ib_sym, int Jb_sym, double **Cprime, double *F, double *V, double *Sgn, int *L,
-                                int *R, int norbs, int *orbsym);
+                                int Ib_sym, int Jb_sym, double **Cprime, double *Sgn, int *L, int *R, int norbs,
+                                int *orbsym, int nthreads);
 
 /*
 ** sigma_init()
@@ -130,7 +132,6 @@ void CIWavefunction::sigma_init(CIvect &C, CIvect &S) {
     SigmaData_->F = init_array(max_dim);
 
     SigmaData_->Sgn = init_array(max_dim);
-    SigmaData_->V = init_array(max_dim);
     SigmaData_->L = init_int_array(max_dim);
     SigmaData_->R = init_int_array(max_dim);
 
@@ -228,7 +229,6 @@ void CIWavefunction::sigma_init(CIvect &C, CIvect &S) {
 void CIWavefunction::sigma_free() {
     free(SigmaData_->F);
     free(SigmaData_->Sgn);
-    free(SigmaData_->V);
     free(SigmaData_->L);
     free(SigmaData_->R);
     if (Parameters_->repl_otf) {
@@ -328,6 +328,30 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
     else
         phase = ((int)Parameters_->S % 2) ? -1 : 1;
 
+    /* the C buffers each sigma buffer needs, in order, so that the next one
+       can be read in the background while the current one is contracted */
+    std::vector<std::vector<std::pair<int, int>>> cbufs(S.buf_per_vect_);
+    for (buf = 0; buf < S.buf_per_vect_; buf++) {
+        sblock = S.buf2blk_[buf];
+        for (cbuf = 0; cbuf < C.buf_per_vect_; cbuf++) {
+            do_cblock = 0;
+            do_cblock2 = 0;
+            cblock = C.buf2blk_[cbuf];
+            cblock2 = -1;
+            cac = C.Ia_code_[cblock];
+            cbc = C.Ib_code_[cblock];
+            if (C.Ms0_) cblock2 = C.decode_[cbc][cac];
+            if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] || s3_contrib_[sblock][cblock])
+                do_cblock = 1;
+            if (C.buf_offdiag_[cbuf] &&
+                (s1_contrib_[sblock][cblock2] || s2_contrib_[sblock][cblock2] || s3_contrib_[sblock][cblock2]))
+                do_cblock2 = 1;
+            if (C.check_zero_block(cblock)) do_cblock = 0;
+            if (cblock2 >= 0 && C.check_zero_block(cblock2)) do_cblock2 = 0;
+            if (do_cblock || do_cblock2) cbufs[buf].push_back(std::make_pair(cbuf, do_cblock + 2 * do_cblock2));
+        }
+    }
+
     /* this does a sigma subblock at a time: icore==0 */
     for (buf = 0; buf < S.buf_per_vect_; buf++) {
         S.zero();
@@ -340,9 +364,10 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
         sbirr = sbc / BetaG_->subgr_per_irrep;
         if (SigmaData_->sprime != nullptr) set_row_ptrs(nas, nbs, SigmaData_->sprime);
 
-        for (cbuf = 0; cbuf < C.buf_per_vect_; cbuf++) {
-            do_cblock = 0;
-            do_cblock2 = 0;
+        for (size_t n = 0; n < cbufs[buf].size(); n++) {
+            cbuf = cbufs[buf][n].first;
+            do_cblock = cbufs[buf][n].second & 1;
+            do_cblock2 = cbufs[buf][n].second & 2;
             cblock = C.buf2blk_[cbuf];
             cblock2 = -1;
             cac = C.Ia_code_[cblock];
@@ -352,17 +377,20 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
             if (C.Ms0_) cblock2 = C.decode_[cbc][cac];
             cnas = C.Ia_size_[cblock];
             cnbs = C.Ib_size_[cblock];
-            if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] || s3_contrib_[sblock][cblock])
-                do_cblock = 1;
-            if (C.buf_offdiag_[cbuf] &&
-                (s1_contrib_[sblock][cblock2] || s2_contrib_[sblock][cblock2] || s3_contrib_[sblock][cblock2]))
-                do_cblock2 = 1;
-            if (C.check_zero_block(cblock)) do_cblock = 0;
-            if (cblock2 >= 0 && C.check_zero_block(cblock2)) do_cblock2 = 0;
-            if (!do_cblock && !do_cblock2) continue;
 
             C.read(C.cur_vect_, cbuf);
 
+            /* start on the next C buffer needed, for this or a later sigma buffer */
+            if (n + 1 < cbufs[buf].size()) {
+                C.prefetch(C.cur_vect_, cbufs[buf][n + 1].first);
+            } else {
+                for (int nbuf = buf + 1; nbuf < S.buf_per_vect_; nbuf++) {
+                    if (cbufs[nbuf].empty()) continue;
+                    C.prefetch(C.cur_vect_, cbufs[nbuf][0].first);
+                    break;
+                }
+            }
+
             if (do_cblock) {
                 if (SigmaData_->cprime != nullptr) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
                 sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock], oei, tei, fci, cblock, sblock, nas,
@@ -404,9 +432,12 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
             else
                 S.symmetrize(1.0, sblock);
         }
-        S.write(ivec, buf);
+        S.write_behind(ivec, buf);
 
     } /* end loop over sigma buffers */
+
+    C.io_wait();
+    S.io_wait();
 }
 
 /*
@@ -530,6 +561,11 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
         S.zero();
         for (cbuf = 0; cbuf < C.buf_per_vect_; cbuf++) {
             C.read(C.cur_vect_, cbuf); /* go ahead and assume it will contrib */
+            /* and read the next one while this one is contracted */
+            if (cbuf + 1 < C.buf_per_vect_)
+                C.prefetch(C.cur_vect_, cbuf + 1);
+            else if (buf + 1 < S.buf_per_vect_)
+                C.prefetch(C.cur_vect_, 0);
             cairr = C.buf2blk_[cbuf];
             cbirr = cairr ^ CalcInfo_->ref_sym;
 
@@ -598,9 +634,12 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
             else
                 S.symmetrize(1.0, sairr);
         }
-        S.write(ivec, buf);
+        S.write_behind(ivec, buf);
 
     } /* end loop over sigma irrep */
+
+    C.io_wait();
+    S.io_wait();
 }
 
 /*
@@ -618,14 +657,16 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
         timer_on("CIWave: s2");
 
         if (fci) {
-            s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+            s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, cnac, nas, nbs, sac, cac, cnas,
+                          Parameters_->nthreads);
         } else {
             if (Parameters_->repl_otf) {
                 s2_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij, SigmaData_->Jridx,
                                    SigmaData_->Jsgn, SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnac, nas,
                                    nbs, sac, cac, cnas, AlphaG_, BetaG_, CalcInfo_, Occs_);
             } else {
-                s2_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+                s2_block_vras(alplist, betlist, cmat, smat, oei, tei, cnac, nas, nbs, sac, cac, cnas,
+                              Parameters_->nthreads);
             }
         }
         timer_off("CIWave: s2");
@@ -643,15 +684,16 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
         if (s1_contrib_[sblock][cblock]) {
             if (fci) {
-                s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs, sbc, cbc, cnbs);
+                s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, cnbc, nas, nbs, sbc, cbc, cnbs,
+                              Parameters_->nthreads);
             } else {
                 if (Parameters_->repl_otf) {
                     s1_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij, SigmaData_->Jridx,
                                        SigmaData_->Jsgn, SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnbc,
                                        nas, nbs, sbc, cbc, cnbs, BetaG_, CalcInfo_, Occs_);
                 } else {
-                    s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs, sbc, cbc,
-                                  cnbs);
+                    s1_block_vras(alplist, betlist, cmat, smat, oei, tei, cnbc, nas, nbs, sbc, cbc, cnbs,
+                                  Parameters_->nthreads);
                 }
             }
         }
@@ -677,13 +719,13 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
                 b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1], SigmaData_->Joij[1], SigmaData_->Jridx[1],
                         SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
                 s3_block_vrotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx, SigmaData_->Jsgn, cmat, smat, tei,
-                               nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                               SigmaData_->V, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
-                               CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                               nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->Sgn,
+                               SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                               CalcInfo_->orbsym + CalcInfo_->num_drc_orbs, Parameters_->nthreads);
             } else {
                 s3_block_v(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-                           SigmaData_->cprime, SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                           SigmaData_->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                           SigmaData_->cprime, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                           CalcInfo_->orbsym + CalcInfo_->num_drc_orbs, Parameters_->nthreads);
             }
         }
 
@@ -699,13 +741,14 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
                 b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1], SigmaData_->Joij[1], SigmaData_->Jridx[1],
                         SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
                 s3_block_vdiag_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx, SigmaData_->Jsgn, cmat, smat,
-                                    tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                                    SigmaData_->V, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R,
-                                    CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                                    tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime,
+                                    SigmaData_->Sgn, SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                                    CalcInfo_->orbsym + CalcInfo_->num_drc_orbs, Parameters_->nthreads);
             } else {
                 s3_block_vdiag(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-                               SigmaData_->cprime, SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                               SigmaData_->R, CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
+                               SigmaData_->cprime, SigmaData_->Sgn, SigmaData_->L, SigmaData_->R,
+                               CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs,
+                               Parameters_->nthreads);
             }
         }
 
@@ -639,7 +639,7 @@ struct sigma_data {
     double **transp_tmp;
     double **cprime;
     double **sprime;
-    double *V, *Sgn;
+    double *Sgn;
     int *L, *R;
     int max_dim;
 };
@@ -57,6 +57,12 @@
 
 #include "corr_grad.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+
 namespace psi {
 namespace dfmp2 {
 
@@ -1011,6 +1017,11 @@ void RDFMP2::form_Bia_transpose() {
     apply_B_transpose(PSIF_DFMP2_AIA, ribasis_->nbf(), Caocc_->colspi()[0], (size_t)Cavir_->colspi()[0]);
 }
 void RDFMP2::form_energy() {
+    if (options_.get_str("DFMP2_ENERGY_ALGORITHM") == "LAPLACE") {
+        form_energy_laplace();
+        return;
+    }
+
     // Energy registers
     double e_ss = 0.0;
     double e_os = 0.0;
@@ -1026,6 +1037,8 @@ void RDFMP2::form_energy() {
     nthread = Process::environment.get_n_threads();
 #endif
 
+    auto t_start = std::chrono::steady_clock::now();
+
     // Memory
     size_t Iab_memory = navir * (size_t)navir;
     size_t Qa_memory = naux * (size_t)navir;
@@ -1033,8 +1046,28 @@ void RDFMP2::form_energy() {
     if (doubles < nthread * Iab_memory) {
         throw PSIEXCEPTION("DFMP2: Insufficient memory for Iab buffers. Reduce OMP Threads or increase memory.");
     }
-    size_t remainder = doubles - nthread * Iab_memory;
-    size_t max_i = remainder / (2L * Qa_memory);
+
+    // Pairs per GEMM: the (ia|jb) tile of one i and max_j j's stays in the L2 cache, and the thread
+    // tiles take at most half of the memory
+    size_t cache_doubles = (1L << 20) / sizeof(double);
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long l2_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (l2_size > 0) cache_doubles = l2_size / sizeof(double);
+#endif
+    size_t max_j = cache_doubles / Iab_memory;
+    max_j = std::min(max_j, doubles / (2L * nthread * Iab_memory));
+    max_j = (max_j > naocc ? naocc : max_j);
+    max_j = (max_j < 1L ? 1L : max_j);
+    size_t remainder = doubles - nthread * max_j * Iab_memory;
+
+    // Occupied blocks: one buffer if all of (ia|Q) fits, otherwise three, so that the next block
+    // is read while the current pair of blocks is contracted
+    size_t max_i;
+    if (remainder >= naocc * Qa_memory) {
+        max_i = naocc;
+    } else {
+        max_i = remainder / (3L * Qa_memory);
+    }
     max_i = (max_i > naocc ? naocc : max_i);
     max_i = (max_i < 1L ? 1L : max_i);
 
@@ -1049,85 +1082,139 @@ void RDFMP2::form_energy() {
         }
     }
     // block_status(i_starts, __FILE__,__LINE__);
+    int nblock = i_starts.size() - 1;
 
-    // Tensor blocks
-    auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
-    auto Bjb = std::make_shared<Matrix>("B(jb|Q)", max_i * (size_t)navir, naux);
-    double** Biap = Bia->pointer();
-    double** Bjbp = Bjb->pointer();
+    // Block pairs, in order. The diagonal pair comes first for each block_i, so every pair brings
+    // in exactly one block that is not already in a buffer
+    std::vector<std::pair<int, int>> block_pairs;
+    for (int block_i = 0; block_i < nblock; block_i++) {
+        block_pairs.emplace_back(block_i, block_i);
+        for (int block_j = 0; block_j < block_i; block_j++) block_pairs.emplace_back(block_i, block_j);
+    }
+
+    // Tensor blocks, allocated when first used
+    int nbuffer = (nblock == 1 ? 1 : 3);
+    std::vector<SharedMatrix> Bia(nbuffer);
 
     std::vector<SharedMatrix> Iab;
     for (int i = 0; i < nthread; i++) {
-        Iab.push_back(std::make_shared<Matrix>("Iab", navir, navir));
+        Iab.push_back(std::make_shared<Matrix>("Iab", navir, max_j * (size_t)navir));
     }
 
     double* eps_aoccp = eps_aocc_->pointer();
     double* eps_avirp = eps_avir_->pointer();
 
+    // Reads one iaQ block into a buffer; runs on the prefetch thread, which is the only user of
+    // psio_ while it is alive
+    double read_time = 0.0;
+    auto read_block = [&](int block, int buffer) {
+        auto t0 = std::chrono::steady_clock::now();
+        size_t start = i_starts[block];
+        size_t n = i_starts[block + 1] - start;
+        psio_address next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (start * navir * naux));
+        psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Bia[buffer]->pointer()[0], sizeof(double) * (n * navir * naux),
+                    next_BIA, &next_BIA);
+        read_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
     // Loop through pairs of blocks
     psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
-    psio_address next_BIA = PSIO_ZERO;
-    for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
-        // Sizing
-        size_t istart = i_starts[block_i];
-        size_t istop = i_starts[block_i + 1];
-        size_t ni = istop - istart;
 
-        // Read iaQ chunk
+    double wait_time = 0.0;
+    std::thread prefetch;
+    int loaded = 0;
+    Bia[0] = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
+    prefetch = std::thread(read_block, 0, 0);
+
+    int ibuf = 0;
+    int jbuf = 0;
+    std::vector<std::tuple<size_t, size_t, size_t>> tasks;
+    for (size_t pair = 0; pair < block_pairs.size(); pair++) {
+        int block_i = block_pairs[pair].first;
+        int block_j = block_pairs[pair].second;
+
+        // Wait for the block this pair brings in
         timer_on("DFMP2 Bia Read");
-        next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (istart * navir * naux));
-        psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Biap[0], sizeof(double) * (ni * navir * naux), next_BIA,
-                    &next_BIA);
+        auto t0 = std::chrono::steady_clock::now();
+        prefetch.join();
+        wait_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
         timer_off("DFMP2 Bia Read");
+        if (block_i == block_j) {
+            ibuf = loaded;
+            jbuf = loaded;
+        } else {
+            jbuf = loaded;
+        }
 
-        for (int block_j = 0; block_j <= block_i; block_j++) {
-            // Sizing
-            size_t jstart = i_starts[block_j];
-            size_t jstop = i_starts[block_j + 1];
-            size_t nj = jstop - jstart;
+        // Start reading the block of the next pair into the buffer this pair does not use
+        if (pair + 1 < block_pairs.size()) {
+            int next_block = (block_pairs[pair + 1].first == block_pairs[pair + 1].second ? block_pairs[pair + 1].first
+                                                                                          : block_pairs[pair + 1].second);
+            loaded = 0;
+            while (loaded == ibuf || loaded == jbuf) loaded++;
+            if (!Bia[loaded]) Bia[loaded] = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
+            prefetch = std::thread(read_block, next_block, loaded);
+        }
 
-            // Read iaQ chunk (if unique)
-            timer_on("DFMP2 Bia Read");
-            if (block_i == block_j) {
-                ::memcpy((void*)Bjbp[0], (void*)Biap[0], sizeof(double) * (ni * navir * naux));
-            } else {
-                next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (jstart * navir * naux));
-                psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Bjbp[0], sizeof(double) * (nj * navir * naux), next_BIA,
-                            &next_BIA);
+        // Sizing
+        size_t istart = i_starts[block_i];
+        size_t istop = i_starts[block_i + 1];
+        size_t jstart = i_starts[block_j];
+        size_t jstop = i_starts[block_j + 1];
+
+        double** Biap = Bia[ibuf]->pointer();
+        double** Bjbp = Bia[jbuf]->pointer();
+
+        // One task is one i against up to max_j j's, j <= i
+        tasks.clear();
+        for (size_t i = istart; i < istop; i++) {
+            size_t jend = (jstop < i + 1 ? jstop : i + 1);
+            for (size_t j = jstart; j < jend; j += max_j) {
+                tasks.emplace_back(i, j, (j + max_j < jend ? max_j : jend - j));
             }
-            timer_off("DFMP2 Bia Read");
+        }
 
 #pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+ : e_ss, e_os)
-            for (long int ij = 0L; ij < ni * nj; ij++) {
-                // Sizing
-                size_t i = ij / nj + istart;
-                size_t j = ij % nj + jstart;
-                if (j > i) continue;
-
-                double perm_factor = (i == j ? 1.0 : 2.0);
+        for (long int task = 0L; task < tasks.size(); task++) {
+            // Sizing
+            size_t i = std::get<0>(tasks[task]);
+            size_t j0 = std::get<1>(tasks[task]);
+            size_t nj = std::get<2>(tasks[task]);
+            size_t ldI = nj * navir;
 
-                // Which thread is this?
-                int thread = 0;
+            // Which thread is this?
+            int thread = 0;
 #ifdef _OPENMP
-                thread = omp_get_thread_num();
+            thread = omp_get_thread_num();
 #endif
-                double** Iabp = Iab[thread]->pointer();
+            double* Iabp = Iab[thread]->pointer()[0];
 
-                // Form the integral block (ia|jb) = (ia|Q)(Q|jb)
-                C_DGEMM('N', 'T', navir, navir, naux, 1.0, Biap[(i - istart) * navir], naux, Bjbp[(j - jstart) * navir],
-                        naux, 0.0, Iabp[0], navir);
+            // Form the integral tile (ia|jb) = (ia|Q)(Q|jb) for all j of the task
+            C_DGEMM('N', 'T', navir, nj * navir, naux, 1.0, Biap[(i - istart) * navir], naux,
+                    Bjbp[(j0 - jstart) * navir], naux, 0.0, Iabp, ldI);
+
+            // Add the MP2 energy contributions
+            for (size_t jt = 0; jt < nj; jt++) {
+                size_t j = j0 + jt;
+                double perm_factor = (i == j ? 1.0 : 2.0);
+                double e_ij = eps_aoccp[i] + eps_aoccp[j];
+                double* Ijp = Iabp + jt * navir;
 
-                // Add the MP2 energy contributions
+                double os = 0.0;
+                double ex = 0.0;
                 for (int a = 0; a < navir; a++) {
+                    const double* iap = Ijp + a * ldI;
+                    const double* ibp = Ijp + a;
+                    double e_a = eps_avirp[a] - e_ij;
+#pragma omp simd reduction(+ : os, ex)
                     for (int b = 0; b < navir; b++) {
-                        double iajb = Iabp[a][b];
-                        double ibja = Iabp[b][a];
-                        double denom = -perm_factor / (eps_avirp[a] + eps_avirp[b] - eps_aoccp[i] - eps_aoccp[j]);
-
-                        e_ss += (iajb * iajb - iajb * ibja) * denom;
-                        e_os += (iajb * iajb) * denom;
+                        double t_ab = iap[b] / (e_a + eps_avirp[b]);
+                        os += iap[b] * t_ab;
+                        ex += ibp[b * ldI] * t_ab;
                     }
                 }
+                e_os += -perm_factor * os;
+                e_ss += -perm_factor * (os - ex);
             }
         }
     }
@@ -1135,7 +1222,283 @@ void RDFMP2::form_energy() {
 
     variables_["MP2 SAME-SPIN CORRELATION ENERGY"] = e_ss;
     variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = e_os;
+
+    if (print_ >= 1) {
+        double total_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+        size_t npair = naocc * (naocc + 1L) / 2L;
+        outfile->Printf("\t --------------------------------------------------------\n");
+        outfile->Printf("\t Occupied blocks = %5d, Block size = %5zu, Pairs per GEMM = %5zu\n", nblock, max_i,
+                        max_j);
+        outfile->Printf("\t Pairs per second = %11.3E, I/O wait fraction = %5.3f\n",
+                        (total_time > 0.0 ? npair / total_time : 0.0), (total_time > 0.0 ? wait_time / total_time : 0.0));
+        outfile->Printf("\t Bia read time = %10.3f [s], of which waited = %10.3f [s]\n", read_time, wait_time);
+        outfile->Printf("\t --------------------------------------------------------\n\n");
+    }
+}
+// Rotation M = C^T S L from the canonical orbitals C onto the Cholesky vectors L of the pseudo-density
+// X = C diag(tau) C^T; M M^T = diag(tau), and the Cholesky vectors are localized
+static SharedMatrix laplace_pseudo_orbitals(SharedMatrix C, const double* tau, SharedMatrix S, double cutoff) {
+    int nso = C->rowspi()[0];
+    int n = C->colspi()[0];
+
+    auto Ct = C->clone();
+    double** Cp = C->pointer();
+    double** Ctp = Ct->pointer();
+    for (int i = 0; i < n; i++) C_DSCAL(nso, tau[i], &Ctp[0][i], n);
+
+    auto X = std::make_shared<Matrix>("Pseudo-density", nso, nso);
+    double** Xp = X->pointer();
+    C_DGEMM('N', 'T', nso, nso, n, 1.0, Ctp[0], n, Cp[0], n, 0.0, Xp[0], nso);
+
+    auto L = X->partial_cholesky_factorize(cutoff);
+    int nL = L->colspi()[0];
+    auto M = std::make_shared<Matrix>("Pseudo-orbital rotation", n, nL);
+    if (!nL) return M;
+
+    auto SL = std::make_shared<Matrix>("SL", nso, nL);
+    double** Sp = S->pointer();
+    double** Lp = L->pointer();
+    double** SLp = SL->pointer();
+    double** Mp = M->pointer();
+    C_DGEMM('N', 'N', nso, nL, nso, 1.0, Sp[0], nso, Lp[0], nL, 0.0, SLp[0], nL);
+    C_DGEMM('T', 'N', n, nL, nso, 1.0, Cp[0], n, SLp[0], nL, 0.0, Mp[0], nL);
+    return M;
 }
+
+void RDFMP2::form_energy_laplace() {
+    // Energy registers
+    double e_os = 0.0;
+    double e_x = 0.0;
+
+    // Sizing
+    int naux = ribasis_->nbf();
+    int naocc = Caocc_->colspi()[0];
+    int navir = Cavir_->colspi()[0];
+    int nso = Caocc_->rowspi()[0];
+
+    // Thread considerations
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = Process::environment.get_n_threads();
+#endif
+
+    auto t_start = std::chrono::steady_clock::now();
+
+    // 1 / (e_a + e_b - e_i - e_j) = \sum_w tau_wi tau_wj tau_wa tau_wb
+    auto denom = std::make_shared<LaplaceDenominator>(eps_aocc_, eps_avir_, options_.get_double("DFMP2_LAPLACE_DELTA"));
+    int nw = denom->nvector();
+    double** tauop = denom->denominator_occ()->pointer();
+    double** tauvp = denom->denominator_vir()->pointer();
+    double cutoff = options_.get_double("DFMP2_LAPLACE_CUTOFF");
+
+    auto S = MintsHelper(basisset_, options_).ao_overlap();
+
+    // Memory: three (ia|Q) blocks, the Z_PQ intermediate, the exchange buffers and the pair bounds
+    size_t Qa_memory = naux * (size_t)navir;
+    size_t doubles = ((size_t)(options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    size_t fixed = naux * (size_t)naux + nthread * (size_t)navir * navir + naocc * (size_t)(navir + naocc) +
+                   4L * nso * nso;
+    if (doubles < fixed + 3L * Qa_memory) {
+        throw PSIEXCEPTION("DFMP2: Insufficient memory for the Laplace energy. Reduce OMP Threads or increase memory.");
+    }
+    size_t max_i = (doubles - fixed) / (3L * Qa_memory);
+    max_i = (max_i > naocc ? naocc : max_i);
+    max_i = (max_i < 1L ? 1L : max_i);
+
+    // Blocks of canonical occupieds; the pseudo-occupieds of each point are blocked the same way
+    auto blocks = [max_i](size_t n) {
+        std::vector<size_t> starts;
+        starts.push_back(0L);
+        for (size_t i = 0; i < n; i += max_i) starts.push_back(i + max_i >= n ? n : i + max_i);
+        return starts;
+    };
+    std::vector<size_t> i_starts = blocks(naocc);
+
+    // Tensor blocks
+    auto Bia = std::make_shared<Matrix>("B(ia|Q)", max_i * (size_t)navir, naux);
+    auto Bpa = std::make_shared<Matrix>("B(pa|Q)", max_i * (size_t)navir, naux);
+    auto Bpb = std::make_shared<Matrix>("B(pb|Q)", max_i * (size_t)navir, naux);
+    double* Biap = Bia->pointer()[0];
+    double* Bpap = Bpa->pointer()[0];
+    double* Bpbp = Bpb->pointer()[0];
+
+    auto Z = std::make_shared<Matrix>("Z", naux, naux);
+    double** Zp = Z->pointer();
+
+    std::vector<SharedMatrix> Iab;
+    for (int i = 0; i < nthread; i++) {
+        Iab.push_back(std::make_shared<Matrix>("Iab", navir, navir));
+    }
+
+    // Statistics
+    size_t npair_total = 0L;
+    size_t npair_kept = 0L;
+    double skipped_bound = 0.0;
+    double flops = 0.0;
+
+    if (print_ >= 1) {
+        outfile->Printf("\t --------------------------------------------------------\n");
+        outfile->Printf("\t Laplace DF-MP2: %3d points, pair cutoff = %9.2E\n", nw, cutoff);
+        if (print_ > 1) outfile->Printf("\t %5s %9s %9s %12s %12s\n", "Point", "Occupied", "Virtual", "Pairs", "Kept");
+    }
+
+    psio_->open(PSIF_DFMP2_AIA, PSIO_OPEN_OLD);
+    for (int w = 0; w < nw; w++) {
+        // Localized pseudo-orbitals of this point
+        auto Mo = laplace_pseudo_orbitals(Caocc_, tauop[w], S, cutoff);
+        auto Mv = laplace_pseudo_orbitals(Cavir_, tauvp[w], S, cutoff);
+        int no = Mo->colspi()[0];
+        int nv = Mv->colspi()[0];
+        if (!no || !nv) continue;
+        double** Mop = Mo->pointer();
+        double** Mvp = Mv->pointer();
+
+        std::vector<size_t> p_starts = blocks(no);
+        auto Sc = std::make_shared<Matrix>("||(pb|Q)||", no, nv);
+        double** Scp = Sc->pointer();
+
+        // => (pb|Q) = M_ip M_ab (ia|Q), and Z_PQ = (pb|P)(pb|Q) <= //
+
+        Z->zero();
+        psio_->open(PSIF_DFMP2_QIA, PSIO_OPEN_NEW);
+        for (int block_p = 0; block_p < p_starts.size() - 1; block_p++) {
+            size_t pstart = p_starts[block_p];
+            size_t np = p_starts[block_p + 1] - pstart;
+
+            ::memset((void*)Bpap, '\0', sizeof(double) * np * Qa_memory);
+            for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
+                size_t istart = i_starts[block_i];
+                size_t ni = i_starts[block_i + 1] - istart;
+
+                timer_on("DFMP2 Bia Read");
+                psio_address next_BIA = psio_get_address(PSIO_ZERO, sizeof(double) * (istart * navir * naux));
+                psio_->read(PSIF_DFMP2_AIA, "B(ia|Q)", (char*)Biap, sizeof(double) * (ni * navir * naux), next_BIA,
+                            &next_BIA);
+                timer_off("DFMP2 Bia Read");
+
+                C_DGEMM('T', 'N', np, Qa_memory, ni, 1.0, &Mop[istart][pstart], no, Biap, Qa_memory, 1.0, Bpap,
+                        Qa_memory);
+            }
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+            for (long int p = 0L; p < np; p++) {
+                double* Bp = Bpbp + p * nv * naux;
+                C_DGEMM('T', 'N', nv, naux, navir, 1.0, Mvp[0], nv, Bpap + p * Qa_memory, naux, 0.0, Bp, naux);
+                for (int b = 0; b < nv; b++) {
+                    Scp[pstart + p][b] = sqrt(C_DDOT(naux, Bp + b * naux, 1, Bp + b * naux, 1));
+                }
+            }
+
+            C_DGEMM('T', 'N', naux, naux, np * nv, 1.0, Bpbp, naux, Bpbp, naux, 1.0, Zp[0], naux);
+
+            psio_address next_PBQ = psio_get_address(PSIO_ZERO, sizeof(double) * (pstart * nv * naux));
+            psio_->write(PSIF_DFMP2_QIA, "B(pb|Q)", (char*)Bpbp, sizeof(double) * (np * nv * naux), next_PBQ,
+                         &next_PBQ);
+        }
+        flops += 2.0 * naocc * (double)no * Qa_memory + 2.0 * no * (double)nv * Qa_memory +
+                 2.0 * no * (double)nv * naux * naux;
+
+        // Direct term: \sum_ijab (ia|jb)^2 tau = Z_PQ Z_PQ
+        e_os -= C_DDOT(naux * (size_t)naux, Zp[0], 1, Zp[0], 1);
+
+        // => Exchange term \sum_ijab (ia|jb)(ib|ja) tau over the pseudo-orbital pairs <= //
+
+        // |\sum_ab (pa|qb)(pb|qa)| <= (\sum_a s_pa s_qa)^2 with s_pa = ||(pa|Q)||
+        auto G = std::make_shared<Matrix>("Pair bounds", no, no);
+        double** Gp = G->pointer();
+        C_DGEMM('N', 'T', no, no, nv, 1.0, Scp[0], nv, Scp[0], nv, 0.0, Gp[0], no);
+
+        size_t npair_w = 0L;
+        size_t nkept_w = 0L;
+        std::vector<std::pair<size_t, size_t>> pairs;
+        for (int block_p = 0; block_p < p_starts.size() - 1; block_p++) {
+            size_t pstart = p_starts[block_p];
+            size_t pstop = p_starts[block_p + 1];
+            for (int block_q = 0; block_q <= block_p; block_q++) {
+                size_t qstart = p_starts[block_q];
+                size_t qstop = p_starts[block_q + 1];
+
+                pairs.clear();
+                for (size_t p = pstart; p < pstop; p++) {
+                    for (size_t q = qstart; q < qstop && q <= p; q++) {
+                        double perm_factor = (p == q ? 1.0 : 2.0);
+                        double bound = perm_factor * Gp[p][q] * Gp[p][q];
+                        npair_w++;
+                        if (bound < cutoff) {
+                            skipped_bound += bound;
+                        } else {
+                            pairs.emplace_back(p, q);
+                        }
+                    }
+                }
+                if (pairs.empty()) continue;
+                nkept_w += pairs.size();
+
+                timer_on("DFMP2 Bia Read");
+                psio_address next_PBQ = psio_get_address(PSIO_ZERO, sizeof(double) * (pstart * nv * naux));
+                psio_->read(PSIF_DFMP2_QIA, "B(pb|Q)", (char*)Bpbp, sizeof(double) * ((pstop - pstart) * nv * naux),
+                            next_PBQ, &next_PBQ);
+                double* Bqbp = Bpbp;
+                if (block_q != block_p) {
+                    next_PBQ = psio_get_address(PSIO_ZERO, sizeof(double) * (qstart * nv * naux));
+                    psio_->read(PSIF_DFMP2_QIA, "B(pb|Q)", (char*)Bpap, sizeof(double) * ((qstop - qstart) * nv * naux),
+                                next_PBQ, &next_PBQ);
+                    Bqbp = Bpap;
+                }
+                timer_off("DFMP2 Bia Read");
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+ : e_x)
+                for (long int pq = 0L; pq < pairs.size(); pq++) {
+                    size_t p = pairs[pq].first;
+                    size_t q = pairs[pq].second;
+                    double perm_factor = (p == q ? 1.0 : 2.0);
+
+                    // Which thread is this?
+                    int thread = 0;
+#ifdef _OPENMP
+                    thread = omp_get_thread_num();
+#endif
+                    double* Kp = Iab[thread]->pointer()[0];
+
+                    // (pa|qb) = (pa|Q)(Q|qb)
+                    C_DGEMM('N', 'T', nv, nv, naux, 1.0, Bpbp + (p - pstart) * nv * naux, naux,
+                            Bqbp + (q - qstart) * nv * naux, naux, 0.0, Kp, nv);
+
+                    double ex = 0.0;
+                    for (int a = 0; a < nv; a++) {
+                        const double* Kap = Kp + a * nv;
+                        const double* Kbp = Kp + a;
+#pragma omp simd reduction(+ : ex)
+                        for (int b = 0; b < nv; b++) ex += Kap[b] * Kbp[b * nv];
+                    }
+                    e_x += perm_factor * ex;
+                }
+            }
+        }
+        psio_->close(PSIF_DFMP2_QIA, 0);
+
+        flops += 2.0 * nkept_w * nv * (double)nv * naux;
+        npair_total += npair_w;
+        npair_kept += nkept_w;
+        if (print_ > 1) outfile->Printf("\t %5d %9d %9d %12zu %12zu\n", w + 1, no, nv, npair_w, nkept_w);
+    }
+    psio_->close(PSIF_DFMP2_AIA, 0);
+
+    variables_["MP2 SAME-SPIN CORRELATION ENERGY"] = e_os + e_x;
+    variables_["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = e_os;
+
+    if (print_ >= 1) {
+        double total_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+        // The canonical kernel does one navir x navir x naux GEMM per i >= j pair
+        double canonical_flops = naocc * (naocc + 1.0) * navir * (double)navir * naux;
+        outfile->Printf("\t Exchange pairs kept = %12zu of %12zu, Screened bound = %9.2E [Eh]\n", npair_kept,
+                        npair_total, skipped_bound);
+        outfile->Printf("\t Laplace GFLOP = %11.3E, Canonical GFLOP = %11.3E, Time = %10.3f [s]\n", flops / 1.0E9,
+                        canonical_flops / 1.0E9, total_time);
+        outfile->Printf("\t --------------------------------------------------------\n\n");
+    }
+}
+
 void RDFMP2::form_Pab() {
     // Energy registers
     double e_ss = 0.0;
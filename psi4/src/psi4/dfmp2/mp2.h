@@ -147,6 +147,8 @@ class RDFMP2 : public DFMP2 {
     void form_Bia_transpose() override;
     // Form the energy contributions
     void form_energy() override;
+    // Form the energy contributions from a Laplace quadrature of the denominator
+    void form_energy_laplace();
     // Form the energy contributions and gradients
     void form_Pab() override;
     // Form the energy contributions and gradients
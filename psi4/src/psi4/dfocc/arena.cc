@@ -0,0 +1,168 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psi4-dec.h"
+#include "arena.h"
+
+namespace psi {
+namespace dfoccwave {
+
+TensorArena::TensorArena()
+    : limit_(0), in_use_(0), cached_(0), peak_(0), iter_peak_(0), nalloc_(0), nreused_(0) {}
+
+TensorArena::~TensorArena() {
+    trim();
+    for (auto &blk : in_use_blocks_) delete[] blk.first;
+}
+
+TensorArena &TensorArena::shared() {
+    // Never destroyed: tensors held by a wavefunction may be released after static destructors run
+    static TensorArena *arena = new TensorArena();
+    return *arena;
+}
+
+// Give kept blocks back, largest first, until needed more bytes fit under the limit. Without a
+// limit the kept blocks are not allowed to take the arena above its peak so far.
+void TensorArena::evict(size_t needed) {
+    size_t cap = limit_ ? limit_ : peak_;
+    while (!free_blocks_.empty() && in_use_ + cached_ + needed > cap) {
+        auto last = std::prev(free_blocks_.end());
+        cached_ -= last->first * sizeof(double);
+        delete[] last->second;
+        free_blocks_.erase(last);
+    }
+}
+
+double **TensorArena::block_matrix(size_t n, size_t m) {
+    if (!n || !m) return nullptr;
+    size_t size = n * m;
+    double *B = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        nalloc_++;
+        // Take the most recently released block of the smallest fitting size, at most 1/8 larger
+        auto it = free_blocks_.lower_bound(size);
+        if (it != free_blocks_.end() && it->first <= size + size / 8) {
+            it = std::prev(free_blocks_.upper_bound(it->first));
+            B = it->second;
+            size = it->first;
+            cached_ -= size * sizeof(double);
+            free_blocks_.erase(it);
+            in_use_blocks_[B] = size;
+            nreused_++;
+        } else {
+            evict(size * sizeof(double));
+        }
+        in_use_ += size * sizeof(double);
+        peak_ = std::max(peak_, in_use_);
+        iter_peak_ = std::max(iter_peak_, in_use_);
+    }
+    if (B == nullptr) {
+        B = new double[size];
+        std::lock_guard<std::mutex> guard(lock_);
+        in_use_blocks_[B] = size;
+    }
+    memset(B, 0, size * sizeof(double));
+
+    auto A = new double *[n];
+    for (size_t i = 0; i < n; i++) A[i] = &(B[i * m]);
+    return A;
+}
+
+void TensorArena::free_block(double **A) {
+    if (A == nullptr) return;
+    double *B = A[0];
+    delete[] A;
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = in_use_blocks_.find(B);
+    if (it == in_use_blocks_.end()) {
+        delete[] B;
+        return;
+    }
+    size_t size = it->second;
+    in_use_blocks_.erase(it);
+    in_use_ -= size * sizeof(double);
+    free_blocks_.emplace(size, B);
+    cached_ += size * sizeof(double);
+    evict(0);
+}
+
+void TensorArena::reset(size_t limit) {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &blk : free_blocks_) delete[] blk.second;
+    free_blocks_.clear();
+    cached_ = 0;
+    limit_ = limit;
+    peak_ = in_use_;
+    iter_peak_ = in_use_;
+    nalloc_ = 0;
+    nreused_ = 0;
+    iter_peaks_.clear();
+}
+
+void TensorArena::begin_iteration() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (nalloc_) iter_peaks_.push_back(iter_peak_);
+    iter_peak_ = in_use_;
+}
+
+void TensorArena::trim() {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &blk : free_blocks_) delete[] blk.second;
+    free_blocks_.clear();
+    cached_ = 0;
+}
+
+void TensorArena::print_summary(int print) {
+    const double MB = 1024.0 * 1024.0;
+    // close the last iteration
+    begin_iteration();
+
+    outfile->Printf("\n\tTensor memory peak (MB)            : %12.2lf\n", peak_ / MB);
+    if (!iter_peaks_.empty()) {
+        size_t largest = *std::max_element(iter_peaks_.begin(), iter_peaks_.end());
+        outfile->Printf("\tTensor memory peak, 1st iter. (MB) : %12.2lf\n", iter_peaks_[0] / MB);
+        outfile->Printf("\tTensor memory peak, any iter. (MB) : %12.2lf\n", largest / MB);
+        if (print > 1) {
+            for (size_t i = 0; i < iter_peaks_.size(); i++)
+                outfile->Printf("\t  Iteration %3zu peak (MB)          : %12.2lf\n", i + 1, iter_peaks_[i] / MB);
+        }
+    }
+    outfile->Printf("\tTensor blocks reused               : %12zu of %zu\n", nreused_, nalloc_);
+    if (limit_ && peak_ > limit_)
+        outfile->Printf("\tWarning: tensors peaked above the memory limit of %.2lf MB.\n", limit_ / MB);
+}
+
+}  // namespace dfoccwave
+}  // namespace psi
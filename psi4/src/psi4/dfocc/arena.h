@@ -0,0 +1,93 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _dfocc_arena_h_
+#define _dfocc_arena_h_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace psi {
+namespace dfoccwave {
+
+// Memory for the Tensor2d blocks of a computation. Blocks that are released are kept and handed out
+// again, most recently released first, to the next tensor of the same size, so the temporaries that
+// every CC/OO iteration builds and drops do not go back to the OS and fault their pages in again.
+// The kept blocks are given up whenever in-use plus kept memory would go over the memory limit.
+class TensorArena {
+   private:
+    std::mutex lock_;
+    // element count of every block handed out
+    std::unordered_map<double *, size_t> in_use_blocks_;
+    // released blocks by element count; equal sizes are reused last in, first out
+    std::multimap<size_t, double *> free_blocks_;
+
+    size_t limit_;   // bytes; 0 means no limit
+    size_t in_use_;  // bytes
+    size_t cached_;  // bytes
+    size_t peak_;
+    size_t iter_peak_;
+    size_t nalloc_;
+    size_t nreused_;
+    std::vector<size_t> iter_peaks_;
+
+    void evict(size_t needed);
+
+   public:
+    TensorArena();
+    ~TensorArena();
+
+    // The arena Tensor2d allocates from
+    static TensorArena &shared();
+
+    // Zeroed n x m block with row pointers, as block_matrix()
+    double **block_matrix(size_t n, size_t m);
+    void free_block(double **A);
+
+    // Start a computation: drop the kept blocks and statistics, and use limit bytes at most
+    void reset(size_t limit);
+    // Mark the start of an iteration; the peak of the previous one is recorded
+    void begin_iteration();
+    // Give all kept blocks back
+    void trim();
+
+    size_t peak() const { return peak_; }
+    size_t in_use() const { return in_use_; }
+    size_t cached() const { return cached_; }
+    const std::vector<size_t> &iteration_peaks() const { return iter_peaks_; }
+
+    void print_summary(int print);
+};
+
+}  // namespace dfoccwave
+}  // namespace psi
+
+#endif  // _dfocc_arena_h_
@@ -30,6 +30,7 @@
 #include "defines.h"
 #include "psi4/libdiis/diismanager.h"
 #include "dfocc.h"
+#include "arena.h"
 #include "psi4/libmints/matrix.h"
 
 #include <cmath>
@@ -69,6 +70,7 @@ void DFOCC::ccd_iterations() {
     do {
         // iterate
         itr_occ++;
+        TensorArena::shared().begin_iteration();
 
         // 3-index intermediates
         timer_on("CCSD 3-index intr");
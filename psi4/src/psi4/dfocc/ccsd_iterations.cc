@@ -29,6 +29,7 @@
 #include "psi4/libqt/qt.h"
 #include "defines.h"
 #include "dfocc.h"
+#include "arena.h"
 #include "psi4/libdiis/diismanager.h"
 #include "psi4/libmints/matrix.h"
 
@@ -74,6 +75,7 @@ void DFOCC::ccsd_iterations() {
     do {
         // iterate
         itr_occ++;
+        TensorArena::shared().begin_iteration();
 
         // 3-index intermediates
         timer_on("CCSD 3-index intr");
@@ -26,7 +26,10 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <climits>
 #include <ctime>
+#include <thread>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -835,6 +838,367 @@ void DFOCC::ccsd_canonic_triples_disk() {
 
 }  // end ccsd_canonic_triples_disk
 
+//======================================================================
+//       (T): stream
+//======================================================================
+// (ia|bc) is assembled from Q-blocks of B(Q|AB) read from disk, for a batch of i at a time, and
+// written to PSIF_DFOCC_IABC; the ijk loop then reads J[k] one step ahead of the current triple.
+// Only a few V^3 blocks of (ia|bc) are ever in core, and the Q-blocks and J[k] are read by a helper
+// thread while the GEMMs of the previous step run.
+void DFOCC::ccsd_canonic_triples_stream() {
+    // defs
+    SharedTensor2d K, M, I, J, T, W, V, J1, J2, J2buf, J3, Ji, Jt, Bi, Ktail, Knext;
+    SharedTensor2d Kfull[2];
+    long int Nijk;
+
+    // Find number of unique ijk combinations (i>=j>=k)
+    Nijk = naoccA * (naoccA + 1) * (naoccA + 2) / 6;
+    outfile->Printf("\tNumber of ijk combinations: %i \n", Nijk);
+
+    // Memory: 2*O^2V^2 + 4*V^3 + O^3V + NOV + a window of J[k] and Q-blocks of B(Q|AB)
+
+    // Read t2 amps
+    t2 = SharedTensor2d(new Tensor2d("T2 (IA|JB)", naoccA, navirA, naoccA, navirA));
+    t2->read_symm(psio_, PSIF_DFOCC_AMPS);
+    T = SharedTensor2d(new Tensor2d("T2 <IJ|AB>", naoccA, naoccA, navirA, navirA));
+    T->sort(1324, t2, 1.0, 0.0);
+    t2.reset();
+
+    // Form (ij|ka)
+    M = SharedTensor2d(new Tensor2d("DF_BASIS_CC B (Q|IA)", nQ, naoccA, navirA));
+    M->read(psio_, PSIF_DFOCC_INTS);
+    K = SharedTensor2d(new Tensor2d("DF_BASIS_CC B (Q|IJ)", nQ, naoccA, naoccA));
+    K->read(psio_, PSIF_DFOCC_INTS);
+    J = SharedTensor2d(new Tensor2d("DF_BASIS_CC MO Ints (IJ|KA)", naoccA, naoccA, naoccA, navirA));
+    J->gemm(true, false, K, M, 1.0, 0.0);
+    K.reset();
+    I = SharedTensor2d(new Tensor2d("DF_BASIS_CC MO Ints <IJ|KA>", naoccA, naoccA, naoccA, navirA));
+    I->sort(1324, J, 1.0, 0.0);
+    J.reset();
+
+    // Form (ia|jb)
+    J = SharedTensor2d(new Tensor2d("DF_BASIS_CC MO Ints (IA|JB)", naoccA, navirA, naoccA, navirA));
+    J->gemm(true, false, M, M, 1.0, 0.0);
+
+    // B[i](Q,a), i-major, so that a Q-block of B[i] is contiguous
+    Bi = SharedTensor2d(new Tensor2d("DF_BASIS_CC B[I] (Q|A)", naoccA * nQ, navirA));
+#pragma omp parallel for
+    for (long int i = 0; i < naoccA; ++i) {
+        for (long int Q = 0; Q < nQ; ++Q) {
+            for (long int a = 0; a < navirA; ++a) {
+                Bi->set(i * nQ + Q, a, M->get(Q, ia_idxAA->get(i, a)));
+            }
+        }
+    }
+    M.reset();
+
+    // Split what is left of the memory between Q-blocks of B(Q|AB) and a window of J[k]
+    long int o = naoccA;
+    long int v = navirA;
+    long int v3 = v * v * v;
+    long int vtri = v * ntri_abAA;
+    long int fixed = 2 * o * o * v * v + o * o * o * v + o * nQ * v + 4 * v3 + vtri;
+    long int avail = (long int)(memory / sizeof(double)) - fixed;
+    long int nblock_q;
+    if ((long int)nQ * ntri_abAA <= avail / 2) {
+        nblock_q = nQ;
+    } else {
+        // two full blocks in flight and a shorter last one
+        nblock_q = avail / 2 / 3 / ntri_abAA;
+        nblock_q = std::min(std::max(nblock_q, 1L), (long int)nQ);
+    }
+    long int nblocks = (nQ + nblock_q - 1) / nblock_q;
+    long int kmem = (nblocks == 1 ? 1 : 3) * nblock_q * ntri_abAA;
+    long int nwin = (avail - kmem) / (v3 + vtri);
+    nwin = std::min(std::max(nwin, 1L), o);
+    nwin = std::min(nwin, std::max(1L, (long int)INT_MAX / vtri - 1));
+    outfile->Printf("\tQ-blocks of B(Q|AB)                 : %6li (%li per block)\n", nblocks, nblock_q);
+    outfile->Printf("\tJ[k] formed per pass over B(Q|AB)   : %6li\n", nwin);
+
+    // B(Q|AB) is streamed in Q-blocks. Each pass over it forms J for a set of occupied indices, and
+    // the block after the current one (block 0 after the last, for the next pass) is read ahead on a
+    // second thread. A B(Q|AB) that fits in one block is read once and kept.
+    std::shared_ptr<PSIO> psio = psio_;
+    long int ntri = ntri_abAA;
+    long int nfull_read = 0;
+    std::thread reader;
+    auto start_read = [&](long int qb) {
+        long int q0 = qb * nblock_q;
+        long int nq = std::min(nblock_q, nQ - q0);
+        SharedTensor2d buf;
+        if (nq < nblock_q) {
+            if (!Ktail) Ktail = SharedTensor2d(new Tensor2d("DF_BASIS_CC B (Q|AB)", nq, ntri_abAA));
+            buf = Ktail;
+        } else {
+            // full blocks alternate between two buffers, so the one being read is never the one in use
+            long int slot = nfull_read++ % 2;
+            if (!Kfull[slot]) Kfull[slot] = SharedTensor2d(new Tensor2d("DF_BASIS_CC B (Q|AB)", nblock_q, ntri_abAA));
+            buf = Kfull[slot];
+        }
+        Knext = buf;
+        reader = std::thread([buf, psio, q0, ntri]() {
+            psio_address addr = psio_get_address(PSIO_ZERO, (size_t)q0 * ntri * sizeof(double));
+            buf->read(psio, PSIF_DFOCC_INTS, addr, &addr);
+        });
+    };
+    auto next_block = [&](long int qb) -> SharedTensor2d {
+        if (nblocks == 1) return Kfull[0];
+        reader.join();
+        SharedTensor2d Kcur = Knext;
+        start_read((qb + 1) % nblocks);
+        return Kcur;
+    };
+    start_read(0);
+    if (nblocks == 1) reader.join();
+
+    // J[p](a,bc) = \sum(Q) B[p](Q,a) * B(Q,bc) for the occupied p of occ, in one pass over B(Q|AB)
+    Jt = SharedTensor2d(new Tensor2d("J[I] <A|B>=C batch", (nwin + 1) * navirA, ntri_abAA));
+    Ji = SharedTensor2d(new Tensor2d("J[I] <A|B>=C", navirA, ntri_abAA));
+    auto form_J = [&](const std::vector<long int> &occ, const std::vector<SharedTensor2d> &out) {
+        long int nrow = occ.size();
+        for (long int qb = 0; qb < nblocks; ++qb) {
+            SharedTensor2d Kcur = next_block(qb);
+            long int q0 = qb * nblock_q;
+            long int nq = Kcur->dim1();
+            double beta = (qb == 0) ? 0.0 : 1.0;
+            for (long int r = 0; r < nrow; ++r) {
+                Jt->contract(true, false, navirA, ntri_abAA, nq, Bi, Kcur, (occ[r] * nQ + q0) * navirA, 0,
+                             r * navirA * ntri_abAA, 1.0, beta);
+            }
+        }
+        for (long int r = 0; r < nrow; ++r) {
+            Ji->copy(Jt, r * navirA * ntri_abAA);
+            out[r]->expand23(navirA, navirA, navirA, Ji);
+        }
+    };
+
+    // malloc W[ijk](abc)
+    W = SharedTensor2d(new Tensor2d("W[IJK] <AB|C>", navirA * navirA, navirA));
+    V = SharedTensor2d(new Tensor2d("V[IJK] <BA|C>", navirA * navirA, navirA));
+    J1 = SharedTensor2d(new Tensor2d("J[I] (A|BC)", navirA * navirA, navirA));
+    J2buf = SharedTensor2d(new Tensor2d("J[J] (A|BC)", navirA * navirA, navirA));
+    std::vector<SharedTensor2d> Jwin(nwin);
+    for (long int w = 0; w < nwin; ++w) Jwin[w] = SharedTensor2d(new Tensor2d("J[K] (A|BC)", navirA * navirA, navirA));
+
+    // main loop
+    E_t = 0.0;
+    double sum = 0.0;
+    for (long int i = 0; i < naoccA; ++i) {
+        double Di = FockA->get(i + nfrzc, i + nfrzc);
+
+        // Form J[i](a,bc)
+        form_J({i}, {J1});
+
+        for (long int j = 0; j <= i; ++j) {
+            double Dij = Di + FockA->get(j + nfrzc, j + nfrzc);
+            J2 = (j == i) ? J1 : J2buf;
+
+            // J[k] for a window of k; J[j] is formed with the first one
+            for (long int k0 = 0; k0 <= j; k0 += nwin) {
+                long int k1 = std::min(j + 1, k0 + nwin);
+                std::vector<long int> occ;
+                std::vector<SharedTensor2d> out;
+                if (k0 == 0 && j != i) {
+                    occ.push_back(j);
+                    out.push_back(J2buf);
+                }
+                for (long int k = k0; k < std::min(k1, j); ++k) {
+                    occ.push_back(k);
+                    out.push_back(Jwin[k - k0]);
+                }
+                if (!occ.empty()) form_J(occ, out);
+
+                for (long int k = k0; k < k1; ++k) {
+                    J3 = (k == j) ? J2 : Jwin[k - k0];
+
+                    // W[ijk](ab,c) = \sum(e) t_jk^ec (ia|be) (1+)
+                    // W[ijk](ab,c) = \sum(e) J[i](ab,e) T[jk](ec)
+                    W->contract(false, false, navirA * navirA, navirA, navirA, J1, T, 0,
+                                (j * naoccA * navirA * navirA) + (k * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](ab,c) -= \sum(m) t_im^ab <jk|mc> (1-)
+                    // W[ijk](ab,c) -= \sum(m) T[i](m,ab) I[jk](mc)
+                    W->contract(true, false, navirA * navirA, navirA, naoccA, T, I, i * naoccA * navirA * navirA,
+                                (j * naoccA * naoccA * navirA) + (k * naoccA * navirA), -1.0, 1.0);
+
+                    // W[ijk](ac,b) = \sum(e) t_kj^eb (ia|ce) (2+)
+                    // W[ijk](ac,b) = \sum(e) J[i](ac,e) T[kj](eb)
+                    V->contract(false, false, navirA * navirA, navirA, navirA, J1, T, 0,
+                                (k * naoccA * navirA * navirA) + (j * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](ac,b) -= \sum(m) t_im^ac <kj|mb> (2-)
+                    // W[ijk](ac,b) -= \sum(m) T[i](m,ac) I[kj](mb)
+                    V->contract(true, false, navirA * navirA, navirA, naoccA, T, I, i * naoccA * navirA * navirA,
+                                (k * naoccA * naoccA * navirA) + (j * naoccA * navirA), -1.0, 1.0);
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        for (long int b = 0; b < navirA; ++b) {
+                            W->axpy((size_t)navirA, a * navirA * navirA + b, navirA, V,
+                                    a * navirA * navirA + b * navirA, 1, 1.0);
+                        }
+                    }
+
+                    // W[ijk](ba,c) = \sum(e) t_ik^ec (jb|ae) (3+)
+                    // W[ijk](ba,c) = \sum(e) J[j](ba,e) T[ik](ec)
+                    V->contract(false, false, navirA * navirA, navirA, navirA, J2, T, 0,
+                                (i * naoccA * navirA * navirA) + (k * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](ba,c) -= \sum(m) t_jm^ba <ik|mc> (3-)
+                    // W[ijk](ba,c) -= \sum(m) T[j](m,ba) I[ik](mc)
+                    V->contract(true, false, navirA * navirA, navirA, naoccA, T, I, j * naoccA * navirA * navirA,
+                                (i * naoccA * naoccA * navirA) + (k * naoccA * navirA), -1.0, 1.0);
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        for (long int b = 0; b < navirA; ++b) {
+                            W->axpy((size_t)navirA, b * navirA * navirA + a * navirA, 1, V,
+                                    a * navirA * navirA + b * navirA, 1, 1.0);
+                        }
+                    }
+
+                    // W[ijk](bc,a) = \sum(e) t_ki^ea (jb|ce) (4+)
+                    // W[ijk](bc,a) = \sum(e) J[j](bc,e) T[ki](ea)
+                    V->contract(false, false, navirA * navirA, navirA, navirA, J2, T, 0,
+                                (k * naoccA * navirA * navirA) + (i * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](bc,a) -= \sum(m) t_jm^bc <ki|ma> (4-)
+                    // W[ijk](bc,a) -= \sum(m) T[j](m,bc) I[ki](ma)
+                    V->contract(true, false, navirA * navirA, navirA, naoccA, T, I, j * naoccA * navirA * navirA,
+                                (k * naoccA * naoccA * navirA) + (i * naoccA * navirA), -1.0, 1.0);
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        for (long int b = 0; b < navirA; ++b) {
+                            W->axpy((size_t)navirA, b * navirA * navirA + a, navirA, V,
+                                    a * navirA * navirA + b * navirA, 1, 1.0);
+                        }
+                    }
+
+                    // W[ijk](ca,b) = \sum(e) t_ij^eb (kc|ae) (5+)
+                    // W[ijk](ca,b) = \sum(e) J[k](ca,e) T[ij](eb)
+                    V->contract(false, false, navirA * navirA, navirA, navirA, J3, T, 0,
+                                (i * naoccA * navirA * navirA) + (j * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](ca,b) -= \sum(m) t_km^ca <ij|mb> (5-)
+                    // W[ijk](ca,b) -= \sum(m) T[k](m,ca) I[ij](mb)
+                    V->contract(true, false, navirA * navirA, navirA, naoccA, T, I, k * naoccA * navirA * navirA,
+                                (i * naoccA * naoccA * navirA) + (j * naoccA * navirA), -1.0, 1.0);
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        for (long int b = 0; b < navirA; ++b) {
+                            W->axpy((size_t)navirA, a * navirA + b, navirA * navirA, V,
+                                    a * navirA * navirA + b * navirA, 1, 1.0);
+                        }
+                    }
+
+                    // W[ijk](cb,a) = \sum(e) t_ji^ea (kc|be) (6+)
+                    // W[ijk](cb,a) = \sum(e) J[k](cb,e) T[ji](ea)
+                    V->contract(false, false, navirA * navirA, navirA, navirA, J3, T, 0,
+                                (j * naoccA * navirA * navirA) + (i * navirA * navirA), 1.0, 0.0);
+
+                    // W[ijk](cb,a) -= \sum(m) t_km^cb <ji|ma> (6-)
+                    // W[ijk](cb,a) -= \sum(m) T[k](m,cb) I[ji](ma)
+                    V->contract(true, false, navirA * navirA, navirA, naoccA, T, I, k * naoccA * navirA * navirA,
+                                (j * naoccA * naoccA * navirA) + (i * naoccA * navirA), -1.0, 1.0);
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        for (long int b = 0; b < navirA; ++b) {
+                            W->axpy((size_t)navirA, b * navirA + a, navirA * navirA, V,
+                                    a * navirA * navirA + b * navirA, 1, 1.0);
+                        }
+                    }
+
+                    // V[ijk](ab,c) = W[ijk](ab,c)
+                    V->copy(W);
+
+// V[ijk](ab,c) += t_i^a (jb|kc) + t_j^b (ia|kc) + t_k^c (ia|jb)
+// Vt[ijk](ab,c) = V[ijk](ab,c) / (1 + \delta(abc))
+#pragma omp parallel for
+                    for (long int a = 0; a < navirA; ++a) {
+                        long int ia = ia_idxAA->get(i, a);
+                        for (long int b = 0; b < navirA; ++b) {
+                            long int jb = ia_idxAA->get(j, b);
+                            long int ab = ab_idxAA->get(a, b);
+                            for (long int c = 0; c < navirA; ++c) {
+                                long int kc = ia_idxAA->get(k, c);
+                                double value = V->get(ab, c) + (t1A->get(i, a) * J->get(jb, kc)) +
+                                               (t1A->get(j, b) * J->get(ia, kc)) + (t1A->get(k, c) * J->get(ia, jb));
+                                double denom = 1 + ((a == b) + (b == c) + (a == c));
+                                V->set(ab, c, value / denom);
+                            }
+                        }
+                    }
+
+                    // Denom
+                    double Dijk = Dij + FockA->get(k + nfrzc, k + nfrzc);
+                    double factor = 2 - ((i == j) + (j == k) + (i == k));
+
+                    // Compute energy
+                    double Xvalue, Yvalue, Zvalue;
+#pragma omp parallel for private(Xvalue, Yvalue, Zvalue) reduction(+ : sum)
+                    for (long int a = 0; a < navirA; ++a) {
+                        double Dijka = Dijk - FockA->get(a + noccA, a + noccA);
+                        for (long int b = 0; b <= a; ++b) {
+                            double Dijkab = Dijka - FockA->get(b + noccA, b + noccA);
+                            long int ab = ab_idxAA->get(a, b);
+                            long int ba = ab_idxAA->get(b, a);
+                            for (long int c = 0; c <= b; ++c) {
+                                long int ac = ab_idxAA->get(a, c);
+                                long int bc = ab_idxAA->get(b, c);
+                                long int ca = ab_idxAA->get(c, a);
+                                long int cb = ab_idxAA->get(c, b);
+
+                                // X_ijk^abc
+                                Xvalue = (W->get(ab, c) * V->get(ab, c)) + (W->get(ac, b) * V->get(ac, b)) +
+                                         (W->get(ba, c) * V->get(ba, c)) + (W->get(bc, a) * V->get(bc, a)) +
+                                         (W->get(ca, b) * V->get(ca, b)) + (W->get(cb, a) * V->get(cb, a));
+
+                                // Y_ijk^abc
+                                Yvalue = V->get(ab, c) + V->get(bc, a) + V->get(ca, b);
+
+                                // Z_ijk^abc
+                                Zvalue = V->get(ac, b) + V->get(ba, c) + V->get(cb, a);
+
+                                // contributions to energy
+                                double value =
+                                    (Yvalue - (2.0 * Zvalue)) * (W->get(ab, c) + W->get(bc, a) + W->get(ca, b));
+                                value += (Zvalue - (2.0 * Yvalue)) * (W->get(ac, b) + W->get(ba, c) + W->get(cb, a));
+                                value += 3.0 * Xvalue;
+                                double Dijkabc = Dijkab - FockA->get(c + noccA, c + noccA);
+                                sum += (value * factor) / Dijkabc;
+                            }
+                        }
+                    }
+
+                }  // k
+            }  // k0
+        }      // j
+    }          // i
+
+    // The last pass has read block 0 ahead for a pass that does not come
+    if (reader.joinable()) reader.join();
+    Kfull[0].reset();
+    Kfull[1].reset();
+    Ktail.reset();
+    Knext.reset();
+    Jwin.clear();
+    Jt.reset();
+    Ji.reset();
+    Bi.reset();
+    T.reset();
+    J.reset();
+    W.reset();
+    V.reset();
+    J1.reset();
+    J2.reset();
+    J2buf.reset();
+    J3.reset();
+    I.reset();
+
+    // set energy
+    E_t = sum;
+    Eccsd_t = Eccsd + E_t;
+
+}  // end ccsd_canonic_triples_stream
+
 //======================================================================
 //       (T): grad
 //======================================================================
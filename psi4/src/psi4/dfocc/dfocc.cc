@@ -30,8 +30,10 @@
 #include <cmath>
 #include "psi4/libqt/qt.h"
 #include "dfocc.h"
+#include "arena.h"
 #include "defines.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 #include "psi4/liboptions/liboptions.h"
 
 using namespace psi;
@@ -520,6 +522,7 @@ double DFOCC::compute_energy() {
     // Call the appropriate manager
     // do_cd = "FALSE";
     nincore_amp = 3;
+    TensorArena::shared().reset(Process::environment.get_memory());
     if (wfn_type_ == "DF-OMP2" && orb_opt_ == "TRUE" && do_cd == "FALSE")
         omp2_manager();
     else if (wfn_type_ == "DF-OMP2" && orb_opt_ == "FALSE" && do_cd == "FALSE")
@@ -594,6 +597,10 @@ double DFOCC::compute_energy() {
     else if (wfn_type_ == "QCHF")
         Etotal = Eref;
 
+    // Tensor memory high-water marks; the first-iteration peak is the estimate for a rerun
+    TensorArena::shared().print_summary(print_);
+    TensorArena::shared().trim();
+
     return Etotal;
 
 }  // end of compute_energy
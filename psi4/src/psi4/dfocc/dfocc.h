@@ -519,6 +519,7 @@ class DFOCC : public Wavefunction {
     void ccsd_canonic_triples();
     void ccsd_canonic_triples_hm();
     void ccsd_canonic_triples_disk();
+    void ccsd_canonic_triples_stream();
     void ccsd_t_manager();
     void ccsd_t_manager_cd();
     void ccsd_canonic_triples_grad();
@@ -29,6 +29,7 @@
 #include "psi4/libqt/qt.h"
 #include "defines.h"
 #include "dfocc.h"
+#include "arena.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libdiis/diismanager.h"
 
@@ -87,6 +88,7 @@ void DFOCC::lccd_iterations() {
     do {
         // iterate
         itr_occ++;
+        TensorArena::shared().begin_iteration();
 
         // F intermediates
         timer_on("CCD F intr");
@@ -1043,6 +1043,15 @@ void DFOCC::ccsd_t_manager() {
         cost_amp2 *= (naoccA * navirA) / 1024.0;
         cost_triples_iabc += cost_amp2;
         cost_triples_iabc *= sizeof(double);
+        // Memory: 2*O^2V^2 + 5*V^3 + O^3V + NOV (+ more J[k] and larger Q-blocks of B(Q|AB) as memory allows)
+        double cost_triples_stream = 0.0;
+        cost_triples_stream = 2.0 * naoccA * naoccA * navirA * navirA;
+        cost_triples_stream += 5.0 * navirA * navirA * navirA;
+        cost_triples_stream += naoccA * naoccA * naoccA * navirA;
+        cost_triples_stream += 1.0 * nQ * naoccA * navirA;
+        cost_triples_stream += 3.0 * navirA * ntri_abAA + 3.0 * ntri_abAA;
+        cost_triples_stream /= 1024.0 * 1024.0;
+        cost_triples_stream *= sizeof(double);
 
         if (triples_iabc_type_ == "DISK") {
             do_triples_hm = false;
@@ -1052,6 +1061,10 @@ void DFOCC::ccsd_t_manager() {
             do_triples_hm = false;
             outfile->Printf("\n\tI will use a DIRECT algorithm for (ia|bc) in (T)! \n");
             outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_amp1);
+        } else if (triples_iabc_type_ == "STREAM") {
+            do_triples_hm = false;
+            outfile->Printf("\n\tI will use a STREAM algorithm for (ia|bc) in (T)! \n");
+            outfile->Printf("\tMemory requirement for (T) correction : %9.2lf MB \n", cost_triples_stream);
         } else if (cost_triples_iabc > memory_mb && triples_iabc_type_ == "AUTO") {
             do_triples_hm = false;
             outfile->Printf("\n\tI will use a DIRECT algorithm for (ia|bc) in (T)! \n");
@@ -1231,6 +1244,8 @@ void DFOCC::ccsd_t_manager() {
             ccsd_canonic_triples_hm();
         else if (triples_iabc_type_ == "DIRECT")
             ccsd_canonic_triples();
+        else if (triples_iabc_type_ == "STREAM")
+            ccsd_canonic_triples_stream();
         else if (triples_iabc_type_ == "DISK")
             ccsd_canonic_triples_disk();
     }
@@ -28,6 +28,7 @@
 
 #include "defines.h"
 #include "dfocc.h"
+#include "arena.h"
 
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/molecule.h"
@@ -110,6 +111,7 @@ void DFOCC::occ_iterations() {
     //==========================================================================================
     do {
         itr_occ++;
+        TensorArena::shared().begin_iteration();
 
         //==========================================================================================
         //========================= New orbital step ===============================================
@@ -29,6 +29,7 @@
 #include "psi4/libqt/qt.h"
 #include "defines.h"
 #include "dfocc.h"
+#include "arena.h"
 #include "psi4/libciomr/libciomr.h"
 
 #include <cmath>
@@ -100,6 +101,7 @@ void DFOCC::qchf() {
     //==========================================================================================
     do {
         itr_occ++;
+        TensorArena::shared().begin_iteration();
 
         //==========================================================================================
         //========================= New orbital step ===============================================
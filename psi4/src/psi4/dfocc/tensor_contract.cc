@@ -0,0 +1,462 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*
+ * Index-string tensor contractions for Tensor2d.
+ *
+ * C = alpha * A * B + beta * C is mapped onto GEMMs in one of three ways:
+ *  - loop over GEMM: indices that lead their operands are looped over and the rest of each operand is
+ *    handed to a GEMM as it is stored (a leading summed index is accumulated into C);
+ *  - batched GEMM: indices common to A, B and C are moved to the front and one GEMM is done per batch;
+ *  - transpose then GEMM: operands that cannot be used in place are copied into GEMM order first.
+ * Every layout that needs no copy is costed together with the copying one, and the cheapest is used.
+ * Copies are blocked permutations into a scratch space that is kept between calls; DFOCC gives it back
+ * to the tensor arena at the end of a run.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/exception.h"
+#include "arena.h"
+#include "tensors.h"
+
+namespace psi {
+namespace dfoccwave {
+
+namespace {
+
+// Rough costs in flop equivalents: one GEMM call, and one element moved by a permutation
+const double gemm_call_cost = 5.0e3;
+const double copy_element_cost = 8.0;
+// Tile edge for the blocked permutations
+const long int perm_tile = 32;
+
+// Scratch for one call; it comes from the tensor arena, so it counts against the DFOCC memory limit
+// and its blocks are recycled by the next call
+struct ContractWorkspace {
+    double **slot[3] = {nullptr, nullptr, nullptr};
+    size_t size[3] = {0, 0, 0};
+    double *get(int s, size_t n) {
+        if (size[s] < n) {
+            TensorArena::shared().free_block(slot[s]);
+            slot[s] = TensorArena::shared().block_matrix(1, n);
+            size[s] = n;
+        }
+        return slot[s] ? slot[s][0] : nullptr;
+    }
+    void release() {
+        for (int s = 0; s < 3; s++) {
+            TensorArena::shared().free_block(slot[s]);
+            slot[s] = nullptr;
+            size[s] = 0;
+        }
+    }
+    ~ContractWorkspace() { release(); }
+};
+
+// An operand as seen by the contraction: labels and sizes of its indices, slowest first
+struct TensorView {
+    std::string idx;
+    std::vector<long int> dim;
+    std::vector<long int> stride;
+    double *data;
+
+    void set_strides() {
+        stride.assign(idx.size(), 1);
+        for (int d = (int)idx.size() - 2; d >= 0; d--) stride[d] = stride[d + 1] * dim[d + 1];
+    }
+    int pos(char c) const {
+        size_t p = idx.find(c);
+        return (p == std::string::npos) ? -1 : (int)p;
+    }
+    long int size_of(const std::string &labels) const {
+        long int n = 1;
+        for (char c : labels) n *= dim[pos(c)];
+        return n;
+    }
+};
+
+// GEMMs on small dimensions run well below peak; scale their cost accordingly
+double gemm_cost(long int m, long int n, long int k, long int ncalls) {
+    double edge = (double)std::min(m, std::min(n, k));
+    double eff = std::max(1.0 / 32.0, std::min(1.0, edge / 32.0));
+    return ncalls * (2.0 * m * n * k / eff + gemm_call_cost);
+}
+
+std::string without(const std::string &s, const std::string &drop) {
+    std::string r;
+    for (char c : s)
+        if (drop.find(c) == std::string::npos) r += c;
+    return r;
+}
+
+std::string only(const std::string &s, const std::string &keep) {
+    std::string r;
+    for (char c : s)
+        if (keep.find(c) != std::string::npos) r += c;
+    return r;
+}
+
+// out(i_0, ..., i_{r-1}) = in[sum_d i_d * istride[d]] + beta * out, with out stored contiguously.
+// The two fastest output indices are copied in tiles so that a transposed read stays in cache.
+void permute(const std::vector<long int> &dim, const std::vector<long int> &istride, const double *in, double *out,
+             double beta) {
+    int rank = dim.size();
+    long int n1 = rank > 1 ? dim[rank - 2] : 1;
+    long int n2 = dim[rank - 1];
+    long int s1 = rank > 1 ? istride[rank - 2] : 0;
+    long int s2 = istride[rank - 1];
+    long int nouter = 1;
+    for (int d = 0; d < rank - 2; d++) nouter *= dim[d];
+
+#pragma omp parallel for
+    for (long int outer = 0; outer < nouter; outer++) {
+        long int ioff = 0;
+        long int rem = outer;
+        for (int d = rank - 3; d >= 0; d--) {
+            ioff += (rem % dim[d]) * istride[d];
+            rem /= dim[d];
+        }
+        const double *src = in + ioff;
+        double *dst = out + outer * n1 * n2;
+        if (s2 == 1) {
+            for (long int i = 0; i < n1; i++) {
+                if (beta == 0.0) {
+                    for (long int j = 0; j < n2; j++) dst[i * n2 + j] = src[i * s1 + j];
+                } else {
+                    for (long int j = 0; j < n2; j++) dst[i * n2 + j] = src[i * s1 + j] + beta * dst[i * n2 + j];
+                }
+            }
+        } else {
+            for (long int i0 = 0; i0 < n1; i0 += perm_tile) {
+                long int i1 = std::min(n1, i0 + perm_tile);
+                for (long int j0 = 0; j0 < n2; j0 += perm_tile) {
+                    long int j1 = std::min(n2, j0 + perm_tile);
+                    for (long int i = i0; i < i1; i++) {
+                        if (beta == 0.0) {
+                            for (long int j = j0; j < j1; j++) dst[i * n2 + j] = src[i * s1 + j * s2];
+                        } else {
+                            for (long int j = j0; j < j1; j++)
+                                dst[i * n2 + j] = src[i * s1 + j * s2] + beta * dst[i * n2 + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Copy X into the index order 'order' (a permutation of X.idx)
+void permute_into(const TensorView &X, const std::string &order, double *out) {
+    std::vector<long int> dim, istride;
+    for (char c : order) {
+        dim.push_back(X.dim[X.pos(c)]);
+        istride.push_back(X.stride[X.pos(c)]);
+    }
+    permute(dim, istride, X.data, out, 0.0);
+}
+
+// One way of doing the contraction
+struct ContractPlan {
+    std::string loops;                // indices looped over outside the GEMMs
+    std::string m_idx, n_idx, k_idx;  // GEMM row, column and summed indices, in their stored order
+    std::string a_order, b_order, c_order;
+    bool copy_a = false, copy_b = false, copy_c = false;
+    double cost = 0.0;
+};
+
+// Can X (less the looped indices) be handed to a GEMM in place as (first, second) or (second, first)?
+// 'first' and 'second' are sets; their order is returned through the references when it is fixed by X.
+bool gemm_order(const std::string &rest, std::string &g1, std::string &g2) {
+    std::string o1 = only(rest, g1);
+    std::string o2 = only(rest, g2);
+    if (rest == o1 + o2 || rest == o2 + o1) {
+        g1 = o1;
+        g2 = o2;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+void Tensor2d::contract(const std::string &expr, const SharedTensor2d &a, const SharedTensor2d &b, double alpha,
+                        double beta) {
+    // Parse "ab,bc->ac"
+    std::string spec;
+    for (char c : expr)
+        if (c != ' ') spec += c;
+    size_t comma = spec.find(',');
+    size_t arrow = spec.find("->");
+    if (comma == std::string::npos || arrow == std::string::npos || arrow < comma)
+        throw PSIEXCEPTION("Tensor2d::contract: expression must look like \"ab,bc->ac\", got " + expr);
+
+    auto view = [&](const Tensor2d *T, const std::string &idx) {
+        TensorView V;
+        V.idx = idx;
+        V.data = T->A2d_[0];
+        if (idx.size() == 2) {
+            V.dim = {T->dim1_, T->dim2_};
+        } else if (idx.size() == 3 && T->d1_ > 0 && T->d4_ == 0) {
+            V.dim = {T->d1_, T->d2_, T->d3_};
+        } else if (idx.size() == 4 && T->d1_ > 0 && T->d4_ > 0 && T->d1_ * T->d2_ == T->dim1_) {
+            V.dim = {T->d1_, T->d2_, T->d3_, T->d4_};
+        } else {
+            throw PSIEXCEPTION("Tensor2d::contract: " + T->name_ + " cannot be indexed as " + idx);
+        }
+        for (size_t d = 0; d < idx.size(); d++)
+            if (idx.find(idx[d]) != d)
+                throw PSIEXCEPTION("Tensor2d::contract: repeated index in " + idx + " of " + expr);
+        V.set_strides();
+        return V;
+    };
+    TensorView A = view(a.get(), spec.substr(0, comma));
+    TensorView B = view(b.get(), spec.substr(comma + 1, arrow - comma - 1));
+    TensorView C = view(this, spec.substr(arrow + 2));
+
+    // Sort the indices: batch (A,B,C), free in A (A,C), free in B (B,C), summed (A,B)
+    std::string h_all, m_all, n_all, k_all;
+    for (char c : C.idx) {
+        int pa = A.pos(c), pb = B.pos(c);
+        if (pa >= 0 && pb >= 0)
+            h_all += c;
+        else if (pa >= 0)
+            m_all += c;
+        else if (pb >= 0)
+            n_all += c;
+        else
+            throw PSIEXCEPTION("Tensor2d::contract: index of C is in neither A nor B in " + expr);
+    }
+    for (char c : A.idx) {
+        if (C.pos(c) >= 0) continue;
+        if (B.pos(c) < 0) throw PSIEXCEPTION("Tensor2d::contract: index summed over A alone in " + expr);
+        k_all += c;
+    }
+    for (char c : B.idx)
+        if (C.pos(c) < 0 && A.pos(c) < 0)
+            throw PSIEXCEPTION("Tensor2d::contract: index summed over B alone in " + expr);
+    for (char c : A.idx + B.idx) {
+        long int d = (A.pos(c) >= 0) ? A.dim[A.pos(c)] : B.dim[B.pos(c)];
+        if ((A.pos(c) >= 0 && A.dim[A.pos(c)] != d) || (B.pos(c) >= 0 && B.dim[B.pos(c)] != d) ||
+            (C.pos(c) >= 0 && C.dim[C.pos(c)] != d))
+            throw PSIEXCEPTION("Tensor2d::contract: dimensions do not match in " + expr);
+    }
+
+    auto extent = [&](const std::string &labels) {
+        long int n = 1;
+        for (char c : labels) {
+            if (A.pos(c) >= 0)
+                n *= A.dim[A.pos(c)];
+            else
+                n *= B.dim[B.pos(c)];
+        }
+        return n;
+    };
+    long int M = extent(m_all), N = extent(n_all), K = extent(k_all), H = extent(h_all);
+
+    // Plans that use every operand in place: loop over a union of leading indices of A, B and C
+    ContractPlan best;
+    best.cost = -1.0;
+    for (size_t pa = 0; pa <= A.idx.size(); pa++) {
+        for (size_t pb = 0; pb <= B.idx.size(); pb++) {
+            for (size_t pc = 0; pc <= C.idx.size(); pc++) {
+                std::string loops = C.idx.substr(0, pc);
+                for (char c : A.idx.substr(0, pa) + B.idx.substr(0, pb))
+                    if (loops.find(c) == std::string::npos) loops += c;
+
+                // The looped indices have to lead each operand
+                bool ok = true;
+                for (const TensorView *X : {&A, &B, &C}) {
+                    std::string mine = only(X->idx, loops);
+                    if (X->idx.substr(0, mine.size()) != mine) ok = false;
+                }
+                if (!ok) continue;
+
+                std::string m = without(m_all, loops), n = without(n_all, loops), k = without(k_all, loops);
+                if (!without(h_all, loops).empty()) continue;
+                std::string ra = without(A.idx, loops), rb = without(B.idx, loops), rc = without(C.idx, loops);
+                std::string mc = m, nc = n;
+                if (!gemm_order(rc, mc, nc)) continue;
+                std::string ma = mc, ka = k;
+                if (!gemm_order(ra, ma, ka) || ma != mc) continue;
+                std::string kb = ka, nb = nc;
+                if (!gemm_order(rb, kb, nb) || kb != ka || nb != nc) continue;
+
+                long int ncalls = extent(loops);
+                double cost = gemm_cost(extent(m), extent(n), extent(k), ncalls);
+                if (best.cost < 0.0 || cost < best.cost) {
+                    best = ContractPlan();
+                    best.loops = loops;
+                    best.m_idx = mc;
+                    best.n_idx = nc;
+                    best.k_idx = ka;
+                    best.cost = cost;
+                }
+            }
+        }
+    }
+
+    // Batched plan: batch indices in front, anything not already in GEMM order is copied first
+    {
+        ContractPlan plan;
+        plan.loops = h_all;
+        std::string rc = without(C.idx, h_all);
+        plan.m_idx = m_all;
+        plan.n_idx = n_all;
+        plan.copy_c = C.idx.substr(0, h_all.size()) != h_all || !gemm_order(rc, plan.m_idx, plan.n_idx);
+        plan.k_idx = only(A.idx, k_all);
+        std::string ra = without(A.idx, h_all), ma = plan.m_idx;
+        plan.copy_a = A.idx.substr(0, h_all.size()) != h_all || !gemm_order(ra, ma, plan.k_idx) || ma != plan.m_idx;
+        if (plan.copy_a) plan.k_idx = only(B.idx, k_all);
+        std::string rb = without(B.idx, h_all), kb = plan.k_idx, nb = plan.n_idx;
+        plan.copy_b = B.idx.substr(0, h_all.size()) != h_all || !gemm_order(rb, kb, nb) || kb != plan.k_idx ||
+                      nb != plan.n_idx;
+        if (plan.copy_a) plan.a_order = h_all + plan.m_idx + plan.k_idx;
+        if (plan.copy_b) plan.b_order = h_all + plan.k_idx + plan.n_idx;
+        if (plan.copy_c) plan.c_order = h_all + plan.m_idx + plan.n_idx;
+
+        plan.cost = gemm_cost(M, N, K, H);
+        if (plan.copy_a) plan.cost += copy_element_cost * H * M * K;
+        if (plan.copy_b) plan.cost += copy_element_cost * H * K * N;
+        if (plan.copy_c) plan.cost += copy_element_cost * H * M * N * (beta == 0.0 ? 1.0 : 2.0);
+        if (best.cost < 0.0 || plan.cost < best.cost) best = plan;
+    }
+
+    // Operands in GEMM order, possibly in the scratch space
+    ContractWorkspace ws;
+    TensorView Ag = A, Bg = B, Cg = C;
+    if (best.copy_a) {
+        Ag.data = ws.get(0, (size_t)H * M * K);
+        permute_into(A, best.a_order, Ag.data);
+        Ag.idx = best.a_order;
+        Ag.dim.clear();
+        for (char c : Ag.idx) Ag.dim.push_back(A.dim[A.pos(c)]);
+        Ag.set_strides();
+    }
+    if (best.copy_b) {
+        Bg.data = ws.get(1, (size_t)H * K * N);
+        permute_into(B, best.b_order, Bg.data);
+        Bg.idx = best.b_order;
+        Bg.dim.clear();
+        for (char c : Bg.idx) Bg.dim.push_back(B.dim[B.pos(c)]);
+        Bg.set_strides();
+    }
+    double gemm_beta = beta;
+    if (best.copy_c) {
+        Cg.data = ws.get(2, (size_t)H * M * N);
+        Cg.idx = best.c_order;
+        Cg.dim.clear();
+        for (char c : Cg.idx) Cg.dim.push_back(C.dim[C.pos(c)]);
+        Cg.set_strides();
+        gemm_beta = 0.0;
+    }
+
+    // A summed index among the loops accumulates into the same block of C
+    bool accumulate = !only(best.loops, k_all).empty();
+    if (accumulate) {
+        if (gemm_beta == 0.0) {
+            std::fill(Cg.data, Cg.data + (size_t)H * M * N, 0.0);
+        } else if (gemm_beta != 1.0) {
+            for (size_t x = 0; x < (size_t)H * M * N; x++) Cg.data[x] *= gemm_beta;
+        }
+        gemm_beta = 1.0;
+    }
+
+    // GEMM shapes for what is left after the loops
+    std::string ra = without(Ag.idx, best.loops), rb = without(Bg.idx, best.loops), rc = without(Cg.idx, best.loops);
+    int m = Ag.size_of(best.m_idx);
+    int n = Bg.size_of(best.n_idx);
+    int k = Ag.size_of(best.k_idx);
+    bool a_km = !best.m_idx.empty() && !best.k_idx.empty() && ra.substr(0, best.k_idx.size()) == best.k_idx;
+    bool b_nk = !best.n_idx.empty() && !best.k_idx.empty() && rb.substr(0, best.n_idx.size()) == best.n_idx;
+    bool c_nm = !best.m_idx.empty() && !best.n_idx.empty() && rc.substr(0, best.n_idx.size()) == best.n_idx;
+    int lda = a_km ? m : k;
+    int ldb = b_nk ? k : n;
+
+    // Offsets of every loop iteration in each operand
+    long int nloops = 1;
+    std::vector<long int> ldim, sa, sb, sc;
+    for (char c : best.loops) {
+        long int d = (Ag.pos(c) >= 0) ? Ag.dim[Ag.pos(c)] : Bg.dim[Bg.pos(c)];
+        nloops *= d;
+        ldim.push_back(d);
+        sa.push_back(Ag.pos(c) >= 0 ? Ag.stride[Ag.pos(c)] : 0);
+        sb.push_back(Bg.pos(c) >= 0 ? Bg.stride[Bg.pos(c)] : 0);
+        sc.push_back(Cg.pos(c) >= 0 ? Cg.stride[Cg.pos(c)] : 0);
+    }
+    auto run = [&](long int it) {
+        long int oa = 0, ob = 0, oc = 0, rem = it;
+        for (int d = (int)ldim.size() - 1; d >= 0; d--) {
+            long int x = rem % ldim[d];
+            rem /= ldim[d];
+            oa += x * sa[d];
+            ob += x * sb[d];
+            oc += x * sc[d];
+        }
+        if (!c_nm) {
+            C_DGEMM(a_km ? 't' : 'n', b_nk ? 't' : 'n', m, n, k, alpha, Ag.data + oa, lda, Bg.data + ob, ldb,
+                    gemm_beta, Cg.data + oc, n);
+        } else {
+            C_DGEMM(b_nk ? 'n' : 't', a_km ? 'n' : 't', n, m, k, alpha, Bg.data + ob, ldb, Ag.data + oa, lda,
+                    gemm_beta, Cg.data + oc, m);
+        }
+    };
+
+    if (m && n && k) {
+        if (accumulate || nloops == 1) {
+            for (long int it = 0; it < nloops; it++) run(it);
+        } else {
+#pragma omp parallel for
+            for (long int it = 0; it < nloops; it++) run(it);
+        }
+    } else if (gemm_beta == 0.0) {
+        // Nothing to multiply (an empty summed index): the GEMMs would only have scaled C
+        std::fill(Cg.data, Cg.data + (size_t)H * M * N, 0.0);
+    } else if (gemm_beta != 1.0) {
+        for (size_t x = 0; x < (size_t)H * M * N; x++) Cg.data[x] *= gemm_beta;
+    }
+
+    // Back to the layout of C
+    if (best.copy_c) {
+        std::vector<long int> dim, istride;
+        for (char c : C.idx) {
+            dim.push_back(C.dim[C.pos(c)]);
+            istride.push_back(Cg.stride[Cg.pos(c)]);
+        }
+        permute(dim, istride, Cg.data, C.data, beta);
+    }
+}
+
+}  // namespace dfoccwave
+}  // namespace psi
@@ -36,6 +36,7 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "tensors.h"
+#include "arena.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/vector.h"
@@ -522,7 +523,7 @@ Tensor2d::Tensor2d(std::string name, int d1, int d2, int d3, int d4) {
 
     // memalloc
     if (A2d_) release();
-    A2d_ = block_matrix(dim1_, dim2_);
+    A2d_ = TensorArena::shared().block_matrix(dim1_, dim2_);
     zero();
 
     // row idx
@@ -577,7 +578,7 @@ Tensor2d::Tensor2d(std::string name, int d1, int d2, int d3) {
 
     // memalloc
     if (A2d_) release();
-    A2d_ = block_matrix(dim1_, dim2_);
+    A2d_ = TensorArena::shared().block_matrix(dim1_, dim2_);
     zero();
 
     // col idx
@@ -602,14 +603,14 @@ Tensor2d::~Tensor2d() { release(); }  //
 
 void Tensor2d::memalloc() {
     if (A2d_) release();
-    A2d_ = block_matrix(dim1_, dim2_);
+    A2d_ = TensorArena::shared().block_matrix(dim1_, dim2_);
     zero();
 }  //
 
 void Tensor2d::release() {
     // if (!A2d_) return;
     // free_block(A2d_);
-    if (A2d_) free_block(A2d_);
+    if (A2d_) TensorArena::shared().free_block(A2d_);
     if (row_idx_) free_int_matrix(row_idx_);
     if (col_idx_) free_int_matrix(col_idx_);
     if (row2d1_) delete[] row2d1_;
@@ -630,7 +631,7 @@ void Tensor2d::init(int d1, int d2) {
     dim1_ = d1;
     dim2_ = d2;
     if (A2d_) release();
-    A2d_ = block_matrix(dim1_, dim2_);
+    A2d_ = TensorArena::shared().block_matrix(dim1_, dim2_);
 }  //
 
 void Tensor2d::init(std::string name, int d1, int d2) {
@@ -638,7 +639,7 @@ void Tensor2d::init(std::string name, int d1, int d2) {
     dim2_ = d2;
     name_ = name;
     if (A2d_) release();
-    A2d_ = block_matrix(dim1_, dim2_);
+    A2d_ = TensorArena::shared().block_matrix(dim1_, dim2_);
 }  //
 
 void Tensor2d::zero() { memset(A2d_[0], 0, sizeof(double) * dim1_ * dim2_); }  //
@@ -977,110 +978,22 @@ void Tensor2d::contract424(int target_x, int target_y, const SharedTensor2d &a,
 
     // C(pq,rs) = \sum_{o} A(po,rs) B(o,q)
     else if (target_x == 2 && target_y == 1) {
-        ta = 'n';
-        tb = 'n';
-        m = d1_ * d3_ * d4_;
-        n = d2_;
-        k = b->dim1();
-        lda = k;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d1_, a->d3_, a->d4_, a->d2_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", d1_, d3_, d4_, d2_));
-        temp1->sort(1342, a, 1.0, 0.0);
-
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, temp1->A2d_[0], lda, b->A2d_[0], ldb, 0.0, temp2->A2d_[0], ldc);
-        }
-        temp1.reset();
-        SharedTensor2d temp3 = SharedTensor2d(new Tensor2d("temp3", d1_, d2_, d3_, d4_));
-        temp3->sort(1423, temp2, 1.0, 0.0);
-        temp2.reset();
-        scale(beta);
-        add(temp3);
-        temp3.reset();
+        contract("pors,oq->pqrs", a, b, alpha, beta);
     }
 
     // C(pq,rs) = \sum_{o} A(po,rs) B(q,o)
     else if (target_x == 2 && target_y == 2) {
-        ta = 'n';
-        tb = 't';
-        m = d1_ * d3_ * d4_;
-        n = d2_;
-        k = b->dim2();
-        lda = k;
-        ldb = k;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d1_, a->d3_, a->d4_, a->d2_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", d1_, d3_, d4_, d2_));
-        temp1->sort(1342, a, 1.0, 0.0);
-
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, temp1->A2d_[0], lda, b->A2d_[0], ldb, 0.0, temp2->A2d_[0], ldc);
-        }
-        temp1.reset();
-        SharedTensor2d temp3 = SharedTensor2d(new Tensor2d("temp3", d1_, d2_, d3_, d4_));
-        temp3->sort(1423, temp2, 1.0, 0.0);
-        temp2.reset();
-        scale(beta);
-        add(temp3);
-        temp3.reset();
+        contract("pors,qo->pqrs", a, b, alpha, beta);
     }
 
     // C(pq,rs) = \sum_{o} A(pq,os) B(o,r)
     else if (target_x == 3 && target_y == 1) {
-        ta = 'n';
-        tb = 'n';
-        m = d1_ * d2_ * d4_;
-        n = d3_;
-        k = b->dim1();
-        lda = k;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d1_, a->d2_, a->d4_, a->d3_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", d1_, d2_, d4_, d3_));
-        temp1->sort(1243, a, 1.0, 0.0);
-
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, temp1->A2d_[0], lda, b->A2d_[0], ldb, 0.0, temp2->A2d_[0], ldc);
-        }
-        temp1.reset();
-        SharedTensor2d temp3 = SharedTensor2d(new Tensor2d("temp3", d1_, d2_, d3_, d4_));
-        temp3->sort(1243, temp2, 1.0, 0.0);
-        temp2.reset();
-        scale(beta);
-        add(temp3);
-        temp3.reset();
+        contract("pqos,or->pqrs", a, b, alpha, beta);
     }
 
     // C(pq,rs) = \sum_{o} A(pq,os) B(r,o)
     else if (target_x == 3 && target_y == 2) {
-        ta = 'n';
-        tb = 't';
-        m = d1_ * d2_ * d4_;
-        n = d3_;
-        k = b->dim2();
-        lda = k;
-        ldb = k;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d1_, a->d2_, a->d4_, a->d3_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", d1_, d2_, d4_, d3_));
-        temp1->sort(1243, a, 1.0, 0.0);
-
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, temp1->A2d_[0], lda, b->A2d_[0], ldb, 0.0, temp2->A2d_[0], ldc);
-        }
-        temp1.reset();
-        SharedTensor2d temp3 = SharedTensor2d(new Tensor2d("temp3", d1_, d2_, d3_, d4_));
-        temp3->sort(1243, temp2, 1.0, 0.0);
-        temp2.reset();
-        scale(beta);
-        add(temp3);
-        temp3.reset();
+        contract("pqos,ro->pqrs", a, b, alpha, beta);
     }
 
     // C(pq,rs) = \sum_{o} A(pq,ro) B(o,s)
@@ -1314,40 +1227,12 @@ void Tensor2d::contract442(int target_a, int target_b, const SharedTensor2d &a,
 
     // C(p,q) = \sum_{rst} A(pr,st) B(rq,st)
     else if (target_a == 1 && target_b == 2) {
-        ta = 'n';
-        tb = 't';
-        m = dim1_;
-        n = dim2_;
-        k = a->d2_ * a->d3_ * a->d4_;
-        lda = k;
-        ldb = k;
-        ldc = n;
-
-        SharedTensor2d temp = SharedTensor2d(new Tensor2d("temp", b->d2_, b->d1_, b->d3_, b->d4_));
-        temp->sort(2134, b, 1.0, 0.0);
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(a->A2d_[0][0]), lda, &(temp->A2d_[0][0]), ldb, beta, &(A2d_[0][0]), ldc);
-        }
-        temp.reset();
+        contract("prst,rqst->pq", a, b, alpha, beta);
     }
 
     // C(p,q) = \sum_{rst} A(pr,st) B(rs,qt)
     else if (target_a == 1 && target_b == 3) {
-        ta = 'n';
-        tb = 'n';
-        m = dim1_;
-        n = dim2_;
-        k = a->d2_ * a->d3_ * a->d4_;
-        lda = k;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp = SharedTensor2d(new Tensor2d("temp", b->d1_, b->d2_, b->d4_, b->d3_));
-        temp->sort(1243, b, 1.0, 0.0);
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(a->A2d_[0][0]), lda, &(temp->A2d_[0][0]), ldb, beta, &(A2d_[0][0]), ldc);
-        }
-        temp.reset();
+        contract("prst,rsqt->pq", a, b, alpha, beta);
     }
 
     // C(p,q) = \sum_{rst} A(pr,st) B(rs,tq)
@@ -1367,91 +1252,22 @@ void Tensor2d::contract442(int target_a, int target_b, const SharedTensor2d &a,
 
     // C(p,q) = \sum_{rst} A(rs,tp) B(rs,tq) = \sum_{rst} X(p,rst) B(rst,q)
     else if (target_a == 4 && target_b == 4) {
-        ta = 'n';
-        tb = 'n';
-        m = dim1_;
-        n = dim2_;
-        k = a->d1_ * a->d2_ * a->d3_;
-        lda = k;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp = SharedTensor2d(new Tensor2d("temp", a->d4_, a->d1_, a->d2_, a->d3_));
-        temp->sort(4123, a, 1.0, 0.0);
-
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(temp->A2d_[0][0]), lda, &(b->A2d_[0][0]), ldb, beta, &(A2d_[0][0]), ldc);
-        }
-        temp.reset();
+        contract("rstp,rstq->pq", a, b, alpha, beta);
     }
 
     // C(p,q) = \sum_{rst} A(rs,tp) B(rs,qt)
     else if (target_a == 4 && target_b == 3) {
-        ta = 'n';
-        tb = 'n';
-        m = dim1_;
-        n = dim2_;
-        k = a->d2_ * a->d3_ * a->d1_;
-        lda = k;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp", a->d4_, a->d1_, a->d2_, a->d3_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp", b->d1_, b->d2_, b->d4_, b->d3_));
-        temp1->sort(4123, a, 1.0, 0.0);
-        temp2->sort(1243, b, 1.0, 0.0);
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(temp1->A2d_[0][0]), lda, &(temp2->A2d_[0][0]), ldb, beta, &(A2d_[0][0]),
-                    ldc);
-        }
-        temp1.reset();
-        temp2.reset();
+        contract("rstp,rsqt->pq", a, b, alpha, beta);
     }
 
     // C(p,q) = \sum_{rst} A(rp,st) B(rq,st)
     else if (target_a == 2 && target_b == 2) {
-        ta = 'n';
-        tb = 't';
-        m = dim1_;
-        n = dim2_;
-        k = a->d1_ * a->d3_ * a->d4_;
-        lda = k;
-        ldb = k;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d2_, a->d1_, a->d3_, a->d4_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", b->d2_, b->d1_, b->d3_, b->d4_));
-        temp1->sort(2134, a, 1.0, 0.0);
-        temp2->sort(2134, b, 1.0, 0.0);
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(temp1->A2d_[0][0]), lda, &(temp2->A2d_[0][0]), ldb, beta, &(A2d_[0][0]),
-                    ldc);
-        }
-        temp1.reset();
-        temp2.reset();
+        contract("rpst,rqst->pq", a, b, alpha, beta);
     }
 
     // C(p,q) = \sum_{rst} A(rs,pt) B(rs,qt)
     else if (target_a == 3 && target_b == 3) {
-        ta = 't';
-        tb = 'n';
-        m = dim1_;
-        n = dim2_;
-        k = a->d1_ * a->d2_ * a->d4_;
-        lda = m;
-        ldb = n;
-        ldc = n;
-
-        SharedTensor2d temp1 = SharedTensor2d(new Tensor2d("temp1", a->d1_, a->d2_, a->d4_, a->d3_));
-        SharedTensor2d temp2 = SharedTensor2d(new Tensor2d("temp2", b->d1_, b->d2_, b->d4_, b->d3_));
-        temp1->sort(1243, a, 1.0, 0.0);
-        temp2->sort(1243, b, 1.0, 0.0);
-        if (m && n && k) {
-            C_DGEMM(ta, tb, m, n, k, alpha, &(temp1->A2d_[0][0]), lda, &(temp2->A2d_[0][0]), ldb, beta, &(A2d_[0][0]),
-                    ldc);
-        }
-        temp1.reset();
-        temp2.reset();
+        contract("rspt,rsqt->pq", a, b, alpha, beta);
     }
 
     else {
@@ -233,6 +233,11 @@ class Tensor2d {
                   int start_a, int start_b, double alpha, double beta);
     void contract(bool transa, bool transb, int m, int n, int k, const SharedTensor2d &a, const SharedTensor2d &b,
                   int start_a, int start_b, int start_c, double alpha, double beta);
+    // contract: C = alpha * A * B + beta * C with the indices given as in "ijab,abcd->ijcd". Operands may have
+    // 2, 3 or 4 indices (3 and 4 only for tensors made with the 3- and 4-index constructors). Whether to loop
+    // GEMMs over leading indices, batch them, or transpose operands first is chosen by a cost estimate.
+    void contract(const std::string &expr, const SharedTensor2d &a, const SharedTensor2d &b, double alpha,
+                  double beta);
     // contract323: C[Q](m,n) = \sum_{k} A[Q](m,k) * B(k,n). Note: contract332 should be called with beta=1.0
     void contract323(bool transa, bool transb, int m, int n, const SharedTensor2d &a, const SharedTensor2d &b,
                      double alpha, double beta);
@@ -663,41 +663,94 @@ void FISAPT::coulomb() {
 
     // => Global JK Object <= //
 
-    jk_ = JK::build_JK(primary_, reference_->get_basisset("DF_BASIS_SCF"), options_, false, doubles_);
-    jk_->set_memory(doubles_);
-
-    // => Build J and K for embedding <= //
+    // JK sizes its memory overhead from the densities set at initialize(), before any are. The largest
+    // batch compute_jk() gets later (six non-symmetric pairs, see exch() and ind()) is therefore taken off
+    // the budget here: C_left and C_right, D, J and K inside JK, and the J and K clones handed back.
+    size_t nbf = primary_->nbf();
+    size_t nocc = reference_->nalpha();
+    size_t nbatch = 6;
+    size_t batch_doubles = nbatch * (2 * nbf * nocc + 5 * nbf * nbf);
+    if (batch_doubles >= doubles_) {
+        throw PSIEXCEPTION("FISAPT: Not enough memory for the J/K builds.");
+    }
+    size_t jk_doubles = doubles_ - batch_doubles;
 
-    std::vector<SharedMatrix>& Cl = jk_->C_left();
-    std::vector<SharedMatrix>& Cr = jk_->C_right();
+    jk_ = JK::build_JK(primary_, reference_->get_basisset("DF_BASIS_SCF"), options_, false, jk_doubles);
+    jk_->set_memory(jk_doubles);
 
-    const std::vector<SharedMatrix>& J = jk_->J();
-    const std::vector<SharedMatrix>& K = jk_->K();
+    // => Build J and K for embedding <= //
 
-    Cl.clear();
-    Cr.clear();
+    std::vector<std::pair<SharedMatrix, SharedMatrix> > C;
 
     // => Prevent Failure if C, D, or E are empty <= //
 
-    if (matrices_["LoccC"]->colspi()[0] > 0) {
-        Cl.push_back(matrices_["LoccC"]);
-        Cr.push_back(matrices_["LoccC"]);
-    }
+    bool do_C = matrices_["LoccC"]->colspi()[0] > 0;
+    if (do_C) C.emplace_back(matrices_["LoccC"], matrices_["LoccC"]);
+
+    // The localized A and B densities of dHF() only depend on the partition, so their J/K are built here too
+    C.emplace_back(matrices_["LoccA"], matrices_["LoccA"]);
+    C.emplace_back(matrices_["LoccB"], matrices_["LoccB"]);
 
     jk_->set_do_J(true);
     jk_->set_do_K(true);
     jk_->initialize();
     jk_->print_header();
 
-    jk_->compute();
+    std::vector<std::pair<SharedMatrix, SharedMatrix> > JK = compute_jk(C);
 
     int nn = primary_->nbf();
     matrices_["JC"] = std::make_shared<Matrix>("JC", nn, nn);
     matrices_["KC"] = std::make_shared<Matrix>("KC", nn, nn);
-    if (matrices_["LoccC"]->colspi()[0] > 0) {
-        matrices_["JC"]->copy(J[0]);
-        matrices_["KC"]->copy(K[0]);
+    if (do_C) {
+        matrices_["JC"]->copy(JK[0].first);
+        matrices_["KC"]->copy(JK[0].second);
     }
+    matrices_["LJ_A"] = JK[do_C + 0].first;
+    matrices_["LK_A"] = JK[do_C + 0].second;
+    matrices_["LJ_B"] = JK[do_C + 1].first;
+    matrices_["LK_B"] = JK[do_C + 1].second;
+}
+
+std::vector<std::pair<SharedMatrix, SharedMatrix> > FISAPT::compute_jk(
+    const std::vector<std::pair<SharedMatrix, SharedMatrix> >& C) {
+    std::vector<SharedMatrix>& Cl = jk_->C_left();
+    std::vector<SharedMatrix>& Cr = jk_->C_right();
+
+    Cl.clear();
+    Cr.clear();
+    for (const auto& pair : C) {
+        Cl.push_back(pair.first);
+        Cr.push_back(pair.second);
+    }
+
+    jk_->compute();
+
+    std::vector<std::pair<SharedMatrix, SharedMatrix> > JK;
+    for (size_t N = 0; N < C.size(); N++) {
+        JK.emplace_back(jk_->J()[N]->clone(), jk_->K()[N]->clone());
+    }
+    return JK;
+}
+
+std::vector<std::shared_ptr<PotentialInt> > FISAPT::atomic_potential_ints(int nthreads) {
+    auto Vfact = std::make_shared<IntegralFactory>(primary_);
+    std::vector<std::shared_ptr<PotentialInt> > Vint;
+    for (int t = 0; t < nthreads; t++) {
+        Vint.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt*>(Vfact->ao_potential())));
+        Vint[t]->set_charge_field(std::make_shared<Matrix>("Zxyz", 1, 4));
+    }
+    return Vint;
+}
+
+void FISAPT::atomic_potential(std::shared_ptr<PotentialInt> Vint, double Z, const Vector3& xyz,
+                              std::shared_ptr<Matrix> V) {
+    double** Zxyzp = Vint->charge_field()->pointer();
+    Zxyzp[0][0] = Z;
+    Zxyzp[0][1] = xyz[0];
+    Zxyzp[0][2] = xyz[1];
+    Zxyzp[0][3] = xyz[2];
+    V->zero();
+    Vint->compute(V);
 }
 
 void FISAPT::scf() {
@@ -1080,27 +1133,19 @@ void FISAPT::dHF() {
     std::shared_ptr<Matrix> LD_A = linalg::doublet(LoccA, LoccA, false, true);
     std::shared_ptr<Matrix> LD_B = linalg::doublet(LoccB, LoccB, false, true);
 
-    // Get J and K from A and B HF localized orbitals while we are at it
-    std::vector<SharedMatrix>& Cl = jk_->C_left();
-    std::vector<SharedMatrix>& Cr = jk_->C_right();
-
-    const std::vector<SharedMatrix>& J = jk_->J();
-    const std::vector<SharedMatrix>& K = jk_->K();
-
-    Cl.clear();
-    Cr.clear();
-
-    Cl.push_back(LoccA);
-    Cr.push_back(LoccA);
-    Cl.push_back(LoccB);
-    Cr.push_back(LoccB);
-
-    jk_->compute();
+    // J and K from A and B HF localized orbitals, built along with the embedding in coulomb()
+    if (!matrices_.count("LJ_A")) {
+        std::vector<std::pair<SharedMatrix, SharedMatrix> > JK = compute_jk({{LoccA, LoccA}, {LoccB, LoccB}});
+        matrices_["LJ_A"] = JK[0].first;
+        matrices_["LK_A"] = JK[0].second;
+        matrices_["LJ_B"] = JK[1].first;
+        matrices_["LK_B"] = JK[1].second;
+    }
 
-    std::shared_ptr<Matrix> LJ_A(J[0]->clone());
-    std::shared_ptr<Matrix> LK_A(K[0]->clone());
-    std::shared_ptr<Matrix> LJ_B(J[1]->clone());
-    std::shared_ptr<Matrix> LK_B(K[1]->clone());
+    std::shared_ptr<Matrix> LJ_A = matrices_["LJ_A"];
+    std::shared_ptr<Matrix> LK_A = matrices_["LK_A"];
+    std::shared_ptr<Matrix> LJ_B = matrices_["LJ_B"];
+    std::shared_ptr<Matrix> LK_B = matrices_["LK_B"];
 
     // We have all the ingredients, now we build everything
     // Monomer A localised energy
@@ -1310,19 +1355,70 @@ void FISAPT::exch() {
     std::shared_ptr<Matrix> Cocc_A = matrices_["Cocc_A"];
     std::shared_ptr<Matrix> Cocc_B = matrices_["Cocc_B"];
 
-    // ==> Exchange Terms (S^2, MCBS or DCBS) <== //
+    // => T Matrix (S^\infty Terms) <= //
+
+    int na = matrices_["Cocc0A"]->colspi()[0];
+    int nb = matrices_["Cocc0B"]->colspi()[0];
+    int nbf = matrices_["Cocc0A"]->rowspi()[0];
+
+    std::shared_ptr<Matrix> Sab = linalg::triplet(matrices_["Cocc0A"], S, matrices_["Cocc0B"], true, false, false);
+    double** Sabp = Sab->pointer();
+    auto T = std::make_shared<Matrix>("T", na + nb, na + nb);
+    T->identity();
+    double** Tp = T->pointer();
+    for (int a = 0; a < na; a++) {
+        for (int b = 0; b < nb; b++) {
+            Tp[a][b + na] = Tp[b + na][a] = Sabp[a][b];
+        }
+    }
+    // T->print();
+    T->power(-1.0, 1.0E-12);
+    Tp = T->pointer();
+    for (int a = 0; a < na + nb; a++) {
+        Tp[a][a] -= 1.0;
+    }
+    // T->print();
+
+    auto C_T_A_n = std::make_shared<Matrix>("C_T_A_n", nbf, na);
+    auto C_T_B_n = std::make_shared<Matrix>("C_T_A_n", nbf, nb);
+    auto C_T_BA_n = std::make_shared<Matrix>("C_T_BA_n", nbf, nb);
+    auto C_T_AB_n = std::make_shared<Matrix>("C_T_AB_n", nbf, na);
+
+    C_DGEMM('N', 'N', nbf, na, na, 1.0, matrices_["Cocc0A"]->pointer()[0], na, &Tp[0][0], na + nb, 0.0,
+            C_T_A_n->pointer()[0], na);
+    C_DGEMM('N', 'N', nbf, nb, nb, 1.0, matrices_["Cocc0B"]->pointer()[0], nb, &Tp[na][na], na + nb, 0.0,
+            C_T_B_n->pointer()[0], nb);
+    C_DGEMM('N', 'N', nbf, nb, na, 1.0, matrices_["Cocc0A"]->pointer()[0], na, &Tp[0][na], na + nb, 0.0,
+            C_T_BA_n->pointer()[0], nb);
+    C_DGEMM('N', 'N', nbf, na, nb, 1.0, matrices_["Cocc0B"]->pointer()[0], nb, &Tp[na][0], na + nb, 0.0,
+            C_T_AB_n->pointer()[0], na);
+
+    // => J/K for all of Exch and the ExchInd perturbations of ind(), in one pass <= //
 
     std::shared_ptr<Matrix> C_O = linalg::triplet(D_B, S, Cocc_A);
-    std::vector<SharedMatrix>& Cl = jk_->C_left();
-    std::vector<SharedMatrix>& Cr = jk_->C_right();
-    const std::vector<SharedMatrix>& J = jk_->J();
-    const std::vector<SharedMatrix>& K = jk_->K();
-    Cl.clear();
-    Cr.clear();
-    Cl.push_back(Cocc_A);
-    Cr.push_back(C_O);
-    jk_->compute();
-    std::shared_ptr<Matrix> K_O = K[0];
+    std::shared_ptr<Matrix> C_AS = linalg::triplet(P_B, S, Cocc_A);
+    std::shared_ptr<Matrix> C_P_A = linalg::triplet(linalg::triplet(D_B, S, D_A), S, Cocc_B);
+    std::shared_ptr<Matrix> C_P_B = linalg::triplet(linalg::triplet(D_A, S, D_B), S, Cocc_A);
+
+    std::vector<std::pair<SharedMatrix, SharedMatrix> > JK = compute_jk({
+        {Cocc_A, C_O},                   // J/K[O]
+        {Cocc_A, C_AS},                  // K_AS
+        {matrices_["Cocc0A"], C_T_A_n},  // J/K[T^A, S^\infty]
+        {matrices_["Cocc0A"], C_T_AB_n}, // J/K[T^AB, S^\infty]
+        {Cocc_A, C_P_B},                 // J/K[P_B]
+        {Cocc_B, C_P_A},                 // J/K[P_A]
+    });
+
+    std::shared_ptr<Matrix> K_O = JK[0].second;
+
+    matrices_["J_O"] = JK[0].first;
+    matrices_["K_O"] = JK[0].second;
+    matrices_["J_P_B"] = JK[4].first;
+    matrices_["K_P_B"] = JK[4].second;
+    matrices_["J_P_A"] = JK[5].first;
+    matrices_["K_P_A"] = JK[5].second;
+
+    // ==> Exchange Terms (S^2, MCBS or DCBS) <== //
 
     double Exch10_2M = 0.0;
     std::vector<double> Exch10_2M_terms;
@@ -1354,13 +1450,7 @@ void FISAPT::exch() {
 
     // => K_AS <= //
 
-    std::shared_ptr<Matrix> C_AS = linalg::triplet(P_B, S, Cocc_A);
-    Cl.clear();
-    Cr.clear();
-    Cl.push_back(Cocc_A);
-    Cr.push_back(C_AS);
-    jk_->compute();
-    std::shared_ptr<Matrix> K_AS = K[0];
+    std::shared_ptr<Matrix> K_AS = JK[1].second;
 
     // => Accumulation <= //
 
@@ -1385,61 +1475,12 @@ void FISAPT::exch() {
 
     // ==> Exchange Terms (S^\infty, MCBS or DCBS) <== //
 
-    // => T Matrix <= //
-
-    int na = matrices_["Cocc0A"]->colspi()[0];
-    int nb = matrices_["Cocc0B"]->colspi()[0];
-    int nbf = matrices_["Cocc0A"]->rowspi()[0];
-
-    std::shared_ptr<Matrix> Sab = linalg::triplet(matrices_["Cocc0A"], S, matrices_["Cocc0B"], true, false, false);
-    double** Sabp = Sab->pointer();
-    auto T = std::make_shared<Matrix>("T", na + nb, na + nb);
-    T->identity();
-    double** Tp = T->pointer();
-    for (int a = 0; a < na; a++) {
-        for (int b = 0; b < nb; b++) {
-            Tp[a][b + na] = Tp[b + na][a] = Sabp[a][b];
-        }
-    }
-    // T->print();
-    T->power(-1.0, 1.0E-12);
-    Tp = T->pointer();
-    for (int a = 0; a < na + nb; a++) {
-        Tp[a][a] -= 1.0;
-    }
-    // T->print();
-
-    auto C_T_A_n = std::make_shared<Matrix>("C_T_A_n", nbf, na);
-    auto C_T_B_n = std::make_shared<Matrix>("C_T_A_n", nbf, nb);
-    auto C_T_BA_n = std::make_shared<Matrix>("C_T_BA_n", nbf, nb);
-    auto C_T_AB_n = std::make_shared<Matrix>("C_T_AB_n", nbf, na);
-
-    C_DGEMM('N', 'N', nbf, na, na, 1.0, matrices_["Cocc0A"]->pointer()[0], na, &Tp[0][0], na + nb, 0.0,
-            C_T_A_n->pointer()[0], na);
-    C_DGEMM('N', 'N', nbf, nb, nb, 1.0, matrices_["Cocc0B"]->pointer()[0], nb, &Tp[na][na], na + nb, 0.0,
-            C_T_B_n->pointer()[0], nb);
-    C_DGEMM('N', 'N', nbf, nb, na, 1.0, matrices_["Cocc0A"]->pointer()[0], na, &Tp[0][na], na + nb, 0.0,
-            C_T_BA_n->pointer()[0], nb);
-    C_DGEMM('N', 'N', nbf, na, nb, 1.0, matrices_["Cocc0B"]->pointer()[0], nb, &Tp[na][0], na + nb, 0.0,
-            C_T_AB_n->pointer()[0], na);
-
     // => K Terms <= //
 
-    Cl.clear();
-    Cr.clear();
-    // J/K[T^A, S^\infty]
-    Cl.push_back(matrices_["Cocc0A"]);
-    Cr.push_back(C_T_A_n);
-    // J/K[T^AB, S^\infty]
-    Cl.push_back(matrices_["Cocc0A"]);
-    Cr.push_back(C_T_AB_n);
-
-    jk_->compute();
-
-    std::shared_ptr<Matrix> J_T_A_n = J[0];
-    std::shared_ptr<Matrix> K_T_A_n = K[0];
-    std::shared_ptr<Matrix> J_T_AB_n = J[1];
-    std::shared_ptr<Matrix> K_T_AB_n = K[1];
+    std::shared_ptr<Matrix> J_T_A_n = JK[2].first;
+    std::shared_ptr<Matrix> K_T_A_n = JK[2].second;
+    std::shared_ptr<Matrix> J_T_AB_n = JK[3].first;
+    std::shared_ptr<Matrix> K_T_AB_n = JK[3].second;
 
     std::shared_ptr<Matrix> T_A_n = linalg::doublet(matrices_["Cocc0A"], C_T_A_n, false, true);
     std::shared_ptr<Matrix> T_B_n = linalg::doublet(matrices_["Cocc0B"], C_T_B_n, false, true);
@@ -1520,41 +1561,33 @@ void FISAPT::ind() {
 
     // => ExchInd perturbations <= //
 
-    std::shared_ptr<Matrix> C_O_A = linalg::triplet(D_B, S, matrices_["Cocc_A"]);
-    std::shared_ptr<Matrix> C_P_A = linalg::triplet(linalg::triplet(D_B, S, D_A), S, matrices_["Cocc_B"]);
-    std::shared_ptr<Matrix> C_P_B = linalg::triplet(linalg::triplet(D_A, S, D_B), S, matrices_["Cocc_A"]);
-
-    std::vector<SharedMatrix>& Cl = jk_->C_left();
-    std::vector<SharedMatrix>& Cr = jk_->C_right();
-    const std::vector<SharedMatrix>& J = jk_->J();
-    const std::vector<SharedMatrix>& K = jk_->K();
-
-    Cl.clear();
-    Cr.clear();
-
-    // J/K[O]
-    Cl.push_back(matrices_["Cocc_A"]);
-    Cr.push_back(C_O_A);
-    // J/K[P_B]
-    Cl.push_back(matrices_["Cocc_A"]);
-    Cr.push_back(C_P_B);
-    // J/K[P_B]
-    Cl.push_back(matrices_["Cocc_B"]);
-    Cr.push_back(C_P_A);
-
-    // => Compute the JK matrices <= //
-
-    jk_->compute();
-
-    // => Unload the JK Object <= //
+    // Built with the Exch J/K in exch()
+    if (!matrices_.count("K_P_A")) {
+        std::shared_ptr<Matrix> C_O_A = linalg::triplet(D_B, S, matrices_["Cocc_A"]);
+        std::shared_ptr<Matrix> C_P_A = linalg::triplet(linalg::triplet(D_B, S, D_A), S, matrices_["Cocc_B"]);
+        std::shared_ptr<Matrix> C_P_B = linalg::triplet(linalg::triplet(D_A, S, D_B), S, matrices_["Cocc_A"]);
+
+        std::vector<std::pair<SharedMatrix, SharedMatrix> > JK = compute_jk({
+            {matrices_["Cocc_A"], C_O_A},  // J/K[O]
+            {matrices_["Cocc_A"], C_P_B},  // J/K[P_B]
+            {matrices_["Cocc_B"], C_P_A},  // J/K[P_A]
+        });
+
+        matrices_["J_O"] = JK[0].first;
+        matrices_["K_O"] = JK[0].second;
+        matrices_["J_P_B"] = JK[1].first;
+        matrices_["K_P_B"] = JK[1].second;
+        matrices_["J_P_A"] = JK[2].first;
+        matrices_["K_P_A"] = JK[2].second;
+    }
 
-    std::shared_ptr<Matrix> J_O = J[0];
-    std::shared_ptr<Matrix> J_P_B = J[1];
-    std::shared_ptr<Matrix> J_P_A = J[2];
+    std::shared_ptr<Matrix> J_O = matrices_["J_O"];
+    std::shared_ptr<Matrix> J_P_B = matrices_["J_P_B"];
+    std::shared_ptr<Matrix> J_P_A = matrices_["J_P_A"];
 
-    std::shared_ptr<Matrix> K_O = K[0];
-    std::shared_ptr<Matrix> K_P_B = K[1];
-    std::shared_ptr<Matrix> K_P_A = K[2];
+    std::shared_ptr<Matrix> K_O = matrices_["K_O"];
+    std::shared_ptr<Matrix> K_P_B = matrices_["K_P_B"];
+    std::shared_ptr<Matrix> K_P_A = matrices_["K_P_A"];
 
     // ==> Generalized ESP (Flat and Exchange) <== //
 
@@ -1753,13 +1786,6 @@ void FISAPT::ind() {
             scalars_["HF"] - scalars_["Elst10,r"] - scalars_["Exch10"] - scalars_["Ind20,r"] - scalars_["Exch-Ind20,r"];
     }
 
-    // => Stash for ExchDisp <= //
-
-    matrices_["J_O"] = J_O;
-    matrices_["K_O"] = K_O;
-    matrices_["J_P_A"] = J_P_A;
-    matrices_["J_P_B"] = J_P_B;
-
     // => Kill the JK Object <= //
 
     jk_.reset();
@@ -3189,52 +3215,58 @@ void FISAPT::felst() {
 
     // => Nuclear Part (PITA) <= //
 
-    auto Zxyz2 = std::make_shared<Matrix>("Zxyz", 1, 4);
-    double** Zxyz2p = Zxyz2->pointer();
-    auto Vfact2 = std::make_shared<IntegralFactory>(primary_);
-    std::shared_ptr<PotentialInt> Vint2(static_cast<PotentialInt*>(Vfact2->ao_potential()));
-    Vint2->set_charge_field(Zxyz2);
-    auto Vtemp2 = std::make_shared<Matrix>("Vtemp2", nn, nn);
+    // The atoms are independent, each thread computes the potential of its own atoms
+    std::vector<std::shared_ptr<PotentialInt> > Vint2 = atomic_potential_ints(nT);
+    std::vector<std::shared_ptr<Matrix> > Vtemp2;
+    for (int t = 0; t < nT; t++) {
+        Vtemp2.push_back(std::make_shared<Matrix>("Vtemp2", nn, nn));
+    }
+    std::shared_ptr<Matrix> LoccA = matrices_["Locc0A"];
+    std::shared_ptr<Matrix> LoccB = matrices_["Locc0B"];
 
     // => A <-> b <= //
 
+    double Elst10_Ab = 0.0;
+#pragma omp parallel for schedule(dynamic) num_threads(nT) reduction(+ : Elst10_Ab)
     for (int A = 0; A < nA; A++) {
         if (ZAp[A] == 0.0) continue;
-        Vtemp2->zero();
-        Zxyz2p[0][0] = ZAp[A];
-        Zxyz2p[0][1] = mol->x(A);
-        Zxyz2p[0][2] = mol->y(A);
-        Zxyz2p[0][3] = mol->z(A);
-        Vint2->compute(Vtemp2);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        atomic_potential(Vint2[thread], ZAp[A], mol->xyz(A), Vtemp2[thread]);
         std::shared_ptr<Matrix> Vbb =
-            linalg::triplet(matrices_["Locc0B"], Vtemp2, matrices_["Locc0B"], true, false, false);
+            linalg::triplet(LoccB, Vtemp2[thread], LoccB, true, false, false);
         double** Vbbp = Vbb->pointer();
         for (int b = 0; b < nb; b++) {
             double E = 2.0 * Vbbp[b][b];
-            Elst10_terms[1] += E;
+            Elst10_Ab += E;
             Ep[A][b + nB] += E;
         }
     }
+    Elst10_terms[1] += Elst10_Ab;
 
     // => a <-> B <= //
 
+    double Elst10_aB = 0.0;
+#pragma omp parallel for schedule(dynamic) num_threads(nT) reduction(+ : Elst10_aB)
     for (int B = 0; B < nB; B++) {
         if (ZBp[B] == 0.0) continue;
-        Vtemp2->zero();
-        Zxyz2p[0][0] = ZBp[B];
-        Zxyz2p[0][1] = mol->x(B);
-        Zxyz2p[0][2] = mol->y(B);
-        Zxyz2p[0][3] = mol->z(B);
-        Vint2->compute(Vtemp2);
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        atomic_potential(Vint2[thread], ZBp[B], mol->xyz(B), Vtemp2[thread]);
         std::shared_ptr<Matrix> Vaa =
-            linalg::triplet(matrices_["Locc0A"], Vtemp2, matrices_["Locc0A"], true, false, false);
+            linalg::triplet(LoccA, Vtemp2[thread], LoccA, true, false, false);
         double** Vaap = Vaa->pointer();
         for (int a = 0; a < na; a++) {
             double E = 2.0 * Vaap[a][a];
-            Elst10_terms[0] += E;
+            Elst10_aB += E;
             Ep[a + nA][B] += E;
         }
     }
+    Elst10_terms[0] += Elst10_aB;
 
     // Prepare DFHelper object for the next module
     dfh_->clear_spaces();
@@ -3399,11 +3431,16 @@ void FISAPT::fexch() {
     auto E_exch3 = std::make_shared<Matrix>("E_exch [a <x-x> b]", na, nb);
     double** E_exch3p = E_exch3->pointer();
 
+    // Both (b, a) slices are read with one call per a, rather than one call per (a, b) pair
+    auto TbQ2 = std::make_shared<Matrix>("TbQ2", nb, nQ);
+    double** TbQ2p = TbQ2->pointer();
+
     for (size_t a = 0; a < na; a++) {
         dfh_->fill_tensor("Bab", TbQ, {a, a + 1});
-        for (size_t b = 0; b < nb; b++) {
-            dfh_->fill_tensor("Bba", TaQ, {b, b + 1}, {a, a + 1});
-            E_exch3p[a][b] -= 2.0 * C_DDOT(nQ, TbQp[b], 1, TaQp[0], 1);
+        dfh_->fill_tensor("Bba", TbQ2, {0, (size_t)nb}, {a, a + 1});
+#pragma omp parallel for num_threads(nT)
+        for (int b = 0; b < nb; b++) {
+            E_exch3p[a][b] -= 2.0 * C_DDOT(nQ, TbQp[b], 1, TbQ2p[b], 1);
         }
     }
 
@@ -3502,36 +3539,48 @@ void FISAPT::find() {
 
     // => Nuclear Part (PITA) <= //
 
-    auto Zxyz2 = std::make_shared<Matrix>("Zxyz", 1, 4);
-    double** Zxyz2p = Zxyz2->pointer();
-    auto Vfact2 = std::make_shared<IntegralFactory>(primary_);
-    std::shared_ptr<PotentialInt> Vint2(static_cast<PotentialInt*>(Vfact2->ao_potential()));
-    Vint2->set_charge_field(Zxyz2);
-    auto Vtemp2 = std::make_shared<Matrix>("Vtemp2", nn, nn);
+    // The potentials of nT atoms at a time are computed in parallel and then written in order
+    std::vector<std::shared_ptr<PotentialInt> > Vint2 = atomic_potential_ints(nT);
+    std::vector<std::shared_ptr<Matrix> > Vtemp2;
+    for (int t = 0; t < nT; t++) {
+        Vtemp2.push_back(std::make_shared<Matrix>("Vtemp2", nn, nn));
+    }
+    std::vector<std::shared_ptr<Matrix> > Vmo(nT);
 
     double* ZAp = vectors_["ZA"]->pointer();
-    for (size_t A = 0; A < nA; A++) {
-        Vtemp2->zero();
-        Zxyz2p[0][0] = ZAp[A];
-        Zxyz2p[0][1] = mol->x(A);
-        Zxyz2p[0][2] = mol->y(A);
-        Zxyz2p[0][3] = mol->z(A);
-        Vint2->compute(Vtemp2);
-        std::shared_ptr<Matrix> Vbs = linalg::triplet(Cocc_B, Vtemp2, Cvir_B, true, false, false);
-        dfh_->write_disk_tensor("WAbs", Vbs, {A, A + 1});
+    for (size_t A0 = 0; A0 < nA; A0 += nT) {
+        size_t nA0 = std::min((size_t)nT, nA - A0);
+#pragma omp parallel for schedule(dynamic) num_threads(nT)
+        for (size_t dA = 0; dA < nA0; dA++) {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            atomic_potential(Vint2[thread], ZAp[A0 + dA], mol->xyz(A0 + dA), Vtemp2[thread]);
+            Vmo[dA] = linalg::triplet(Cocc_B, Vtemp2[thread], Cvir_B, true, false, false);
+        }
+        for (size_t dA = 0; dA < nA0; dA++) {
+            dfh_->write_disk_tensor("WAbs", Vmo[dA], {A0 + dA, A0 + dA + 1});
+        }
     }
 
     double* ZBp = vectors_["ZB"]->pointer();
-    for (size_t B = 0; B < nB; B++) {
-        Vtemp2->zero();
-        Zxyz2p[0][0] = ZBp[B];
-        Zxyz2p[0][1] = mol->x(B);
-        Zxyz2p[0][2] = mol->y(B);
-        Zxyz2p[0][3] = mol->z(B);
-        Vint2->compute(Vtemp2);
-        std::shared_ptr<Matrix> Var = linalg::triplet(Cocc_A, Vtemp2, Cvir_A, true, false, false);
-        dfh_->write_disk_tensor("WBar", Var, {B, B + 1});
+    for (size_t B0 = 0; B0 < nB; B0 += nT) {
+        size_t nB0 = std::min((size_t)nT, nB - B0);
+#pragma omp parallel for schedule(dynamic) num_threads(nT)
+        for (size_t dB = 0; dB < nB0; dB++) {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            atomic_potential(Vint2[thread], ZBp[B0 + dB], mol->xyz(B0 + dB), Vtemp2[thread]);
+            Vmo[dB] = linalg::triplet(Cocc_A, Vtemp2[thread], Cvir_A, true, false, false);
+        }
+        for (size_t dB = 0; dB < nB0; dB++) {
+            dfh_->write_disk_tensor("WBar", Vmo[dB], {B0 + dB, B0 + dB + 1});
+        }
     }
+    Vmo.clear();
 
     // ==> DFHelper Setup (JKFIT Type, in Full Basis) <== //
 
@@ -31,17 +31,21 @@
 
 #include "psi4/libmints/typedefs.h"
 #include "psi4/libmints/basisset.h"
+#include "psi4/libmints/vector3.h"
 #include "psi4/libmints/wavefunction.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
 #include <map>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace psi {
 
 class JK;
 class BasisSet;
 class DFHelper;
+class PotentialInt;
 
 namespace fisapt {
 
@@ -84,6 +88,17 @@ class FISAPT {
     /// Helper to extract columns from a matrix
     static std::shared_ptr<Matrix> extract_columns(const std::vector<int>& cols, std::shared_ptr<Matrix> A);
 
+    /// J and K of each (C_left, C_right) pair in a single JK::compute(), so requests that are known
+    /// together share one pass over the integrals. The results are copies, as the JK object reuses
+    /// its output matrices from one call to the next.
+    std::vector<std::pair<std::shared_ptr<Matrix>, std::shared_ptr<Matrix> > > compute_jk(
+        const std::vector<std::pair<std::shared_ptr<Matrix>, std::shared_ptr<Matrix> > >& C);
+    /// One single-charge potential integral object per thread
+    std::vector<std::shared_ptr<PotentialInt> > atomic_potential_ints(int nthreads);
+    /// V = potential integrals of a charge Z at xyz
+    static void atomic_potential(std::shared_ptr<PotentialInt> Vint, double Z, const Vector3& xyz,
+                                 std::shared_ptr<Matrix> V);
+
    public:
     /// Initialize an FISAPT object with an SCF reference
     FISAPT(std::shared_ptr<Wavefunction> scf);
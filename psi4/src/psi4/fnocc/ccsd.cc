@@ -260,6 +260,9 @@ double CoupledCluster::compute_energy() {
         }
     }
 
+    // flush in-core disk entries; triples reads what it needs from disk
+    resident.release();
+
     // free some memory before triples
     free(integrals);
     free(w1);
@@ -290,7 +293,7 @@ double CoupledCluster::compute_energy() {
             tb = buffer.data();
             auto psio = std::make_shared<PSIO>();
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tb[0], o * o * v * v * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tb[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
         }
 
@@ -433,13 +436,13 @@ PsiReturnType CoupledCluster::CCSDIterations() {
     // zero residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
     memset((void *)tempt, '\0', o * o * v * v * sizeof(double));
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     if (t2_on_disk || options_.get_bool("NAT_ORBS")) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
-        psio->write_entry(PSIF_DCC_T2, "t1", (char *)&tempt[0], o * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t1", (char *)&tempt[0], o * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     }
 
@@ -871,6 +874,22 @@ void CoupledCluster::AllocateMemory() {
     // DIIS:
     diisvec = (double *)malloc(sizeof(double) * (maxdiis + 1));
     memset((void *)diisvec, '\0', (maxdiis + 1) * sizeof(double));
+
+    // keep the most frequently accessed disk entries in core with whatever memory is left.
+    // entries that do not fit stay on disk.
+    double left = memory - total_memory * 1024. * 1024. - 8. * (maxdiis + 1);
+    resident.set_budget(left > 0.0 ? (size_t)left : 0);
+    long int nresident = 0;
+    nresident += resident.add(PSIF_DCC_R2, "residual", oovv * sizeof(double));
+    if (t2_on_disk) nresident += resident.add(PSIF_DCC_T2, "t2", oovv * sizeof(double));
+    nresident += resident.add(PSIF_DCC_IAJB, "E2iajb", oovv * sizeof(double));
+    nresident += resident.add(PSIF_DCC_IJAB, "E2ijab", oovv * sizeof(double));
+    nresident += resident.add(PSIF_DCC_TEMP, "temporary_K", oovv * sizeof(double));
+    nresident += resident.add(PSIF_DCC_TEMP, "temporary_J", oovv * sizeof(double));
+    nresident += resident.add(PSIF_DCC_IJAK, "E2ijak", o * o * o * v * sizeof(double));
+    nresident += resident.add(PSIF_DCC_IJAK2, "E2ijak2", o * o * o * v * sizeof(double));
+    nresident += resident.add(PSIF_DCC_IJKL, "E2ijkl", o * o * o * o * sizeof(double));
+    outfile->Printf("  Disk entries held in core: %ld\n", nresident);
 }
 
 /*===================================================================
@@ -888,11 +907,11 @@ void CoupledCluster::CPU_t1_vmeai(CCTaskParams params) {
     long int i, a, m, e, id, one = 1;
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IJAB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAB, "E2ijab", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAB, "E2ijab", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IJAB, 1);
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     C_DAXPY(o * o * v * v, -2.0, integrals, 1, tempv, 1);
 
@@ -917,7 +936,7 @@ void CoupledCluster::CPU_t1_vmeni(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -931,7 +950,7 @@ void CoupledCluster::CPU_t1_vmeni(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IJAK, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char *)&tempv[0], o * o * o * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAK, "E2ijak", (char *)&tempv[0], o * o * o * v * sizeof(double));
     psio->close(PSIF_DCC_IJAK, 1);
     F_DGEMM('t', 'n', o, v, o * o * v, 1.0, tempv, o * o * v, tempt, o * o * v, 1.0, w1, o);
     psio.reset();
@@ -949,7 +968,7 @@ void CoupledCluster::CPU_t1_vmaef(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1002,12 +1021,12 @@ void CoupledCluster::CPU_I1ab(CCTaskParams params) {
     // build I1(a,b)
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1073,7 +1092,7 @@ void CoupledCluster::CPU_I1ab(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1090,7 +1109,7 @@ void CoupledCluster::CPU_I1ab(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -1099,7 +1118,7 @@ void CoupledCluster::CPU_I1ab(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     // use I1(a,b) for singles residual - 1st contribution to w1. (n^3)
@@ -1124,14 +1143,14 @@ void CoupledCluster::CPU_I2p_abci_refactored_term2(CCTaskParams params) {
 
     // now build and use intermediate:
     psio->open(PSIF_DCC_IJAB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAB, "E2ijab", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAB, "E2ijab", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IJAB, 1);
     F_DGEMM('n', 'n', o, o2v, v, -1.0, t1, o, tempv, v, 0.0, tempt, o);
     F_DGEMM('n', 'n', o2v, v, o, 1.0, tempt, o2v, t1, o, 0.0, tempv, o2v);
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -1140,7 +1159,7 @@ void CoupledCluster::CPU_I2p_abci_refactored_term2(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -1159,7 +1178,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
     // build I1(i,a). n^4
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     C_DCOPY(o * o * v * v, integrals, 1, tempv, 1);
     for (i = 0; i < o; i++) {
@@ -1175,7 +1194,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1202,7 +1221,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
     // only n^4
     if (isccsd) {
         psio->open(PSIF_DCC_IJAK, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char *)&tempt[0], o * o * o * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IJAK, "E2ijak", (char *)&tempt[0], o * o * o * v * sizeof(double));
         psio->close(PSIF_DCC_IJAK, 1);
         id = 0;
         for (i = 0; i < o; i++) {
@@ -1229,7 +1248,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1245,7 +1264,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -1255,7 +1274,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -1272,7 +1291,7 @@ void CoupledCluster::I2ijkl(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -1290,7 +1309,7 @@ void CoupledCluster::I2ijkl(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     for (j = 0; j < o; j++) {
         for (i = 0; i < o; i++) {
@@ -1301,13 +1320,13 @@ void CoupledCluster::I2ijkl(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IJKL, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJKL, "E2ijkl", (char *)&integrals[0], o * o * o * o * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJKL, "E2ijkl", (char *)&integrals[0], o * o * o * o * sizeof(double));
 
     psio->close(PSIF_DCC_IJKL, 1);
     F_DGEMM('n', 'n', o * o, o * o, v * v, 1.0, tempt, o * o, tempv, v * v, 1.0, integrals, o * o);
     if (isccsd) {
         psio->open(PSIF_DCC_IJAK, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char *)&tempv[0], o * o * o * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IJAK, "E2ijak", (char *)&tempv[0], o * o * o * v * sizeof(double));
         psio->close(PSIF_DCC_IJAK, 1);
         F_DGEMM('n', 'n', o, o * o * o, v, 2.0, t1, o, tempv, v, 1.0, integrals, o);
     }
@@ -1315,7 +1334,7 @@ void CoupledCluster::I2ijkl(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -1324,7 +1343,7 @@ void CoupledCluster::I2ijkl(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -1343,7 +1362,7 @@ void CoupledCluster::I2piajk(CCTaskParams params) {
     if (isccsd) {
         if (t2_on_disk) {
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
         } else {
             C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -1360,7 +1379,7 @@ void CoupledCluster::I2piajk(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IJAK2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAK2, "E2ijak2", (char *)&tempv[0], o * o * o * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAK2, "E2ijak2", (char *)&tempv[0], o * o * o * v * sizeof(double));
     psio->close(PSIF_DCC_IJAK2, 1);
 
     if (isccsd) {
@@ -1380,7 +1399,7 @@ void CoupledCluster::I2piajk(CCTaskParams params) {
 
         // this used to be part of I2p(ab,ci) ... see notes ...
         psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_IAJB, 1);
         F_DGEMM('t', 't', o * o * v, o, v, 1.0, integrals, v, t1, o, 0.0, tempt, o * o * v);
         for (j = 0; j < o; j++) {
@@ -1398,7 +1417,7 @@ void CoupledCluster::I2piajk(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempt, 1, tempv, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -1407,7 +1426,7 @@ void CoupledCluster::I2piajk(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -1423,7 +1442,7 @@ void CoupledCluster::Vabcd1(CCTaskParams params) {
     psio_address addr;
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -1467,7 +1486,7 @@ void CoupledCluster::Vabcd1(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -1478,7 +1497,7 @@ void CoupledCluster::Vabcd1(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -1495,7 +1514,7 @@ void CoupledCluster::Vabcd2(CCTaskParams params) {
     psio_address addr;
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -1539,7 +1558,7 @@ void CoupledCluster::Vabcd2(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempv[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             if (a > b)
@@ -1574,7 +1593,7 @@ void CoupledCluster::K(CCTaskParams params) {
     psio_address addr;
 
     psio->open(PSIF_DCC_IJAB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAB, "E2ijab", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAB, "E2ijab", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IJAB, 1);
 
     // o^2v^3 work
@@ -1602,7 +1621,7 @@ void CoupledCluster::K(CCTaskParams params) {
 
         // stick o^3v^2 work on first tile
         psio->open(PSIF_DCC_IJAK2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IJAK2, "E2ijak2", (char *)&integrals[0], o * o * o * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IJAK2, "E2ijak2", (char *)&integrals[0], o * o * o * v * sizeof(double));
         psio->close(PSIF_DCC_IJAK2, 1);
         // TODO: this was a problem with cuda 3.2 vs 4.0
         F_DGEMM('t', 'n', o * o * v, v, o, -1.0, integrals, o, t1, o, 0.0, tempv, o * o * v);
@@ -1620,13 +1639,13 @@ void CoupledCluster::K(CCTaskParams params) {
     // before adding o^3v^3 term, write this part of I2(ia,jb) to disk:
     // written as ... ibja (i think..)
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_NEW);
-    psio->write_entry(PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
 
     // o^3v^3 part
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -1643,7 +1662,7 @@ void CoupledCluster::K(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     for (i = 0; i < o; i++) {
         for (b = 0; b < v; b++) {
@@ -1653,7 +1672,7 @@ void CoupledCluster::K(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
     F_DGEMM('n', 'n', o * v, o * v, o * v, -0.5, integrals, o * v, tempv, o * v, 1.0, tempt, o * v);
 
@@ -1661,7 +1680,7 @@ void CoupledCluster::K(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -1693,7 +1712,7 @@ void CoupledCluster::K(CCTaskParams params) {
         }
     }
 
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -1711,12 +1730,12 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
     // o^2v^3 contribution to intermediate
     if (isccsd) {
         psio->open(PSIF_DCC_IJAK, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char *)&integrals[0], o * o * o * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IJAK, "E2ijak", (char *)&integrals[0], o * o * o * v * sizeof(double));
         psio->close(PSIF_DCC_IJAK, 1);
         F_DGEMM('n', 'n', o * o * v, v, o, -1.0, integrals, o * o * v, t1, o, 0.0, tempt, o * o * v);
 
         psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_IAJB, 1);
         for (i = 0; i < o; i++) {
             for (b = 0; b < v; b++) {
@@ -1728,19 +1747,19 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
         }
     } else {
         psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_IAJB, 1);
     }
     // contribute to intermediate
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_OLD);
-    psio->write_entry(PSIF_DCC_TEMP, "temporary_J", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_TEMP, "temporary_J", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
 
     // the only o^3v^3 part of 2J-K
     // 1/2 ( 2(ib|me) - (ie|mb) ) ( t(ae,jm) - 1/2t(ea,jm) - t(e,j)t(a,m) )
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     C_DCOPY(o * o * v * v, tempt, 1, integrals, 1);
     for (i = 0, id = 0; i < o; i++) {
@@ -1754,7 +1773,7 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
     }
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempt;
     }
@@ -1812,7 +1831,7 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
     // contribute to residual from I2p_abci_refactored_term1 ... if we know
     // this is the first diagram, we don't need to read in the old residual.
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&integrals[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -1823,18 +1842,18 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     // contribute to intermediate
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_TEMP, "temporary_J", (char *)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_TEMP, "temporary_J", (char *)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
     C_DAXPY(o * o * v * v, 1.0, tempt, 1, tempv, 1);
 
     // term from K stored as ibja
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_TEMP, "temporary_K", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
     // contribute K pieces to intermediate
     for (j = 0, id = 0; j < o; j++) {
@@ -1850,7 +1869,7 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
     // use I2iabj
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -1867,7 +1886,7 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -1878,7 +1897,7 @@ void CoupledCluster::TwoJminusK(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -1896,7 +1915,7 @@ void CoupledCluster::UpdateT2(long int iter) {
 
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
 // we still have the residual in memory in tempv
@@ -1924,7 +1943,7 @@ void CoupledCluster::UpdateT2(long int iter) {
     // error vectors for diis are in tempv:
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempv, 1);
@@ -1932,7 +1951,7 @@ void CoupledCluster::UpdateT2(long int iter) {
     C_DAXPY(o * o * v * v, -1.0, tempt, 1, tempv, 1);
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tempt, 1, tb, 1);
@@ -1973,11 +1992,11 @@ void CoupledCluster::SCS_CCSD() {
     double osenergy = 0.0;
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -2011,11 +2030,11 @@ void CoupledCluster::SCS_MP2() {
     double osenergy = 0.0;
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -2047,11 +2066,11 @@ double CoupledCluster::CheckEnergy() {
     double energy = 0.0;
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -2184,11 +2203,11 @@ void CoupledCluster::MP4_SDQ() {
 
         // V|2> for S and D parts of mp4
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->write_entry(PSIF_DCC_T2, "second", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "second", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         if (t2_on_disk) {
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->write_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+            resident.write_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
         } else {
             C_DCOPY(o * o * v * v, tempt, 1, tb, 1);
@@ -2204,7 +2223,7 @@ void CoupledCluster::MP4_SDQ() {
             tb = tempt;
         }
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char *)&tb[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char *)&tb[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         UpdateT2_mp4(2);
         outfile->Printf("done.\n");
@@ -2292,10 +2311,10 @@ void CoupledCluster::MP4_SDQ() {
     } else {
         // guess for cc/qci should be |1> + |2>
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char *)&tb[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char *)&tb[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "second", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "second", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         C_DAXPY(o * o * v * v, 1.0, tempt, 1, tb, 1);
     }
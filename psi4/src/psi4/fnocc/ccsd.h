@@ -37,11 +37,58 @@
 #include "psi4/psifiles.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 PSI_API long int Position(long int i, long int j);
 
 namespace psi {
 namespace fnocc {
 
+/// keeps whole psio entries (t2, the residual, the o^2v^2 integrals, ...) in
+/// core when the memory budget allows.  read_entry/write_entry on a resident
+/// entry become memcpy's; any other entry goes straight to disk.  modified
+/// entries are written back by release().
+class ResidentEntries {
+   public:
+    ResidentEntries();
+    ~ResidentEntries();
+
+    /// set the number of bytes that resident entries may occupy
+    void set_budget(size_t bytes);
+
+    /// keep (unit,key) of the given size in core if it still fits in the budget
+    bool add(size_t unit, const char *key, size_t size);
+
+    /// drop-in replacements for PSIO::read_entry/write_entry.  the unit must
+    /// be open, exactly as for the PSIO calls.
+    void read_entry(std::shared_ptr<PSIO> psio, size_t unit, const char *key, char *buffer, size_t size);
+    void write_entry(std::shared_ptr<PSIO> psio, size_t unit, const char *key, char *buffer, size_t size);
+
+    /// write modified entries back to disk, print statistics, and free all memory
+    void release();
+
+   protected:
+    struct Entry {
+        size_t size;
+        std::vector<char> data;
+        bool valid;
+        bool dirty;
+    };
+    std::map<std::pair<size_t, std::string>, Entry> entries_;
+
+    /// write back a modified entry (unit already open)
+    void write_back(std::shared_ptr<PSIO> psio, size_t unit, const std::string &key, Entry &entry);
+
+    size_t budget_;
+    size_t used_;
+    size_t bytes_avoided_;
+    size_t bytes_written_back_;
+};
+
 class CoupledCluster : public Wavefunction {
    public:
     CoupledCluster(std::shared_ptr<Wavefunction> reference_wavefunction, Options &options);
@@ -59,6 +106,9 @@ class CoupledCluster : public Wavefunction {
     /// is t2 on disk or held in main memory?
     bool t2_on_disk;
 
+    /// disk entries held in core with whatever memory is left after AllocateMemory()
+    ResidentEntries resident;
+
     /// which cc method?
     bool mp2_only, mp3_only, mp4_only, isccsd;
     int ccmethod;
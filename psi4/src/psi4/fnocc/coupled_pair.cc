@@ -152,6 +152,7 @@ double CoupledPair::compute_energy() {
     WriteBanner();
     AllocateMemory();
     status = CEPAIterations();
+    resident.release();
     tstop();
 
     // mp2 energy
@@ -272,12 +273,12 @@ PsiReturnType CoupledPair::CEPAIterations() {
     // zero residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_NEW);
     memset((void *)tempt, '\0', o * o * v * v * sizeof(double));
-    psio->write_entry(PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char *)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_NEW);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     }
     pair_energy = (double *)malloc(o * o * sizeof(double));
@@ -479,12 +480,12 @@ void CoupledPair::PairEnergy() {
 
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempt;
     }
@@ -512,7 +513,7 @@ void CoupledPair::UpdateT2() {
 
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     double fac = 1.0;
@@ -563,7 +564,7 @@ void CoupledPair::UpdateT2() {
     // error vectors for diis are in tempv:
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempv, 1);
@@ -571,7 +572,7 @@ void CoupledPair::UpdateT2() {
     C_DAXPY(o * o * v * v, -1.0, tempt, 1, tempv, 1);
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tempt, 1, tb, 1);
@@ -630,12 +631,12 @@ void CoupledPair::SCS_CEPA() {
 
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -669,12 +670,12 @@ double CoupledPair::VariationalEnergy() {
     // (ai|bj)
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempt;
     }
@@ -748,12 +749,12 @@ double CoupledPair::CheckEnergy() {
 
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char *)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char *)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -57,7 +57,7 @@ void CoupledCluster::DIIS(double* c, long int nvec, long int n, int replace_diis
     psio->open(PSIF_DCC_EVEC, PSIO_OPEN_OLD);
 
     // add row to matrix, don't build the whole thing.
-    psio->read_entry(PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
     for (long int i = 0; i < nvec; i++) {
         for (long int j = 0; j < nvec; j++) {
             A[i * nvar + j] = temp[i * maxdiis + j];
@@ -67,10 +67,10 @@ void CoupledCluster::DIIS(double* c, long int nvec, long int n, int replace_diis
     if (nvec <= 3) {
         for (long int i = 0; i < nvec; i++) {
             sprintf(evector, "evector%li", i + 1);
-            psio->read_entry(PSIF_DCC_EVEC, evector, (char*)&tempt[0], n * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_EVEC, evector, (char*)&tempt[0], n * sizeof(double));
             for (long int j = i; j < nvec; j++) {
                 sprintf(evector, "evector%li", j + 1);
-                psio->read_entry(PSIF_DCC_EVEC, evector, (char*)&tempv[0], n * sizeof(double));
+                resident.read_entry(psio, PSIF_DCC_EVEC, evector, (char*)&tempv[0], n * sizeof(double));
                 double sum = C_DDOT(n, tempt, 1, tempv, 1);
                 A[i * nvar + j] = sum;
                 A[j * nvar + i] = sum;
@@ -84,10 +84,10 @@ void CoupledCluster::DIIS(double* c, long int nvec, long int n, int replace_diis
             i = replace_diis_iter - 1;
         }
         sprintf(evector, "evector%li", i + 1);
-        psio->read_entry(PSIF_DCC_EVEC, evector, (char*)&tempt[0], n * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_EVEC, evector, (char*)&tempt[0], n * sizeof(double));
         for (long int j = 0; j < nvec; j++) {
             sprintf(evector, "evector%li", j + 1);
-            psio->read_entry(PSIF_DCC_EVEC, evector, (char*)&tempv[0], n * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_EVEC, evector, (char*)&tempv[0], n * sizeof(double));
             double sum = C_DDOT(n, tempt, 1, tempv, 1);
             A[i * nvar + j] = sum;
             A[j * nvar + i] = sum;
@@ -107,7 +107,7 @@ void CoupledCluster::DIIS(double* c, long int nvec, long int n, int replace_diis
             temp[i * maxdiis + j] = A[i * nvar + j];
         }
     }
-    psio->write_entry(PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
     free(temp);
     psio->close(PSIF_DCC_EVEC, 1);
     free(evector);
@@ -150,7 +150,7 @@ void CoupledCluster::DIISOldVector(long int iter, int diis_iter, int replace_dii
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -180,14 +180,14 @@ double CoupledCluster::DIISErrorVector(int diis_iter, int replace_diis_iter, int
         psio->open(PSIF_DCC_EVEC, PSIO_OPEN_NEW);
         double* temp = (double*)malloc(maxdiis * maxdiis * sizeof(double));
         memset((void*)temp, '\0', maxdiis * maxdiis * sizeof(double));
-        psio->write_entry(PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_EVEC, "error matrix", (char*)&temp[0], maxdiis * maxdiis * sizeof(double));
         free(temp);
     } else {
         psio->open(PSIF_DCC_EVEC, PSIO_OPEN_OLD);
     }
 
     nrm = C_DNRM2(arraysize + o * v, tempv, 1);
-    psio->write_entry(PSIF_DCC_EVEC, evector, (char*)&tempv[0], (arraysize + o * v) * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_EVEC, evector, (char*)&tempv[0], (arraysize + o * v) * sizeof(double));
 
     psio->close(PSIF_DCC_EVEC, 1);
     psio.reset();
@@ -238,7 +238,7 @@ void CoupledCluster::DIISNewAmplitudes(int diis_iter, int& replace_diis_iter) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_NEW);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char*)&tb[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char*)&tb[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     }
 
@@ -50,11 +50,11 @@ void CoupledCluster::CPU_t1_vmeai_linear(CCTaskParams params) {
     long int i, a, m, e, id, one = 1;
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IJAB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAB, "E2ijab", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAB, "E2ijab", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IJAB, 1);
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     C_DAXPY(o * o * v * v, -2.0, integrals, 1, tempv, 1);
 
@@ -77,7 +77,7 @@ void CoupledCluster::CPU_t1_vmeni_linear(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -93,7 +93,7 @@ void CoupledCluster::CPU_t1_vmeni_linear(CCTaskParams params) {
         }
     }
     psio->open(PSIF_DCC_IJAK, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAK, "E2ijak", (char*)&tempv[0], o * o * o * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAK, "E2ijak", (char*)&tempv[0], o * o * o * v * sizeof(double));
     psio->close(PSIF_DCC_IJAK, 1);
     F_DGEMM('t', 'n', o, v, o * o * v, -1.0, tempv, o * o * v, tempt, o * o * v, 1.0, w1, o);
     psio.reset();
@@ -108,7 +108,7 @@ void CoupledCluster::CPU_t1_vmaef_linear(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -177,7 +177,7 @@ void CoupledCluster::CPU_I2p_abci_refactored_term1_linear(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             C_DAXPY(o * o, 1.0, tempt + b * v * o * o + a * o * o, 1, tempv + a * v * o * o + b * o * o, 1);
@@ -190,7 +190,7 @@ void CoupledCluster::CPU_I2p_abci_refactored_term1_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -238,7 +238,7 @@ void CoupledCluster::UpdateT2_mp4(long int iter) {
     if (iter == 1) {
         if (t2_on_disk) {
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
             tb = tempt;
         }
@@ -261,7 +261,7 @@ void CoupledCluster::UpdateT2_mp4(long int iter) {
     } else if (iter == 2) {
         if (t2_on_disk) {
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
             tb = tempt;
         }
@@ -284,7 +284,7 @@ void CoupledCluster::UpdateT2_mp4(long int iter) {
     } else if (iter == 3) {
         if (t2_on_disk) {
             psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-            psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+            resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
             psio->close(PSIF_DCC_T2, 1);
             tb = tempt;
         }
@@ -307,7 +307,7 @@ void CoupledCluster::UpdateT2_mp4(long int iter) {
     }
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (iter == 0) {
@@ -346,8 +346,8 @@ void CoupledCluster::UpdateT2_mp4(long int iter) {
         emp2 = emp2_os + emp2_ss;
 
         psio->open(PSIF_DCC_T2, PSIO_OPEN_NEW);
-        psio->write_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
-        psio->write_entry(PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.write_entry(psio, PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
 
         if (!t2_on_disk) C_DCOPY(o * o * v * v, tempt, 1, tb, 1);
@@ -384,21 +384,21 @@ void CoupledCluster::I2ijkl_linear(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
     }
 
     psio->open(PSIF_DCC_IJKL, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJKL, "E2ijkl", (char*)&integrals[0], o * o * o * o * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJKL, "E2ijkl", (char*)&integrals[0], o * o * o * o * sizeof(double));
     psio->close(PSIF_DCC_IJKL, 1);
 
     F_DGEMM('n', 'n', o * o, v * v, o * o, 0.5, integrals, o * o, tempt, o * o, 0.0, tempv, o * o);
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -407,7 +407,7 @@ void CoupledCluster::I2ijkl_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -422,14 +422,14 @@ void CoupledCluster::I2piajk_linear(CCTaskParams params) {
     psio_address addr;
 
     psio->open(PSIF_DCC_IJAK2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAK2, "E2ijak2", (char*)&tempv[0], o * o * o * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAK2, "E2ijak2", (char*)&tempv[0], o * o * o * v * sizeof(double));
     psio->close(PSIF_DCC_IJAK2, 1);
 
     F_DGEMM('n', 'n', o * o * v, v, o, -1.0, tempv, o * o * v, t1, o, 0.0, tempt, o * o * v);
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempt, 1, tempv, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -438,7 +438,7 @@ void CoupledCluster::I2piajk_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -453,7 +453,7 @@ void CoupledCluster::Vabcd1_linear(CCTaskParams params) {
     psio_address addr;
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -486,7 +486,7 @@ void CoupledCluster::Vabcd1_linear(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -497,7 +497,7 @@ void CoupledCluster::Vabcd1_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -513,7 +513,7 @@ void CoupledCluster::Vabcd2_linear(CCTaskParams params) {
     psio_address addr;
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
@@ -545,7 +545,7 @@ void CoupledCluster::Vabcd2_linear(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             if (a > b)
@@ -579,14 +579,14 @@ void CoupledCluster::I2iabj_linear(CCTaskParams params) {
     psio_address addr;
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     C_DCOPY(o * o * v * v, integrals, 1, tempv, 1);
 
     // use I2iabj
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -618,7 +618,7 @@ void CoupledCluster::I2iabj_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -634,13 +634,13 @@ void CoupledCluster::I2iajb_linear(CCTaskParams params) {
     psio_address addr;
 
     psio->open(PSIF_DCC_IJAB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IJAB, "E2ijab", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IJAB, "E2ijab", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IJAB, 1);
 
     // use I2iajb
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -659,7 +659,7 @@ void CoupledCluster::I2iajb_linear(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -670,13 +670,13 @@ void CoupledCluster::I2iajb_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     // use I2iajb
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "t2", (char*)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -695,7 +695,7 @@ void CoupledCluster::I2iajb_linear(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (j = 0; j < o; j++) {
@@ -706,7 +706,7 @@ void CoupledCluster::I2iajb_linear(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
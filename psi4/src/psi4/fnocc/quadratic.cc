@@ -57,12 +57,12 @@ void CoupledCluster::CPU_I1ab_quadratic(CCTaskParams params) {
     // build I1(a,b)
     auto psio = std::make_shared<PSIO>();
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -89,7 +89,7 @@ void CoupledCluster::CPU_I1ab_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -106,7 +106,7 @@ void CoupledCluster::CPU_I1ab_quadratic(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -115,7 +115,7 @@ void CoupledCluster::CPU_I1ab_quadratic(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -135,7 +135,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem_quadratic(CCTaskParams params) {
     // no singles
     // build I1(i,a). n^4
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     // C_DCOPY(o*o*v*v,integrals,1,tempv,1);
     // for (i=0; i<o; i++){
@@ -150,7 +150,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -202,7 +202,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -218,7 +218,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem_quadratic(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     for (a = 0, id = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -228,7 +228,7 @@ void CoupledCluster::CPU_I1pij_I1ia_lessmem_quadratic(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -245,14 +245,14 @@ void CoupledCluster::I2ijkl_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
     } else {
         C_DCOPY(o * o * v * v, tb, 1, tempt, 1);
     }
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     for (j = 0; j < o; j++) {
         for (i = 0; i < o; i++) {
@@ -274,7 +274,7 @@ void CoupledCluster::I2ijkl_quadratic(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     C_DAXPY(o * o * v * v, 1.0, tempv, 1, tempt, 1);
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -283,7 +283,7 @@ void CoupledCluster::I2ijkl_quadratic(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
     psio.reset();
 }
@@ -299,7 +299,7 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -313,7 +313,7 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
     }
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
     // no linear terms!
     // C_DCOPY(o*o*v*v,integrals,1,tempv,1);
@@ -322,11 +322,11 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
 
     // contribute to intermediate
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_NEW);
-    psio->write_entry(PSIF_DCC_TEMP, "temporary", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_TEMP, "temporary", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 1);
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     C_DCOPY(o * o * v * v, tempt, 1, tempv, 1);
@@ -341,7 +341,7 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempt[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempt;
     }
@@ -357,14 +357,14 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
 
     // contribute to intermediate
     psio->open(PSIF_DCC_TEMP, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_TEMP, "temporary", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_TEMP, "temporary", (char*)&tempv[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_TEMP, 0);
     C_DAXPY(o * o * v * v, 1.0, tempt, 1, tempv, 1);
 
     // use I2iabj
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -394,7 +394,7 @@ void CoupledCluster::I2iabj_quadratic(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     psio.reset();
@@ -410,12 +410,12 @@ void CoupledCluster::I2iajb_quadratic(CCTaskParams params) {
     psio_address addr;
 
     psio->open(PSIF_DCC_IAJB, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_IAJB, "E2iajb", (char*)&tempt[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_IAJB, "E2iajb", (char*)&tempt[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_IAJB, 1);
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -445,7 +445,7 @@ void CoupledCluster::I2iajb_quadratic(CCTaskParams params) {
     // use I2iajb
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&tempv[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = tempv;
     }
@@ -462,7 +462,7 @@ void CoupledCluster::I2iajb_quadratic(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
             for (i = 0; i < o; i++) {
@@ -473,14 +473,14 @@ void CoupledCluster::I2iajb_quadratic(CCTaskParams params) {
             }
         }
     }
-    psio->write_entry(PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
+    resident.write_entry(psio, PSIF_DCC_R2, "residual", (char*)&integrals[0], o * o * v * v * sizeof(double));
     psio->close(PSIF_DCC_R2, 1);
 
     // use I2iajb
 
     if (t2_on_disk) {
         psio->open(PSIF_DCC_T2, PSIO_OPEN_OLD);
-        psio->read_entry(PSIF_DCC_T2, "first", (char*)&integrals[0], o * o * v * v * sizeof(double));
+        resident.read_entry(psio, PSIF_DCC_T2, "first", (char*)&integrals[0], o * o * v * v * sizeof(double));
         psio->close(PSIF_DCC_T2, 1);
         tb = integrals;
     }
@@ -497,7 +497,7 @@ void CoupledCluster::I2iajb_quadratic(CCTaskParams params) {
 
     // contribute to residual
     psio->open(PSIF_DCC_R2, PSIO_OPEN_OLD);
-    psio->read_entry(PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
+    resident.read_entry(psio, PSIF_DCC_R2, "residual", (char*)&tempv[0], o * o * v * v * sizeof(double));
 
     for (a = 0; a < v; a++) {
         for (b = 0; b < v; b++) {
@@ -0,0 +1,130 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "ccsd.h"
+
+#include <cstring>
+
+namespace psi {
+namespace fnocc {
+
+ResidentEntries::ResidentEntries() : budget_(0), used_(0), bytes_avoided_(0), bytes_written_back_(0) {}
+
+ResidentEntries::~ResidentEntries() {}
+
+void ResidentEntries::set_budget(size_t bytes) { budget_ = bytes; }
+
+bool ResidentEntries::add(size_t unit, const char *key, size_t size) {
+    auto id = std::make_pair(unit, std::string(key));
+    if (entries_.count(id)) return true;
+    if (used_ + size > budget_) return false;
+    Entry &entry = entries_[id];
+    entry.size = size;
+    entry.valid = false;
+    entry.dirty = false;
+    used_ += size;
+    return true;
+}
+
+void ResidentEntries::write_back(std::shared_ptr<PSIO> psio, size_t unit, const std::string &key, Entry &entry) {
+    if (!entry.dirty) return;
+    psio->write_entry(unit, key.c_str(), entry.data.data(), entry.data.size());
+    bytes_written_back_ += entry.data.size();
+    entry.dirty = false;
+}
+
+void ResidentEntries::read_entry(std::shared_ptr<PSIO> psio, size_t unit, const char *key, char *buffer,
+                                 size_t size) {
+    auto it = entries_.find(std::make_pair(unit, std::string(key)));
+    if (it == entries_.end()) {
+        psio->read_entry(unit, key, buffer, size);
+        return;
+    }
+    Entry &entry = it->second;
+    if (size != entry.size) {
+        // partial read: make sure the disk copy is current and go to disk
+        write_back(psio, unit, it->first.second, entry);
+        psio->read_entry(unit, key, buffer, size);
+        return;
+    }
+    if (entry.valid) {
+        bytes_avoided_ += size;
+    } else {
+        entry.data.resize(size);
+        psio->read_entry(unit, key, entry.data.data(), size);
+        entry.valid = true;
+    }
+    memcpy(buffer, entry.data.data(), size);
+}
+
+void ResidentEntries::write_entry(std::shared_ptr<PSIO> psio, size_t unit, const char *key, char *buffer,
+                                  size_t size) {
+    auto it = entries_.find(std::make_pair(unit, std::string(key)));
+    if (it == entries_.end()) {
+        psio->write_entry(unit, key, buffer, size);
+        return;
+    }
+    Entry &entry = it->second;
+    if (size != entry.size) {
+        // partial write: the in-core copy is no longer complete
+        write_back(psio, unit, it->first.second, entry);
+        psio->write_entry(unit, key, buffer, size);
+        entry.valid = false;
+        return;
+    }
+    entry.data.resize(size);
+    memcpy(entry.data.data(), buffer, size);
+    entry.valid = true;
+    entry.dirty = true;
+    bytes_avoided_ += size;
+}
+
+void ResidentEntries::release() {
+    if (entries_.empty()) return;
+
+    auto psio = std::make_shared<PSIO>();
+    for (auto &it : entries_) {
+        if (!it.second.dirty) continue;
+        psio->open(it.first.first, PSIO_OPEN_OLD);
+        write_back(psio, it.first.first, it.first.second, it.second);
+        psio->close(it.first.first, 1);
+    }
+
+    outfile->Printf("\n");
+    outfile->Printf("  In-core disk entries: %zu (%.2lf mb), disk i/o avoided: %.2lf mb, written back: %.2lf mb\n",
+                    entries_.size(), used_ / 1024. / 1024., bytes_avoided_ / 1024. / 1024.,
+                    bytes_written_back_ / 1024. / 1024.);
+
+    entries_.clear();
+    used_ = 0;
+    bytes_avoided_ = 0;
+    bytes_written_back_ = 0;
+}
+
+}  // namespace fnocc
+}  // namespace psi
@@ -26,7 +26,10 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <ctime>
+#include <utility>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -97,9 +100,16 @@ PsiReturnType CoupledCluster::triples() {
     // CDS // memory -= 8L*(2L*o*o*v*v+o*o*o*v+o*v+3L*nthreads*v*v*v);
     long int memory_reqd = 8L * (2L * vvoo + vooo + vo + 3L * nthreads * vvv);
 
+    // with three more v^3 buffers per thread, the E2abci blocks of i and j are
+    // read once per (i,j) batch rather than once per ijk
+    long int memory_batch = 8L * (2L * vvoo + vooo + vo + 6L * nthreads * vvv);
+    bool batch_ij = (memory_batch <= memory);
+    if (batch_ij) memory_reqd = memory_batch;
+
     outfile->Printf("        num_threads:              %9i\n", nthreads);
     outfile->Printf("        available memory:      %9.2lf mb\n", (double)memory / 1024. / 1024.);
     outfile->Printf("        memory requirements:   %9.2lf mb\n", (double)memory_reqd / 1024. / 1024.);
+    outfile->Printf("        E2abci blocks read:    %9s\n", batch_ij ? "per ij" : "per ijk");
     outfile->Printf("\n");
 
     long int nijk = 0;
@@ -110,19 +120,20 @@ PsiReturnType CoupledCluster::triples() {
             }
         }
     }
-    long int **ijk = (long int **)malloc(nijk * sizeof(long int *));
-    nijk = 0;
+    // work is handed out in (i,j) batches covering all k <= j, largest first
+    std::vector<std::pair<long int, long int>> ij;
     for (long int i = 0; i < o; i++) {
         for (long int j = 0; j <= i; j++) {
-            for (long int k = 0; k <= j; k++) {
-                ijk[nijk] = (long int *)malloc(3 * sizeof(long int));
-                ijk[nijk][0] = i;
-                ijk[nijk][1] = j;
-                ijk[nijk][2] = k;
-                nijk++;
-            }
+            ij.push_back(std::make_pair(i, j));
         }
     }
+    std::stable_sort(ij.begin(), ij.end(),
+                     [](const std::pair<long int, long int> &a, const std::pair<long int, long int> &b) {
+                         return a.second > b.second;
+                     });
+    long int nij = ij.size();
+    std::vector<long int> ijk_before(nij, 0);
+    for (long int ind = 1; ind < nij; ind++) ijk_before[ind] = ijk_before[ind - 1] + ij[ind - 1].second + 1;
     outfile->Printf("        Number of ijk combinations: %ld\n", nijk);
     outfile->Printf("\n");
 
@@ -130,11 +141,18 @@ PsiReturnType CoupledCluster::triples() {
     // some v^3 intermediates
     double **Z = (double **)malloc(nthreads * sizeof(double *));
     double **Z2 = (double **)malloc(nthreads * sizeof(double *));
+    // E2abci blocks of i and j and a separate scratch buffer for batched (i,j)
+    double **E2abci_i = (double **)malloc(nthreads * sizeof(double *));
+    double **E2abci_j = (double **)malloc(nthreads * sizeof(double *));
+    double **W = (double **)malloc(nthreads * sizeof(double *));
 
     for (int i = 0; i < nthreads; i++) {
         E2abci[i] = (double *)malloc(vvv * sizeof(double));
         Z[i] = (double *)malloc(vvv * sizeof(double));
         Z2[i] = (double *)malloc(vvv * sizeof(double));
+        E2abci_i[i] = batch_ij ? (double *)malloc(vvv * sizeof(double)) : nullptr;
+        E2abci_j[i] = batch_ij ? (double *)malloc(vvv * sizeof(double)) : nullptr;
+        W[i] = batch_ij ? (double *)malloc(vvv * sizeof(double)) : nullptr;
     }
 
     auto psio = std::make_shared<PSIO>();
@@ -176,10 +194,9 @@ PsiReturnType CoupledCluster::triples() {
   *  if there is enough memory to explicitly thread, do so
   */
 #pragma omp parallel for schedule(dynamic) num_threads(nthreads)
-    for (long int ind = 0; ind < nijk; ind++) {
-        long int i = ijk[ind][0];
-        long int j = ijk[ind][1];
-        long int k = ijk[ind][2];
+    for (long int ind = 0; ind < nij; ind++) {
+        long int i = ij[ind].first;
+        long int j = ij[ind].second;
 
         int thread = 0;
 #ifdef _OPENMP
@@ -189,187 +206,204 @@ PsiReturnType CoupledCluster::triples() {
         auto mypsio = std::make_shared<PSIO>();
         mypsio->open(PSIF_DCC_ABCI, PSIO_OPEN_OLD);
 
-        psio_address addr = psio_get_address(PSIO_ZERO, k * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + j * vvo + i * vv, v, 0.0, Z[thread], v * v);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * o * o * v + k * o * v, v, tempt + i * vvo, vv, 1.0, Z[thread],
-                v);
-
-        //(ab)(ij)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + i * vvo + j * vv, v, 0.0, Z2[thread], v * v);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * o * o * v + k * o * v, v, tempt + j * vvo, vv, 1.0, Z2[thread],
-                v);
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                C_DAXPY(v, 1.0, Z2[thread] + b * vv + a * v, 1, Z[thread] + a * vv + b * v, 1);
-            }
+        // read the E2abci block of index n into buf
+        auto read_E2abci = [&](long int n, double *buf) {
+            psio_address addr = psio_get_address(PSIO_ZERO, n * vvv * sizeof(double));
+            mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&buf[0], vvv * sizeof(double), addr, &addr);
+            return buf;
+        };
+
+        if (batch_ij) {
+            read_E2abci(i, E2abci_i[thread]);
+            read_E2abci(j, E2abci_j[thread]);
         }
 
-        //(bc)(jk)
-        addr = psio_get_address(PSIO_ZERO, (long int)j * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + k * v * v * o + i * v * v, v, 0.0, Z2[thread],
-                v * v);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + j * vo, v, tempt + i * vvo, vv, 1.0, Z2[thread], v);
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                C_DAXPY(v, 1.0, Z2[thread] + a * vv + b, v, Z[thread] + a * vv + b * v, 1);
+        for (long int k = 0; k <= j; k++) {
+            double *Ek = (batch_ij && k == j) ? E2abci_j[thread] : read_E2abci(k, E2abci[thread]);
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ek, v, tempt + j * vvo + i * vv, v, 0.0, Z[thread], v * v);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * o * o * v + k * o * v, v, tempt + i * vvo, vv, 1.0,
+                    Z[thread], v);
+
+            //(ab)(ij)
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ek, v, tempt + i * vvo + j * vv, v, 0.0, Z2[thread], v * v);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * o * o * v + k * o * v, v, tempt + j * vvo, vv, 1.0,
+                    Z2[thread], v);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    C_DAXPY(v, 1.0, Z2[thread] + b * vv + a * v, 1, Z[thread] + a * vv + b * v, 1);
+                }
             }
-        }
 
-        //(ikj)(acb)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + i * vvo + k * vv, v, 0.0, Z2[thread], vv);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * voo + j * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                C_DAXPY(v, 1.0, Z2[thread] + a * v + b, vv, Z[thread] + a * vv + b * v, 1);
+            //(bc)(jk)
+            double *Ej = batch_ij ? E2abci_j[thread] : read_E2abci(j, E2abci[thread]);
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ej, v, tempt + k * v * v * o + i * v * v, v, 0.0, Z2[thread], v * v);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + j * vo, v, tempt + i * vvo, vv, 1.0, Z2[thread], v);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    C_DAXPY(v, 1.0, Z2[thread] + a * vv + b, v, Z[thread] + a * vv + b * v, 1);
+                }
+            }
+
+            //(ikj)(acb)
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ej, v, tempt + i * vvo + k * vv, v, 0.0, Z2[thread], vv);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + i * voo + j * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    C_DAXPY(v, 1.0, Z2[thread] + a * v + b, vv, Z[thread] + a * vv + b * v, 1);
+                }
             }
-        }
 
-        //(ac)(ik)
-        addr = psio_get_address(PSIO_ZERO, i * vvv * sizeof(double));
-        mypsio->read(PSIF_DCC_ABCI, "E2abci", (char *)&E2abci[thread][0], vvv * sizeof(double), addr, &addr);
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + j * vvo + k * vv, v, 0.0, Z2[thread], vv);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * voo + i * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                C_DAXPY(v, 1.0, Z2[thread] + b * v + a, vv, Z[thread] + a * vv + b * v, 1);
+            //(ac)(ik)
+            double *Ei = batch_ij ? E2abci_i[thread] : read_E2abci(i, E2abci[thread]);
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ei, v, tempt + j * vvo + k * vv, v, 0.0, Z2[thread], vv);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + j * voo + i * vo, v, tempt + k * vvo, vv, 1.0, Z2[thread], v);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    C_DAXPY(v, 1.0, Z2[thread] + b * v + a, vv, Z[thread] + a * vv + b * v, 1);
+                }
             }
-        }
 
-        //(ijk)(abc)
-        F_DGEMM('t', 't', vv, v, v, 1.0, E2abci[thread], v, tempt + k * vvo + j * vv, v, 0.0, Z2[thread], vv);
-        F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + i * vo, v, tempt + j * vvo, vv, 1.0, Z2[thread], v);
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                C_DAXPY(v, 1.0, Z2[thread] + b * vv + a, v, Z[thread] + a * vv + b * v, 1);
+            //(ijk)(abc)
+            F_DGEMM('t', 't', vv, v, v, 1.0, Ei, v, tempt + k * vvo + j * vv, v, 0.0, Z2[thread], vv);
+            F_DGEMM('n', 't', v, vv, o, -1.0, E2ijak + k * voo + i * vo, v, tempt + j * vvo, vv, 1.0, Z2[thread], v);
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    C_DAXPY(v, 1.0, Z2[thread] + b * vv + a, v, Z[thread] + a * vv + b * v, 1);
+                }
             }
-        }
 
-        C_DCOPY(vvv, Z[thread], 1, Z2[thread], 1);
-        for (long int a = 0; a < v; a++) {
-            double tai = t1[a * o + i];
-            for (long int b = 0; b < v; b++) {
-                long int ab = 1 + (a == b);
-                double tbj = t1[b * o + j];
-                double E2iajb = E2klcd[i * vvo + a * vo + j * v + b];
-                for (long int c = 0; c < v; c++) {
-                    Z2[thread][a * vv + b * v + c] +=
-                        fac * (tai * E2klcd[j * vvo + b * vo + k * v + c] + tbj * E2klcd[i * vvo + a * vo + k * v + c] +
-                               t1[c * o + k] * E2iajb);
-                    Z2[thread][a * vv + b * v + c] /= (ab + (b == c) + (a == c));
+            // scratch: the E2abci buffer is free once the block of i has been used
+            double *Wt = batch_ij ? W[thread] : E2abci[thread];
+
+            C_DCOPY(vvv, Z[thread], 1, Z2[thread], 1);
+            for (long int a = 0; a < v; a++) {
+                double tai = t1[a * o + i];
+                for (long int b = 0; b < v; b++) {
+                    long int ab = 1 + (a == b);
+                    double tbj = t1[b * o + j];
+                    double E2iajb = E2klcd[i * vvo + a * vo + j * v + b];
+                    for (long int c = 0; c < v; c++) {
+                        Z2[thread][a * vv + b * v + c] +=
+                            fac * (tai * E2klcd[j * vvo + b * vo + k * v + c] +
+                                   tbj * E2klcd[i * vvo + a * vo + k * v + c] + t1[c * o + k] * E2iajb);
+                        Z2[thread][a * vv + b * v + c] /= (ab + (b == c) + (a == c));
+                    }
                 }
             }
-        }
 
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                for (long int c = 0; c < v; c++) {
-                    long int abc = a * vv + b * v + c;
-                    long int bac = b * vv + a * v + c;
-                    long int acb = a * vv + c * v + b;
-                    long int cba = c * vv + b * v + a;
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    for (long int c = 0; c < v; c++) {
+                        long int abc = a * vv + b * v + c;
+                        long int bac = b * vv + a * v + c;
+                        long int acb = a * vv + c * v + b;
+                        long int cba = c * vv + b * v + a;
 
-                    E2abci[thread][abc] = Z2[thread][acb] + Z2[thread][bac] + Z2[thread][cba];
+                        Wt[abc] = Z2[thread][acb] + Z2[thread][bac] + Z2[thread][cba];
+                    }
                 }
             }
-        }
-        double dijk = F[i] + F[j] + F[k];
-        long int ijkfac = (2 - ((i == j) + (j == k) + (i == k)));
-        // separate out these bits to save v^3 storage
-        double tripval = 0.0;
-        for (long int a = 0; a < v; a++) {
-            double dijka = dijk - F[a + o];
-            for (long int b = 0; b <= a; b++) {
-                double dijkab = dijka - F[b + o];
-                for (long int c = 0; c <= b; c++) {
-                    long int abc = a * vv + b * v + c;
-                    long int bca = b * vv + c * v + a;
-                    long int cab = c * vv + a * v + b;
-                    long int acb = a * vv + c * v + b;
-                    long int bac = b * vv + a * v + c;
-                    long int cba = c * vv + b * v + a;
-                    double dum = Z[thread][abc] * Z2[thread][abc] + Z[thread][acb] * Z2[thread][acb] +
-                                 Z[thread][bac] * Z2[thread][bac] + Z[thread][bca] * Z2[thread][bca] +
-                                 Z[thread][cab] * Z2[thread][cab] + Z[thread][cba] * Z2[thread][cba];
-
-                    dum = (E2abci[thread][abc]) * ((Z[thread][abc] + Z[thread][bca] + Z[thread][cab]) * -2.0 +
-                                                   (Z[thread][acb] + Z[thread][bac] + Z[thread][cba])) +
-                          3.0 * dum;
-                    double denom = dijkab - F[c + o];
-                    tripval += dum / denom;
+            double dijk = F[i] + F[j] + F[k];
+            long int ijkfac = (2 - ((i == j) + (j == k) + (i == k)));
+            // separate out these bits to save v^3 storage
+            double tripval = 0.0;
+            for (long int a = 0; a < v; a++) {
+                double dijka = dijk - F[a + o];
+                for (long int b = 0; b <= a; b++) {
+                    double dijkab = dijka - F[b + o];
+#pragma omp simd reduction(+ : tripval)
+                    for (long int c = 0; c <= b; c++) {
+                        long int abc = a * vv + b * v + c;
+                        long int bca = b * vv + c * v + a;
+                        long int cab = c * vv + a * v + b;
+                        long int acb = a * vv + c * v + b;
+                        long int bac = b * vv + a * v + c;
+                        long int cba = c * vv + b * v + a;
+                        double dum = Z[thread][abc] * Z2[thread][abc] + Z[thread][acb] * Z2[thread][acb] +
+                                     Z[thread][bac] * Z2[thread][bac] + Z[thread][bca] * Z2[thread][bca] +
+                                     Z[thread][cab] * Z2[thread][cab] + Z[thread][cba] * Z2[thread][cba];
+
+                        dum = (Wt[abc]) * ((Z[thread][abc] + Z[thread][bca] + Z[thread][cab]) * -2.0 +
+                                           (Z[thread][acb] + Z[thread][bac] + Z[thread][cba])) +
+                              3.0 * dum;
+                        double denom = dijkab - F[c + o];
+                        tripval += dum / denom;
+                    }
                 }
             }
-        }
-        etrip[thread] += tripval * ijkfac;
-        // the second bit
-        for (long int a = 0; a < v; a++) {
-            for (long int b = 0; b < v; b++) {
-                for (long int c = 0; c < v; c++) {
-                    long int abc = a * vv + b * v + c;
-                    long int bca = b * vv + c * v + a;
-                    long int cab = c * vv + a * v + b;
-
-                    E2abci[thread][abc] = Z2[thread][abc] + Z2[thread][bca] + Z2[thread][cab];
+            etrip[thread] += tripval * ijkfac;
+            // the second bit
+            for (long int a = 0; a < v; a++) {
+                for (long int b = 0; b < v; b++) {
+                    for (long int c = 0; c < v; c++) {
+                        long int abc = a * vv + b * v + c;
+                        long int bca = b * vv + c * v + a;
+                        long int cab = c * vv + a * v + b;
+
+                        Wt[abc] = Z2[thread][abc] + Z2[thread][bca] + Z2[thread][cab];
+                    }
                 }
             }
-        }
-        tripval = 0.0;
-        for (long int a = 0; a < v; a++) {
-            double dijka = dijk - F[a + o];
-            for (long int b = 0; b <= a; b++) {
-                double dijkab = dijka - F[b + o];
-                for (long int c = 0; c <= b; c++) {
-                    long int abc = a * vv + b * v + c;
-                    long int bca = b * vv + c * v + a;
-                    long int cab = c * vv + a * v + b;
-                    long int acb = a * vv + c * v + b;
-                    long int bac = b * vv + a * v + c;
-                    long int cba = c * vv + b * v + a;
-
-                    double dum = (E2abci[thread][abc]) * (Z[thread][abc] + Z[thread][bca] + Z[thread][cab] +
-                                                          (Z[thread][acb] + Z[thread][bac] + Z[thread][cba]) * -2.0);
-
-                    double denom = dijkab - F[c + o];
-                    tripval += dum / denom;
+            tripval = 0.0;
+            for (long int a = 0; a < v; a++) {
+                double dijka = dijk - F[a + o];
+                for (long int b = 0; b <= a; b++) {
+                    double dijkab = dijka - F[b + o];
+#pragma omp simd reduction(+ : tripval)
+                    for (long int c = 0; c <= b; c++) {
+                        long int abc = a * vv + b * v + c;
+                        long int bca = b * vv + c * v + a;
+                        long int cab = c * vv + a * v + b;
+                        long int acb = a * vv + c * v + b;
+                        long int bac = b * vv + a * v + c;
+                        long int cba = c * vv + b * v + a;
+
+                        double dum = (Wt[abc]) * (Z[thread][abc] + Z[thread][bca] + Z[thread][cab] +
+                                                  (Z[thread][acb] + Z[thread][bac] + Z[thread][cba]) * -2.0);
+
+                        double denom = dijkab - F[c + o];
+                        tripval += dum / denom;
+                    }
                 }
             }
+            etrip[thread] += tripval * ijkfac;
         }
-        etrip[thread] += tripval * ijkfac;
+
         // print out update
         if (thread == 0) {
             int print = 0;
             stop = std::time(nullptr);
-            if ((double)ind / nijk >= 0.1 && !pct10) {
+            if ((double)ijk_before[ind] / nijk >= 0.1 && !pct10) {
                 pct10 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.2 && !pct20) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.2 && !pct20) {
                 pct20 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.3 && !pct30) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.3 && !pct30) {
                 pct30 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.4 && !pct40) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.4 && !pct40) {
                 pct40 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.5 && !pct50) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.5 && !pct50) {
                 pct50 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.6 && !pct60) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.6 && !pct60) {
                 pct60 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.7 && !pct70) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.7 && !pct70) {
                 pct70 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.8 && !pct80) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.8 && !pct80) {
                 pct80 = 1;
                 print = 1;
-            } else if ((double)ind / nijk >= 0.9 && !pct90) {
+            } else if ((double)ijk_before[ind] / nijk >= 0.9 && !pct90) {
                 pct90 = 1;
                 print = 1;
             }
             if (print) {
-                outfile->Printf("              %3.1lf  %8d s\n", 100.0 * ind / nijk, (int)stop - (int)start);
+                outfile->Printf("              %3.1lf  %8d s\n", 100.0 * ijk_before[ind] / nijk,
+                                (int)stop - (int)start);
             }
         }
         mypsio->close(PSIF_DCC_ABCI, 1);
@@ -407,9 +441,15 @@ PsiReturnType CoupledCluster::triples() {
         free(E2abci[i]);
         free(Z[i]);
         free(Z2[i]);
+        free(E2abci_i[i]);
+        free(E2abci_j[i]);
+        free(W[i]);
     }
     free(Z);
     free(Z2);
+    free(E2abci_i);
+    free(E2abci_j);
+    free(W);
     free(E2abci);
     free(etrip);
     delete[] name;
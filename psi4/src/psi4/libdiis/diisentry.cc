@@ -40,7 +40,7 @@ PRAGMA_WARNING_POP
 namespace psi {
 
 DIISEntry::DIISEntry(std::string label, int ID, int orderAdded, int errorVectorSize, double *errorVector,
-                     int vectorSize, double *vector, std::shared_ptr<PSIO> psio)
+                     int vectorSize, double *vector, std::shared_ptr<PSIO> psio, bool ownsMemory)
     : _vectorSize(vectorSize),
       _errorVectorSize(errorVectorSize),
       _vector(vector),
@@ -48,7 +48,8 @@ DIISEntry::DIISEntry(std::string label, int ID, int orderAdded, int errorVectorS
       _ID(ID),
       _orderAdded(orderAdded),
       _label(label),
-      _psio(psio) {
+      _psio(psio),
+      _ownsMemory(ownsMemory) {
     double sumSQ = C_DDOT(_errorVectorSize, _errorVector, 1, _errorVector, 1);
     _rmsError = sqrt(sumSQ / _errorVectorSize);
     _dotProducts[_ID] = sumSQ;
@@ -103,18 +104,20 @@ void DIISEntry::read_error_vector_from_disk() {
 }
 
 void DIISEntry::free_vector_memory() {
+    if (!_ownsMemory) return;
     if (_vector) delete[] _vector;
     _vector = nullptr;
 }
 
 void DIISEntry::free_error_vector_memory() {
+    if (!_ownsMemory) return;
     if (_errorVector) delete[] _errorVector;
     _errorVector = nullptr;
 }
 
 DIISEntry::~DIISEntry() {
-    if (_vector != nullptr) delete[] _vector;
-    if (_errorVector != nullptr) delete[] _errorVector;
+    free_vector_memory();
+    free_error_vector_memory();
 }
 
 }  // namespace psi
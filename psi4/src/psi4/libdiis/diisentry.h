@@ -60,7 +60,7 @@ class DIISEntry {
      */
     enum InputType { DPDBuf4, DPDFile2, Matrix, Vector, Pointer };
     DIISEntry(std::string label, int ID, int count, int vectorSize, double *vector, int errorVectorSize,
-              double *errorVector, std::shared_ptr<PSIO> psio);
+              double *errorVector, std::shared_ptr<PSIO> psio, bool ownsMemory = true);
     ~DIISEntry();
     /// Whether the dot product of this entry's and the nth entry's error vector is known
     bool dot_is_known_with(int n) { return _knownDotProducts[n]; }
@@ -129,6 +129,8 @@ class DIISEntry {
     std::string _label;
     /// PSIO object
     std::shared_ptr<PSIO> _psio;
+    /// Whether the vectors were allocated for this entry, or point into the manager's in-core store
+    bool _ownsMemory;
 };
 
 }  // namespace psi
@@ -30,6 +30,7 @@
 
 #include <cmath>
 #include <cstdarg>
+#include <cstring>
 #include <memory>
 
 #include "psi4/psifiles.h"
@@ -77,6 +78,8 @@ void DIISManager::set_vector_size(int numQuantities, ...) {
     if (_errorVectorSize == 0)
         throw SanityCheckError("DIISManager: The error vector size must be set before the vector size", __FILE__,
                                __LINE__);
+    _errorStore.clear();
+    _vectorStore.clear();
     _numVectorComponents = numQuantities;
     dpdfile2 *file2;
     dpdbuf4 *buf4;
@@ -129,6 +132,8 @@ void DIISManager::set_vector_size(int numQuantities, ...) {
 void DIISManager::set_error_vector_size(int numQuantities, ...) {
     if (_errorVectorSize)
         throw SanityCheckError("The size of the DIIS error vector has already been set", __FILE__, __LINE__);
+    _errorStore.clear();
+    _vectorStore.clear();
     _numErrorVectorComponents = numQuantities;
     dpdfile2 *file2;
     dpdbuf4 *buf4;
@@ -204,8 +209,17 @@ bool DIISManager::add_entry(int numQuantities, ...) {
     double *array;
     va_list args;
     va_start(args, numQuantities);
-    auto *errorVectorPtr = new double[_errorVectorSize];
-    auto *vectorPtr = new double[_vectorSize];
+
+    int entryID = get_next_entry_id();
+    // In core, the entry is gathered straight into its row of the contiguous stores
+    bool inCore = (_storagePolicy == InCore);
+    if (inCore && _errorStore.empty()) {
+        _errorStore.resize(static_cast<size_t>(_maxSubspaceSize) * _errorVectorSize);
+        _vectorStore.resize(static_cast<size_t>(_maxSubspaceSize) * _vectorSize);
+    }
+    double *errorVectorPtr = inCore ? &_errorStore[static_cast<size_t>(entryID) * _errorVectorSize]
+                                    : new double[_errorVectorSize];
+    double *vectorPtr = inCore ? &_vectorStore[static_cast<size_t>(entryID) * _vectorSize] : new double[_vectorSize];
     double *arrayPtr = errorVectorPtr;
     for (int i = 0; i < numQuantities; ++i) {
         DIISEntry::InputType type = _componentTypes[i];
@@ -266,24 +280,33 @@ bool DIISManager::add_entry(int numQuantities, ...) {
     }
     va_end(args);
 
-    int entryID = get_next_entry_id();
+    auto *entry = new DIISEntry(_label, entryID, _entryCount++, _errorVectorSize, errorVectorPtr, _vectorSize,
+                                vectorPtr, _psio, !inCore);
     if (_subspace.size() < _maxSubspaceSize) {
-        _subspace.push_back(new DIISEntry(_label, entryID, _entryCount++, _errorVectorSize, errorVectorPtr, _vectorSize,
-                                          vectorPtr, _psio));
+        _subspace.push_back(entry);
     } else {
         delete _subspace[entryID];
-        _subspace[entryID] = new DIISEntry(_label, entryID, _entryCount++, _errorVectorSize, errorVectorPtr,
-                                           _vectorSize, vectorPtr, _psio);
+        _subspace[entryID] = entry;
     }
 
-    if (_storagePolicy == OnDisk) {
+    if (inCore) {
+        // The new row of B, against every entry at once
+        int n = _subspace.size();
+        std::vector<double> dots(n);
+        C_DGEMV('N', n, _errorVectorSize, 1.0, _errorStore.data(), _errorVectorSize, errorVectorPtr, 1, 0.0,
+                dots.data(), 1);
+        for (int i = 0; i < n; ++i) {
+            _subspace[i]->set_dot_with(entryID, dots[i]);
+            entry->set_dot_with(i, dots[i]);
+        }
+    } else {
         _subspace[entryID]->dump_vector_to_disk();
         _subspace[entryID]->dump_error_vector_to_disk();
-    }
 
-    // Make we don't know any inner products involving this new entry
-    for (int i = 0; i < _subspace.size(); ++i)
-        if (i != entryID) _subspace[i]->invalidate_dot(entryID);
+        // Make we don't know any inner products involving this new entry
+        for (int i = 0; i < _subspace.size(); ++i)
+            if (i != entryID) _subspace[i]->invalidate_dot(entryID);
+    }
 
     timer_off("DIISManager::add_entry");
 
@@ -323,32 +346,16 @@ int DIISManager::get_next_entry_id() {
 }
 
 /**
- * Performs the extapolation, based on the current subspace
- * @param numQuantitites - the number of quantities that the vector comprises.
- * Then pass these quantities in the order they were passed to the set_vector_size()
- * function.  The types of each component should not be specified here, unlike the
- * set_vector_size() function call.
+ * The matrix of dot products between the error vectors of the current subspace.
+ * In core these are all known from add_entry(); on disk the missing ones are computed.
  */
-bool DIISManager::extrapolate(int numQuantities, ...) {
-    if (!_subspace.size()) return false;
-
-    timer_on("DIISManager::extrapolate");
-
-    auto dimension = _subspace.size() + 1;
-    auto B = std::make_shared<Matrix>("B (DIIS Connectivity Matrix", dimension, dimension);
+SharedMatrix DIISManager::error_dot_products() {
+    int n = _subspace.size();
+    auto B = std::make_shared<Matrix>("DIIS Error Dot Products", n, n);
     auto bMatrix = B->pointer();
-    auto coefficients = new double[dimension];
-    std::fill_n(coefficients, dimension, 0.0);
-    auto force = new double[dimension];
-    std::fill_n(force, dimension, 0.0);
-
-    timer_on("bMatrix setup");
-
-    for (int i = 0; i < _subspace.size(); ++i) {
-        coefficients[i] = 0.0;
-        bMatrix[i][_subspace.size()] = bMatrix[_subspace.size()][i] = 1.0;
+    for (int i = 0; i < n; ++i) {
         DIISEntry *entryI = _subspace[i];
-        for (int j = 0; j < _subspace.size(); ++j) {
+        for (int j = 0; j < n; ++j) {
             DIISEntry *entryJ = _subspace[j];
             if (entryI->dot_is_known_with(j)) {
                 bMatrix[i][j] = entryI->dot_with(j);
@@ -365,6 +372,31 @@ bool DIISManager::extrapolate(int numQuantities, ...) {
             }
         }
     }
+    return B;
+}
+
+/**
+ * Solves the DIIS equations for the current subspace
+ * @return the coefficient of each subspace entry
+ */
+std::vector<double> DIISManager::diis_coefficients() {
+    auto dimension = _subspace.size() + 1;
+    auto B = std::make_shared<Matrix>("B (DIIS Connectivity Matrix", dimension, dimension);
+    auto bMatrix = B->pointer();
+    auto coefficients = new double[dimension];
+    std::fill_n(coefficients, dimension, 0.0);
+    auto force = new double[dimension];
+    std::fill_n(force, dimension, 0.0);
+
+    timer_on("bMatrix setup");
+
+    auto dots = error_dot_products();
+    for (int i = 0; i < _subspace.size(); ++i) {
+        bMatrix[i][_subspace.size()] = bMatrix[_subspace.size()][i] = 1.0;
+        for (int j = 0; j < _subspace.size(); ++j) {
+            bMatrix[i][j] = dots->get(i, j);
+        }
+    }
     force[_subspace.size()] = 1.0;
     bMatrix[_subspace.size()][_subspace.size()] = 0.0;
 
@@ -413,105 +445,148 @@ bool DIISManager::extrapolate(int numQuantities, ...) {
 
     timer_off("bMatrix pseudoinverse");
 
+    std::vector<double> result(coefficients, coefficients + _subspace.size());
+    delete[] coefficients;
+    delete[] force;
+    return result;
+}
+
+/**
+ * Performs the extapolation, based on the current subspace
+ * @param numQuantitites - the number of quantities that the vector comprises.
+ * Then pass these quantities in the order they were passed to the set_vector_size()
+ * function.  The types of each component should not be specified here, unlike the
+ * set_vector_size() function call.
+ */
+bool DIISManager::extrapolate(int numQuantities, ...) {
+    if (!_subspace.size()) return false;
+
+    timer_on("DIISManager::extrapolate");
+
+    std::vector<double> coefficients = diis_coefficients();
+
+    va_list args;
+    va_start(args, numQuantities);
+    combine(coefficients, numQuantities, args);
+    va_end(args);
+
+    timer_off("DIISManager::extrapolate");
+
+    return true;
+}
+
+/**
+ * Forms the vector from the given coefficients of the subspace entries
+ * @param coefficients - one per entry, in subspace order
+ * The remaining parameters are as for extrapolate().
+ */
+bool DIISManager::extrapolate_with_coefficients(const std::vector<double> &coefficients, int numQuantities, ...) {
+    if (!_subspace.size()) return false;
+    if (coefficients.size() != _subspace.size())
+        throw SanityCheckError("DIISManager: one coefficient per subspace entry is needed", __FILE__, __LINE__);
+
+    timer_on("DIISManager::extrapolate");
+
+    va_list args;
+    va_start(args, numQuantities);
+    combine(coefficients, numQuantities, args);
+    va_end(args);
+
+    timer_off("DIISManager::extrapolate");
+
+    return true;
+}
+
+void DIISManager::combine(const std::vector<double> &coefficients, int numQuantities, va_list args) {
     timer_on("New vector");
 
+    int print = Process::environment.options.get_int("PRINT");
+    if (print > 2) {
+        outfile->Printf("DIIS coefficients: ");
+        for (double coefficient : coefficients) outfile->Printf(" %.3f ", coefficient);
+        outfile->Printf("\n");
+    }
+
+    // The combination is formed once, contiguously, and then written to the quantities
+    int n = _subspace.size();
+    std::vector<double> combined(_vectorSize, 0.0);
+    if (_storagePolicy == InCore) {
+        C_DGEMV('T', n, _vectorSize, 1.0, _vectorStore.data(), _vectorSize, const_cast<double *>(coefficients.data()),
+                1, 0.0, combined.data(), 1);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            C_DAXPY(_vectorSize, coefficients[i], const_cast<double *>(_subspace[i]->vector()), 1, combined.data(), 1);
+            _subspace[i]->free_vector_memory();
+        }
+    }
+
     dpdfile2 *file2;
     dpdbuf4 *buf4;
     Vector *vector;
     Matrix *matrix;
     double *array;
-    va_list args;
-    int print = Process::environment.options.get_int("PRINT");
-    if (print > 2) outfile->Printf("DIIS coefficients: ");
-    for (int n = 0; n < _subspace.size(); ++n) {
-        double coefficient = coefficients[n];
-        if (print > 2) outfile->Printf(" %.3f ", coefficient);
-        const double *arrayPtr = _subspace[n]->vector();
-        va_start(args, numQuantities);
-        for (int i = 0; i < numQuantities; ++i) {
-            // The indexing arrays contain the error vector, then the vector, so they
-            // need to be offset by the number of components in the error vector
-            int componentIndex = i + _numErrorVectorComponents;
-            DIISEntry::InputType type = _componentTypes[componentIndex];
-            switch (type) {
-                case DIISEntry::Pointer:
-                    array = va_arg(args, double *);
-                    if (!n) ::memset(array, 0, _componentSizes[componentIndex] * sizeof(double));
-                    for (int j = 0; j < _componentSizes[componentIndex]; ++j) array[j] += coefficient * *arrayPtr++;
-                    break;
-                case DIISEntry::DPDBuf4:
-                    buf4 = va_arg(args, dpdbuf4 *);
-                    if (!n) global_dpd_->buf4_scm(buf4, 0.0);
-                    for (int h = 0; h < buf4->params->nirreps; ++h) {
-                        global_dpd_->buf4_mat_irrep_init(buf4, h);
-                        global_dpd_->buf4_mat_irrep_rd(buf4, h);
-                        for (int row = 0; row < buf4->params->rowtot[h]; ++row) {
-                            for (int col = 0; col < buf4->params->coltot[h]; ++col) {
-                                buf4->matrix[h][row][col] += coefficient * *arrayPtr++;
-                            }
-                        }
-                        global_dpd_->buf4_mat_irrep_wrt(buf4, h);
-                        global_dpd_->buf4_mat_irrep_close(buf4, h);
-                    }
-                    break;
-                case DIISEntry::DPDFile2:
-                    file2 = va_arg(args, dpdfile2 *);
-                    if (!n) global_dpd_->file2_scm(file2, 0.0);
-                    global_dpd_->file2_mat_init(file2);
-                    global_dpd_->file2_mat_rd(file2);
-                    for (int h = 0; h < file2->params->nirreps; ++h) {
-                        for (int row = 0; row < file2->params->rowtot[h]; ++row) {
-                            for (int col = 0; col < file2->params->coltot[h]; ++col) {
-                                file2->matrix[h][row][col] += coefficient * *arrayPtr++;
-                            }
+    const double *arrayPtr = combined.data();
+    for (int i = 0; i < numQuantities; ++i) {
+        // The indexing arrays contain the error vector, then the vector, so they
+        // need to be offset by the number of components in the error vector
+        int componentIndex = i + _numErrorVectorComponents;
+        DIISEntry::InputType type = _componentTypes[componentIndex];
+        switch (type) {
+            case DIISEntry::Pointer:
+                array = va_arg(args, double *);
+                ::memcpy(array, arrayPtr, _componentSizes[componentIndex] * sizeof(double));
+                arrayPtr += _componentSizes[componentIndex];
+                break;
+            case DIISEntry::DPDBuf4:
+                buf4 = va_arg(args, dpdbuf4 *);
+                for (int h = 0; h < buf4->params->nirreps; ++h) {
+                    global_dpd_->buf4_mat_irrep_init(buf4, h);
+                    for (int row = 0; row < buf4->params->rowtot[h]; ++row) {
+                        for (int col = 0; col < buf4->params->coltot[h]; ++col) {
+                            buf4->matrix[h][row][col] = *arrayPtr++;
                         }
                     }
-                    global_dpd_->file2_mat_wrt(file2);
-                    global_dpd_->file2_mat_close(file2);
-                    break;
-                case DIISEntry::Matrix:
-                    matrix = va_arg(args, Matrix *);
-                    if (!n) matrix->zero();
-                    for (int h = 0; h < matrix->nirrep(); ++h) {
-                        for (int row = 0; row < matrix->rowspi()[h]; ++row) {
-                            for (int col = 0; col < matrix->colspi()[h]; ++col) {
-                                matrix->add(h, row, col, coefficient * *arrayPtr++);
-                            }
+                    global_dpd_->buf4_mat_irrep_wrt(buf4, h);
+                    global_dpd_->buf4_mat_irrep_close(buf4, h);
+                }
+                break;
+            case DIISEntry::DPDFile2:
+                file2 = va_arg(args, dpdfile2 *);
+                global_dpd_->file2_mat_init(file2);
+                for (int h = 0; h < file2->params->nirreps; ++h) {
+                    for (int row = 0; row < file2->params->rowtot[h]; ++row) {
+                        for (int col = 0; col < file2->params->coltot[h]; ++col) {
+                            file2->matrix[h][row][col] = *arrayPtr++;
                         }
                     }
-                    break;
-                case DIISEntry::Vector:
-                    vector = va_arg(args, Vector *);
-                    if (!n) {
-                        for (int h = 0; h < vector->nirrep(); ++h) {
-                            for (int row = 0; row < vector->dimpi()[h]; ++row) {
-                                vector->set(h, row, 0.0);
-                            }
+                }
+                global_dpd_->file2_mat_wrt(file2);
+                global_dpd_->file2_mat_close(file2);
+                break;
+            case DIISEntry::Matrix:
+                matrix = va_arg(args, Matrix *);
+                for (int h = 0; h < matrix->nirrep(); ++h) {
+                    for (int row = 0; row < matrix->rowspi()[h]; ++row) {
+                        for (int col = 0; col < matrix->colspi()[h]; ++col) {
+                            matrix->set(h, row, col, *arrayPtr++);
                         }
                     }
-                    for (int h = 0; h < vector->nirrep(); ++h) {
-                        for (int row = 0; row < vector->dimpi()[h]; ++row) {
-                            double val = vector->get(h, row);
-                            vector->set(h, row, coefficient * *arrayPtr++ + val);
-                        }
+                }
+                break;
+            case DIISEntry::Vector:
+                vector = va_arg(args, Vector *);
+                for (int h = 0; h < vector->nirrep(); ++h) {
+                    for (int row = 0; row < vector->dimpi()[h]; ++row) {
+                        vector->set(h, row, *arrayPtr++);
                     }
-                    break;
-                default:
-                    throw SanityCheckError("Unknown input type", __FILE__, __LINE__);
-            }
+                }
+                break;
+            default:
+                throw SanityCheckError("Unknown input type", __FILE__, __LINE__);
         }
-        if (_storagePolicy == OnDisk) _subspace[n]->free_vector_memory();
-        va_end(args);
     }
 
     timer_off("New vector");
-
-    if (print > 2) outfile->Printf("\n");
-    delete[] coefficients;
-    delete[] force;
-    timer_off("DIISManager::extrapolate");
-
-    return true;
 }
 
 /**
@@ -520,6 +595,9 @@ bool DIISManager::extrapolate(int numQuantities, ...) {
 void DIISManager::reset_subspace() {
     for (int i = 0; i < _subspace.size(); ++i) delete _subspace[i];
     _subspace.clear();
+    // The in-core stores are sized on the next add_entry(), for whatever the vector sizes are then
+    _errorStore.clear();
+    _vectorStore.clear();
 }
 
 /**
@@ -29,6 +29,7 @@
 #ifndef _PSI_SRC_LIB_LIBDIIS_DIISMANAGER_H_
 #define _PSI_SRC_LIB_LIBDIIS_DIISMANAGER_H_
 
+#include <cstdarg>
 #include <vector>
 #include <map>
 
@@ -50,7 +51,8 @@ class PSI_API DIISManager {
      * @brief How the quantities are to be stored;
      *
      * OnDisk - Stored on disk, and retrieved when required
-     * InCore - Stored in memory throughout
+     * InCore - Stored in memory throughout, in one contiguous block for the vectors and one for
+     *          the error vectors
      */
     enum StoragePolicy { InCore, OnDisk };
     /**
@@ -83,6 +85,21 @@ class PSI_API DIISManager {
 
     bool extrapolate(SharedMatrix extrapolated) { return DIISManager::extrapolate(1, extrapolated.get()); }
 
+    /// The DIIS coefficients of the current subspace, in subspace order
+    std::vector<double> diis_coefficients();
+    /// The matrix of error vector dot products of the current subspace, for ADIIS/EDIIS-type schemes
+    SharedMatrix error_dot_products();
+    /**
+     * Forms the vector from coefficients of the caller's choosing, e.g. ADIIS or EDIIS
+     * coefficients, or a blend of those with diis_coefficients(). The quantities are passed
+     * as for extrapolate().
+     */
+    bool extrapolate_with_coefficients(const std::vector<double>& coefficients, int numQuantities, ...);
+
+    bool extrapolate_with_coefficients(const std::vector<double>& coefficients, SharedMatrix extrapolated) {
+        return DIISManager::extrapolate_with_coefficients(coefficients, 1, extrapolated.get());
+    }
+
     int remove_entry();
     void reset_subspace();
     void delete_diis_file();
@@ -91,6 +108,8 @@ class PSI_API DIISManager {
 
    protected:
     int get_next_entry_id();
+    /// Sets the vector quantities in args to the combination of the subspace vectors
+    void combine(const std::vector<double>& coefficients, int numQuantities, va_list args);
 
     /// How the vectors are handled in memory
     StoragePolicy _storagePolicy;
@@ -118,6 +137,10 @@ class PSI_API DIISManager {
     std::string _label;
     /// The PSIO object to use for I/O
     std::shared_ptr<PSIO> _psio;
+    /// The in-core error vectors, one row per subspace entry
+    std::vector<double> _errorStore;
+    /// The in-core vectors, one row per subspace entry
+    std::vector<double> _vectorStore;
 };
 
 }  // namespace psi
@@ -190,6 +190,17 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
     }
 #endif
 
+    /* Not enough core for the whole sort: stream the input once through on-disk buckets */
+#ifndef ALL_BUF4_SORT_OOC
+    if (!incore) {
+        buf4_close(&OutBuf);
+#ifdef DPD_TIMER
+        timer_off("buf4_sort");
+#endif
+        return buf4_sort_bucket(InBuf, outfilenum, index, pqnum, rsnum, label);
+    }
+#endif
+
 #ifdef ALL_BUF4_SORT_OOC
     switch (index) {
         case (pqsr):
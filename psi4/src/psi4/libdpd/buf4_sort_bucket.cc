@@ -0,0 +1,396 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Out-of-core buf4 sort that reads the input only once
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "psi4/libqt/qt.h"
+#include "psi4/libpsio/psio.h"
+#include "psi4/psifiles.h"
+#include "dpd.h"
+#include "psi4/psi4-dec.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+namespace psi {
+
+namespace {
+
+/* Target index labels in the order of enum indices.  Character j names the
+** source index (p, q, r or s) that ends up in position j of the target. */
+const char *sort_targets[] = {"pqrs", "pqsr", "prqs", "prsq", "psqr", "psrq", "qprs", "qpsr",
+                              "qrps", "qrsp", "qspr", "qsrp", "rqps", "rqsp", "rpqs", "rpsq",
+                              "rsqp", "rspq", "sqrp", "sqpr", "srqp", "srpq", "spqr", "sprq"};
+
+/* A contiguous range of target rows within one row irrep */
+struct SortBucket {
+    int h;
+    int start;
+    int nrows;
+    size_t ncols;
+    /* spilled (offset, value) chunks: file address and number of pairs */
+    std::vector<std::pair<psio_address, size_t>> chunks;
+};
+
+/* A contiguous range of source rows within one row irrep */
+struct SortChunk {
+    int h;
+    int start;
+    int nrows;
+};
+
+/* Runs file I/O on a single helper thread so that it overlaps with the
+** scatter work on the calling thread.  PSIO is not thread-safe, so at most
+** one batch of tasks is in flight and every start() first waits for the
+** previous batch to finish. */
+class SortIO {
+    std::thread thread_;
+
+   public:
+    ~SortIO() { wait(); }
+    void wait() {
+        if (thread_.joinable()) thread_.join();
+    }
+    void start(std::vector<std::function<void()>> tasks) {
+        wait();
+        if (tasks.empty()) return;
+        thread_ = std::thread([tasks]() {
+            for (const auto &task : tasks) task();
+        });
+    }
+};
+
+}  // namespace
+
+/* buf4_sort_bucket(): Out-of-core version of buf4_sort() for any of the
+** 24 index permutations.
+**
+** The old out-of-core sorts re-read the whole input once per output
+** bucket.  Here the input is streamed exactly once: every element is sent
+** to the output bucket (a range of target rows that fits in core) that
+** owns it, and buckets are spilled to the PSIF_DPD_SORT scratch file as
+** (offset, value) pairs.  A second pass reads each bucket's pairs back,
+** scatters them into a zeroed output block and writes the block.  Reads
+** of the next source chunk and writes of finished batches/buckets run on a
+** helper thread while the current chunk is scattered.
+**
+** Arguments are as for buf4_sort().
+*/
+int DPD::buf4_sort_bucket(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum,
+                          const char *label) {
+    int nirreps = InBuf->params->nirreps;
+    int my_irrep = InBuf->file.my_irrep;
+    dpdbuf4 OutBuf;
+
+#ifdef DPD_TIMER
+    timer_on("buf4_sort_bucket");
+#endif
+
+    buf4_init(&OutBuf, outfilenum, my_irrep, pqnum, rsnum, pqnum, rsnum, 0, label);
+
+    int src[4];
+    for (int j = 0; j < 4; j++) src[j] = sort_targets[index][j] - 'p';
+
+    /* Memory layout (in doubles, out of the free DPD memory):
+    **   pass 1:  1/4 two source chunks, 1/4 per-bucket staging, 1/4 two spill batches
+    **   pass 2:  1/2 two output buckets, <= 1/4 two spilled chunks */
+    size_t memory = dpd_memfree();
+    size_t out_words = memory / 4;
+    size_t in_words = memory / 8;
+
+    /* Partition the target rows into buckets */
+    std::vector<SortBucket> buckets;
+    std::vector<int> first_bucket(nirreps), rows_per_bucket(nirreps);
+    for (int h = 0; h < nirreps; h++) {
+        first_bucket[h] = buckets.size();
+        rows_per_bucket[h] = 1;
+        size_t rowtot = OutBuf.params->rowtot[h];
+        size_t coltot = OutBuf.params->coltot[h ^ my_irrep];
+        if (!rowtot || !coltot) continue;
+        if (coltot > out_words) {
+            outfile->Printf("\nLIBDPD Error: not enough memory for one row in buf4_sort_bucket.\n");
+            dpd_error("buf4_sort_bucket", "outfile");
+        }
+        rows_per_bucket[h] = std::min(rowtot, out_words / coltot);
+        for (size_t row = 0; row < rowtot; row += rows_per_bucket[h]) {
+            SortBucket bucket;
+            bucket.h = h;
+            bucket.start = row;
+            bucket.nrows = std::min(rowtot - row, (size_t)rows_per_bucket[h]);
+            bucket.ncols = coltot;
+            buckets.push_back(bucket);
+        }
+    }
+
+    /* Partition the source rows into chunks */
+    std::vector<SortChunk> chunks;
+    for (int h = 0; h < nirreps; h++) {
+        size_t rowtot = InBuf->params->rowtot[h];
+        size_t coltot = InBuf->params->coltot[h ^ my_irrep];
+        if (!rowtot || !coltot) continue;
+        if (coltot > in_words) {
+            outfile->Printf("\nLIBDPD Error: not enough memory for one row in buf4_sort_bucket.\n");
+            dpd_error("buf4_sort_bucket", "outfile");
+        }
+        size_t rows_per_chunk = std::min(rowtot, in_words / coltot);
+        for (size_t row = 0; row < rowtot; row += rows_per_chunk) {
+            SortChunk chunk;
+            chunk.h = h;
+            chunk.start = row;
+            chunk.nrows = std::min(rowtot - row, rows_per_chunk);
+            chunks.push_back(chunk);
+        }
+    }
+
+    size_t nbuckets = buckets.size();
+    if (!nbuckets) {
+        buf4_close(&OutBuf);
+#ifdef DPD_TIMER
+        timer_off("buf4_sort_bucket");
+#endif
+        return 0;
+    }
+
+    size_t stage_len = std::max((size_t)1, memory / (8 * nbuckets));
+    size_t batch_len = std::max(stage_len, memory / 16);
+
+    psio_open(PSIF_DPD_SORT, PSIO_OPEN_NEW);
+    psio_address spill_next = PSIO_ZERO;
+
+    SortIO io;
+
+    /*** Pass 1: stream the source once and spill (offset, value) pairs per bucket ***/
+    int max_chunk_rows = 0;
+    for (const auto &chunk : chunks) max_chunk_rows = std::max(max_chunk_rows, chunk.nrows);
+    double **inblock[2];
+    std::vector<double *> inrows[2];
+    for (int i = 0; i < 2; i++) {
+        inblock[i] = dpd_block_matrix(1, in_words);
+        inrows[i].resize(max_chunk_rows);
+    }
+    double **stage = dpd_block_matrix(nbuckets, 2 * stage_len);
+    double **batch = dpd_block_matrix(2, 2 * batch_len);
+    std::vector<size_t> stage_count(nbuckets, 0);
+
+    /* (bucket, first pair in batch, number of pairs) for the current batch */
+    std::vector<std::pair<size_t, std::pair<size_t, size_t>>> batch_map;
+    size_t batch_fill = 0;
+    int batch_cur = 0;
+
+    std::vector<double **> in_matrix(nirreps);
+    for (int h = 0; h < nirreps; h++) in_matrix[h] = InBuf->matrix[h];
+
+    auto read_chunk = [&](size_t c, int slot) {
+        const SortChunk &chunk = chunks[c];
+        size_t coltot = InBuf->params->coltot[chunk.h ^ my_irrep];
+        for (int i = 0; i < chunk.nrows; i++) inrows[slot][i] = inblock[slot][0] + i * coltot;
+        return [this, InBuf, chunk, &inrows, slot]() {
+            InBuf->matrix[chunk.h] = inrows[slot].data();
+            buf4_mat_irrep_rd_block(InBuf, chunk.h, chunk.start, chunk.nrows);
+        };
+    };
+
+    auto spill_batch = [&]() {
+        if (!batch_fill) return;
+        for (const auto &entry : batch_map)
+            buckets[entry.first].chunks.push_back(std::make_pair(
+                psio_get_address(spill_next, 2 * entry.second.first * sizeof(double)), entry.second.second));
+        char *buffer = (char *)batch[batch_cur];
+        size_t size = 2 * batch_fill * sizeof(double);
+        psio_address start = spill_next;
+        spill_next = psio_get_address(spill_next, size);
+        io.start({[buffer, size, start]() {
+            psio_address next;
+            psio_write(PSIF_DPD_SORT, "Sort spill", buffer, size, start, &next);
+        }});
+        batch_cur ^= 1;
+        batch_fill = 0;
+        batch_map.clear();
+    };
+
+    auto flush_bucket = [&](size_t b) {
+        if (!stage_count[b]) return;
+        if (batch_fill + stage_count[b] > batch_len) spill_batch();
+        std::memcpy(batch[batch_cur] + 2 * batch_fill, stage[b], 2 * stage_count[b] * sizeof(double));
+        batch_map.push_back(std::make_pair(b, std::make_pair(batch_fill, stage_count[b])));
+        batch_fill += stage_count[b];
+        stage_count[b] = 0;
+    };
+
+    if (!chunks.empty()) read_chunk(0, 0)();
+
+    for (size_t c = 0; c < chunks.size(); c++) {
+        int slot = c & 1;
+        if (c + 1 < chunks.size()) io.start({read_chunk(c + 1, slot ^ 1)});
+
+        const SortChunk &chunk = chunks[c];
+        int hc = chunk.h ^ my_irrep;
+        int coltot = InBuf->params->coltot[hc];
+        for (int i = 0; i < chunk.nrows; i++) {
+            int row = chunk.start + i;
+            int a = InBuf->params->roworb[chunk.h][row][0];
+            int b = InBuf->params->roworb[chunk.h][row][1];
+            int nrowvar = (InBuf->params->perm_pq && a != b && InBuf->params->rowidx[b][a] == row) ? 2 : 1;
+            const double *values = inrows[slot][i];
+            for (int col = 0; col < coltot; col++) {
+                double value = values[col];
+                if (value == 0.0) continue;
+                int c0 = InBuf->params->colorb[hc][col][0];
+                int c1 = InBuf->params->colorb[hc][col][1];
+                int ncolvar = (InBuf->params->perm_rs && c0 != c1 && InBuf->params->colidx[c1][c0] == col) ? 2 : 1;
+                for (int rv = 0; rv < nrowvar; rv++) {
+                    for (int cv = 0; cv < ncolvar; cv++) {
+                        int orb[4] = {rv ? b : a, rv ? a : b, cv ? c1 : c0, cv ? c0 : c1};
+                        int P = orb[src[0]], Q = orb[src[1]], R = orb[src[2]], S = orb[src[3]];
+
+                        /* only elements stored in the target's packed layout */
+                        int pq = OutBuf.params->rowidx[P][Q];
+                        int rs = OutBuf.params->colidx[R][S];
+                        if (pq < 0 || rs < 0) continue;
+                        int Gpq = OutBuf.params->psym[P] ^ OutBuf.params->qsym[Q];
+                        int Grs = Gpq ^ my_irrep;
+                        if (OutBuf.params->roworb[Gpq][pq][0] != P || OutBuf.params->roworb[Gpq][pq][1] != Q) continue;
+                        if (OutBuf.params->colorb[Grs][rs][0] != R || OutBuf.params->colorb[Grs][rs][1] != S) continue;
+
+                        size_t bk = first_bucket[Gpq] + pq / rows_per_bucket[Gpq];
+                        const SortBucket &bucket = buckets[bk];
+                        double *pair = stage[bk] + 2 * stage_count[bk];
+                        pair[0] = (double)((pq - bucket.start) * bucket.ncols + rs);
+                        pair[1] = value;
+                        if (++stage_count[bk] == stage_len) flush_bucket(bk);
+                    }
+                }
+            }
+        }
+        io.wait();
+    }
+
+    for (size_t b = 0; b < nbuckets; b++) flush_bucket(b);
+    spill_batch();
+    io.wait();
+
+    for (int h = 0; h < nirreps; h++) InBuf->matrix[h] = in_matrix[h];
+    free_dpd_block(batch, 2, 2 * batch_len);
+    free_dpd_block(stage, nbuckets, 2 * stage_len);
+    for (int i = 0; i < 2; i++) free_dpd_block(inblock[i], 1, in_words);
+
+    /*** Pass 2: gather each bucket's pairs into core and write it ***/
+    int max_bucket_rows = 0;
+    for (const auto &bucket : buckets) max_bucket_rows = std::max(max_bucket_rows, bucket.nrows);
+    double **outblock[2];
+    std::vector<double *> outrows[2];
+    double **pairs[2];
+    for (int i = 0; i < 2; i++) {
+        outblock[i] = dpd_block_matrix(1, out_words);
+        outrows[i].resize(max_bucket_rows);
+        pairs[i] = dpd_block_matrix(1, 2 * stage_len);
+    }
+
+    std::vector<std::pair<size_t, size_t>> spilled;  // (bucket, chunk) in read order
+    for (size_t b = 0; b < nbuckets; b++)
+        for (size_t k = 0; k < buckets[b].chunks.size(); k++) spilled.push_back(std::make_pair(b, k));
+
+    auto read_pairs = [&](size_t g) {
+        const auto &chunk = buckets[spilled[g].first].chunks[spilled[g].second];
+        char *buffer = (char *)pairs[g & 1][0];
+        return [buffer, chunk]() {
+            psio_address next;
+            psio_read(PSIF_DPD_SORT, "Sort spill", buffer, 2 * chunk.second * sizeof(double), chunk.first, &next);
+        };
+    };
+
+    auto write_bucket = [&](size_t b) {
+        const SortBucket &bucket = buckets[b];
+        int slot = b & 1;
+        for (int i = 0; i < bucket.nrows; i++) outrows[slot][i] = outblock[slot][0] + i * bucket.ncols;
+        return [this, &OutBuf, &outrows, bucket, slot]() {
+            OutBuf.matrix[bucket.h] = outrows[slot].data();
+            buf4_mat_irrep_wrt_block(&OutBuf, bucket.h, bucket.start, bucket.nrows);
+        };
+    };
+
+    if (!spilled.empty()) read_pairs(0)();
+
+    /* A finished bucket is written while the next bucket's first chunk is scattered */
+    std::vector<std::function<void()>> pending;
+    size_t g = 0;
+    for (size_t b = 0; b < nbuckets; b++) {
+        const SortBucket &bucket = buckets[b];
+        double *out = outblock[b & 1][0];
+        std::memset(out, 0, bucket.nrows * bucket.ncols * sizeof(double));
+
+        for (size_t k = 0; k < bucket.chunks.size(); k++, g++) {
+            std::vector<std::function<void()>> tasks;
+            tasks.swap(pending);
+            if (g + 1 < spilled.size()) tasks.push_back(read_pairs(g + 1));
+            io.start(tasks);
+
+            const double *pair = pairs[g & 1][0];
+            size_t npairs = bucket.chunks[k].second;
+            for (size_t n = 0; n < npairs; n++) out[(size_t)pair[2 * n]] = pair[2 * n + 1];
+
+            io.wait();
+        }
+
+        if (bucket.chunks.empty()) {
+            /* all-zero bucket: nothing to overlap its write with */
+            pending.push_back(write_bucket(b));
+            io.start(pending);
+            io.wait();
+            pending.clear();
+        } else
+            pending.push_back(write_bucket(b));
+    }
+    io.start(pending);
+    io.wait();
+
+    for (int i = 0; i < 2; i++) {
+        free_dpd_block(pairs[i], 1, 2 * stage_len);
+        free_dpd_block(outblock[i], 1, out_words);
+    }
+
+    psio_close(PSIF_DPD_SORT, 0);
+
+    buf4_close(&OutBuf);
+
+#ifdef DPD_TIMER
+    timer_off("buf4_sort_bucket");
+#endif
+
+    return 0;
+}
+
+}  // namespace psi
@@ -32,13 +32,46 @@
 */
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
+#include <thread>
+#include <vector>
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsio/psio.h"
 #include "dpd.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef USING_LAPACK_MKL
+#include <mkl.h>
+#endif
 
 namespace psi {
 
+namespace {
+
+/* Irreps of Y and Z paired with irrep Hx of X for the given transposition pattern */
+void contract444_irreps(int Hx, int GX, int GY, int Xtrans, int Ytrans, int &Hy, int &Hz) {
+    if ((!Xtrans) && (!Ytrans)) {
+        Hy = Hx ^ GX;
+        Hz = Hx;
+    } else if ((!Xtrans) && (Ytrans)) {
+        Hy = Hx ^ GX ^ GY;
+        Hz = Hx;
+    } else if ((Xtrans) && (!Ytrans)) {
+        Hy = Hx;
+        Hz = Hx ^ GX;
+    } else /* (( Xtrans)&&( Ytrans))*/ {
+        Hy = Hx ^ GY;
+        Hz = Hx ^ GX;
+    }
+}
+
+}  // namespace
+
 /* dpd_contract444(): Contracts a pair of four-index quantities to
 ** give a product four-index quantity.
 **
@@ -58,7 +91,8 @@ namespace psi {
 int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int target_Y, double alpha, double beta) {
     int n, Hx, Hy, Hz, GX, GY, GZ, nirreps, Xtrans, Ytrans, *numlinks, symlink;
     long int size_Y, size_Z, size_file_X_row;
-    int incore, nbuckets;
+    int incore, nbuckets, prefetch;
+    double **Xbuf[2];
     long int memoryd, core, rows_per_bucket, rows_left, memtotal;
     int nrows, ncols, nlinks;
 #if DPD_DEBUG
@@ -112,20 +146,15 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
     }
 #endif
 
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = Process::environment.get_n_threads();
+#endif
+    if (nthreads > 1 && nirreps > 1 && !contract444_concurrent(X, Y, Z, Xtrans, Ytrans, alpha, beta, nthreads))
+        return 0;
+
     for (Hx = 0; Hx < nirreps; Hx++) {
-        if ((!Xtrans) && (!Ytrans)) {
-            Hy = Hx ^ GX;
-            Hz = Hx;
-        } else if ((!Xtrans) && (Ytrans)) {
-            Hy = Hx ^ GX ^ GY;
-            Hz = Hx;
-        } else if ((Xtrans) && (!Ytrans)) {
-            Hy = Hx;
-            Hz = Hx ^ GX;
-        } else /* (( Xtrans)&&( Ytrans))*/ {
-            Hy = Hx ^ GY;
-            Hz = Hx ^ GX;
-        }
+        contract444_irreps(Hx, GX, GY, Xtrans, Ytrans, Hy, Hz);
 
         size_Y = ((long)Y->params->rowtot[Hy]) * ((long)Y->params->coltot[Hy ^ GY]);
         size_Z = ((long)Z->params->rowtot[Hz]) * ((long)Z->params->coltot[Hz ^ GZ]);
@@ -145,10 +174,18 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
 
             nbuckets = (int)ceil((double)X->params->rowtot[Hx] / (double)rows_per_bucket);
 
-            rows_left = X->params->rowtot[Hx] % rows_per_bucket;
-
             incore = 1;
             if (nbuckets > 1) incore = 0;
+
+            /* Out of core, hold two buckets of X so the next one is read while the current one is multiplied */
+            prefetch = 0;
+            if (!incore && rows_per_bucket > 1) {
+                rows_per_bucket /= 2;
+                nbuckets = (int)ceil((double)X->params->rowtot[Hx] / (double)rows_per_bucket);
+                prefetch = 1;
+            }
+
+            rows_left = X->params->rowtot[Hx] - (nbuckets - 1) * rows_per_bucket;
         } else
             incore = 1;
 
@@ -207,24 +244,38 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
             }
 
             buf4_mat_irrep_init_block(X, Hx, rows_per_bucket);
+            Xbuf[0] = X->matrix[Hx];
+            Xbuf[1] = prefetch ? dpd_block_matrix(rows_per_bucket, X->params->coltot[Hx ^ GX]) : nullptr;
 
             buf4_mat_irrep_init(Y, Hy);
             buf4_mat_irrep_rd(Y, Hy);
             buf4_mat_irrep_init(Z, Hz);
             if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
+            buf4_mat_irrep_rd_block(X, Hx, 0, (nbuckets > 1) ? rows_per_bucket : rows_left);
+
             for (n = 0; n < nbuckets; n++) {
-                if (n < (nbuckets - 1))
-                    buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, rows_per_bucket);
-                else
-                    buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, rows_left);
+                double **Xblock = prefetch ? Xbuf[n % 2] : Xbuf[0];
+
+                /* Start reading the next bucket into the idle buffer; the main thread only does DGEMM
+                   until the reader is joined, so the DPD/PSIO state is touched by one thread at a time. */
+                std::thread reader;
+                if (n < (nbuckets - 1)) {
+                    int next_rows = (n + 1) < (nbuckets - 1) ? rows_per_bucket : rows_left;
+                    if (prefetch) {
+                        X->matrix[Hx] = Xbuf[(n + 1) % 2];
+                        reader = std::thread([this, X, Hx, n, rows_per_bucket, next_rows]() {
+                            buf4_mat_irrep_rd_block(X, Hx, (n + 1) * rows_per_bucket, next_rows);
+                        });
+                    }
+                }
 
                 if (!Xtrans && Ytrans) {
                     nrows = n < (nbuckets - 1) ? rows_per_bucket : rows_left;
                     ncols = Z->params->coltot[Hz ^ GZ];
                     nlinks = numlinks[Hx ^ symlink];
                     if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 't', nrows, ncols, nlinks, alpha, &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink],
+                        C_DGEMM('n', 't', nrows, ncols, nlinks, alpha, &(Xblock[0][0]), numlinks[Hx ^ symlink],
                                 &(Y->matrix[Hy][0][0]), numlinks[Hx ^ symlink], beta,
                                 &(Z->matrix[Hz][n * rows_per_bucket][0]), Z->params->coltot[Hz ^ GZ]);
                 } else if (Xtrans && !Ytrans) {
@@ -236,13 +287,21 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
                     ncols = Z->params->coltot[Hz ^ GZ];
                     nlinks = n < (nbuckets - 1) ? rows_per_bucket : rows_left;
                     if (nrows && ncols && nlinks)
-                        C_DGEMM('t', 'n', nrows, ncols, nlinks, alpha, &(X->matrix[Hx][0][0]),
-                                X->params->coltot[Hx ^ GX], &(Y->matrix[Hy][n * rows_per_bucket][0]),
-                                Y->params->coltot[Hy ^ GY], (n == 0 ? beta : 1.0), &(Z->matrix[Hz][0][0]),
-                                Z->params->coltot[Hz ^ GZ]);
+                        C_DGEMM('t', 'n', nrows, ncols, nlinks, alpha, &(Xblock[0][0]), X->params->coltot[Hx ^ GX],
+                                &(Y->matrix[Hy][n * rows_per_bucket][0]), Y->params->coltot[Hy ^ GY],
+                                (n == 0 ? beta : 1.0), &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz ^ GZ]);
+                }
+
+                if (reader.joinable()) {
+                    reader.join();
+                } else if (n < (nbuckets - 1)) {
+                    int next_rows = (n + 1) < (nbuckets - 1) ? rows_per_bucket : rows_left;
+                    buf4_mat_irrep_rd_block(X, Hx, (n + 1) * rows_per_bucket, next_rows);
                 }
             }
 
+            X->matrix[Hx] = Xbuf[0];
+            if (prefetch) free_dpd_block(Xbuf[1], rows_per_bucket, X->params->coltot[Hx ^ GX]);
             buf4_mat_irrep_close_block(X, Hx, rows_per_bucket);
 
             buf4_mat_irrep_close(Y, Hy);
@@ -255,4 +314,94 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
     return 0;
 }
 
+/* contract444_concurrent(): In-core variant of contract444() that runs
+** the per-irrep DGEMMs concurrently.
+**
+** The symmetry blocks of a DPD contraction are often too small to keep a
+** threaded BLAS busy, so when all irreps of X, Y, and Z fit in memory at
+** once, the blocks are read up front, multiplied in parallel over irreps
+** (largest first, with the threads split between the irrep loop and the
+** BLAS), and written back afterwards. If one block dominates the work, or
+** the blocks do not fit, nothing is touched and 1 is returned so the
+** caller falls back to the serial irrep loop.
+**
+** Arguments are as for contract444(), except that Xtrans and Ytrans are
+** the DGEMM transposition flags and nthreads is the total thread count.
+*/
+
+int DPD::contract444_concurrent(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int Xtrans, int Ytrans, double alpha, double beta,
+                                int nthreads) {
+    int nirreps = X->params->nirreps;
+    int GX = X->file.my_irrep;
+    int GY = Y->file.my_irrep;
+    int GZ = Z->file.my_irrep;
+    int *numlinks = Xtrans ? X->params->rowtot : X->params->coltot;
+    int symlink = Xtrans ? 0 : GX;
+
+    /* All irreps are held simultaneously, so the buffers must be distinct */
+    if (X == Y || X == Z || Y == Z) return 1;
+
+    std::vector<int> Hy(nirreps), Hz(nirreps);
+    std::vector<double> flops(nirreps, 0.0);
+    std::vector<int> blocks;
+    long int memory = 0;
+    double total_flops = 0.0, max_flops = 0.0;
+    for (int Hx = 0; Hx < nirreps; Hx++) {
+        contract444_irreps(Hx, GX, GY, Xtrans, Ytrans, Hy[Hx], Hz[Hx]);
+        memory += ((long)X->params->rowtot[Hx]) * ((long)X->params->coltot[Hx ^ GX]);
+        memory += ((long)Y->params->rowtot[Hy[Hx]]) * ((long)Y->params->coltot[Hy[Hx] ^ GY]);
+        memory += ((long)Z->params->rowtot[Hz[Hx]]) * ((long)Z->params->coltot[Hz[Hx] ^ GZ]);
+        if (Z->params->rowtot[Hz[Hx]] && Z->params->coltot[Hz[Hx] ^ GZ] && numlinks[Hx ^ symlink]) {
+            flops[Hx] = 2.0 * Z->params->rowtot[Hz[Hx]] * Z->params->coltot[Hz[Hx] ^ GZ] * numlinks[Hx ^ symlink];
+            total_flops += flops[Hx];
+            max_flops = std::max(max_flops, flops[Hx]);
+            blocks.push_back(Hx);
+        }
+    }
+
+    /* With a single dominant block, a threaded DGEMM on it beats splitting the irreps */
+    if (blocks.size() < 2 || max_flops > 0.5 * total_flops) return 1;
+    if (memory > dpd_memfree()) return 1;
+
+    std::sort(blocks.begin(), blocks.end(), [&flops](int a, int b) { return flops[a] > flops[b]; });
+
+    for (int Hx = 0; Hx < nirreps; Hx++) {
+        buf4_mat_irrep_init(X, Hx);
+        buf4_mat_irrep_rd(X, Hx);
+        buf4_mat_irrep_init(Y, Hy[Hx]);
+        buf4_mat_irrep_rd(Y, Hy[Hx]);
+        buf4_mat_irrep_init(Z, Hz[Hx]);
+        if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz[Hx]);
+    }
+
+    int nblocks = blocks.size();
+    int dpd_threads = std::min(nthreads, nblocks);
+#ifdef USING_LAPACK_MKL
+    int old_threads = mkl_get_max_threads();
+    mkl_set_num_threads(std::max(1, nthreads / dpd_threads));
+#endif
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(dpd_threads)
+    for (int b = 0; b < nblocks; b++) {
+        int Hx = blocks[b];
+        C_DGEMM(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz[Hx]], Z->params->coltot[Hz[Hx] ^ GZ],
+                numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx ^ GX],
+                &(Y->matrix[Hy[Hx]][0][0]), Y->params->coltot[Hy[Hx] ^ GY], beta, &(Z->matrix[Hz[Hx]][0][0]),
+                Z->params->coltot[Hz[Hx] ^ GZ]);
+    }
+
+#ifdef USING_LAPACK_MKL
+    mkl_set_num_threads(old_threads);
+#endif
+
+    for (int Hx = 0; Hx < nirreps; Hx++) {
+        buf4_mat_irrep_close(X, Hx);
+        buf4_mat_irrep_wrt(Z, Hz[Hx]);
+        buf4_mat_irrep_close(Y, Hy[Hx]);
+        buf4_mat_irrep_close(Z, Hz[Hx]);
+    }
+
+    return 0;
+}
+
 }  // namespace psi
@@ -43,6 +43,8 @@ PRAGMA_WARNING_IGNORE_DEPRECATED_DECLARATIONS
 #include <memory>
 PRAGMA_WARNING_POP
 #include <vector>
+#include <set>
+#include <map>
 #include "psi4/psi4-dec.h"
 
 // Testing -TDC
@@ -161,6 +163,7 @@ struct dpd_file4_cache_entry {
     size_t access;               /* access time */
     size_t usage;                /* number of accesses */
     size_t priority;             /* priority level */
+    double age;                  /* cost-aware cache inflation value at last access */
     int lock;                    /* auto-deletion allowed? */
     int clean;                   /* has this file4 changed? */
     dpd_file4_cache_entry *next; /* pointer to next cache entry */
@@ -245,13 +248,42 @@ struct dpd_gbl {
           file4_cache_most_recent(0),
           file4_cache_least_recent(1),
           file4_cache_lru_del(0),
-          file4_cache_low_del(0) {}
+          file4_cache_low_del(0),
+          file4_cache_cost_del(0),
+          file4_cache_age(0.0),
+          file4_cache_hits(0),
+          file4_cache_misses(0),
+          file4_cache_bytes_read(0),
+          file4_cache_bytes_reread(0),
+          file4_cache_bytes_written(0),
+          file4_cache_read_time(0.0),
+          file4_cache_write_time(0.0),
+          file4_cache_bytes_timed_written(0),
+          file4_cache_read_latency(0.0),
+          file4_cache_cost_nonlfu(0) {}
     dpd_file2_cache_entry *file2_cache;
     dpd_file4_cache_entry *file4_cache;
     size_t file4_cache_most_recent;
     size_t file4_cache_least_recent;
     size_t file4_cache_lru_del;
     size_t file4_cache_low_del;
+    size_t file4_cache_cost_del;
+    /* Cost-aware cache (cachetype 2) bookkeeping and statistics for all cache types */
+    double file4_cache_age;
+    size_t file4_cache_hits;
+    size_t file4_cache_misses;
+    size_t file4_cache_bytes_read;
+    size_t file4_cache_bytes_reread;
+    size_t file4_cache_bytes_written;
+    double file4_cache_read_time;
+    double file4_cache_write_time;
+    size_t file4_cache_bytes_timed_written;
+    /* Timed read of each file4 brought into the cache, by key, and the shortest one */
+    std::map<std::string, double> file4_cache_load_time;
+    double file4_cache_read_latency;
+    /* Cost-aware evictions of an entry used more often than the least used one */
+    size_t file4_cache_cost_nonlfu;
+    std::set<std::string> file4_cache_evicted;
     int cachetype;
     int *cachefiles;
     int **cachelist;
@@ -333,6 +365,8 @@ class PSI_API DPD {
     int contract244(dpdfile2 *X, dpdbuf4 *Y, dpdbuf4 *Z, int sum_X, int sum_Y, int trans_Z, double alpha, double beta);
     int contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y, int trans_Z, double alpha, double beta);
     int contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int target_Y, double alpha, double beta);
+    int contract444_concurrent(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int Xtrans, int Ytrans, double alpha, double beta,
+                               int nthreads);
     int contract444_df(dpdbuf4 *B, dpdbuf4 *tau_in, dpdbuf4 *tau_out, double alpha, double beta);
 
     /* Need to consolidate these routines into one general function */
@@ -394,6 +428,8 @@ class PSI_API DPD {
     int buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, std::string pq, std::string rs,
                   const char *label);
     int buf4_sort_ooc(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const char *label);
+    int buf4_sort_bucket(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum,
+                         const char *label);
     int buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const char *label,
                        double alpha);
     int buf4_axpy(dpdbuf4 *BufX, dpdbuf4 *BufY, double alpha);
@@ -437,12 +473,15 @@ class PSI_API DPD {
     int file2_cache_add(dpdfile2 *File);
     int file2_cache_del(dpdfile2 *File);
     int file4_cache_del_low();
+    int file4_cache_del_cost();
     void file2_cache_dirty(dpdfile2 *File);
 
     void file4_cache_init();
     void file4_cache_close();
     void file4_cache_print(std::string out_fname);
     void file4_cache_print_screen();
+    void file4_cache_print_stats(std::string out_fname);
+    size_t file4_cache_nonlfu_evictions() const;
     int file4_cache_get_priority(dpdfile4 *File);
 
     dpd_file4_cache_entry *file4_cache_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label,
@@ -451,6 +490,7 @@ class PSI_API DPD {
     int file4_cache_add(dpdfile4 *File, size_t priority);
     int file4_cache_del(dpdfile4 *File);
     dpd_file4_cache_entry *file4_cache_find_lru();
+    dpd_file4_cache_entry *file4_cache_find_cost();
     int file4_cache_del_lru();
     void file4_cache_dirty(dpdfile4 *File);
     void file4_cache_lock(dpdfile4 *File);
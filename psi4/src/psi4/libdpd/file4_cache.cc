@@ -33,17 +33,84 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <string>
 #include "psi4/libqt/qt.h"
 #include "dpd.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 namespace psi {
 
+namespace {
+
+/* Key identifying a file4 across cache insertions and deletions */
+std::string file4_cache_key(int dpdnum, int filenum, int irrep, int pqnum, int rsnum, const char *label) {
+    return std::to_string(dpdnum) + ":" + std::to_string(filenum) + ":" + std::to_string(irrep) + ":" +
+           std::to_string(pqnum) + ":" + std::to_string(rsnum) + ":" + label;
+}
+
+/* Measured seconds per double word of cache I/O. Reads and write-backs are
+   timed as they happen; until some have been seen, assume 100 MB/s. */
+double file4_cache_seconds_per_word() {
+    size_t bytes = dpd_main.file4_cache_bytes_read + dpd_main.file4_cache_bytes_timed_written;
+    double time = dpd_main.file4_cache_read_time + dpd_main.file4_cache_write_time;
+    if (bytes == 0 || time <= 0.0) return sizeof(double) / 1.0e8;
+    return time * sizeof(double) / (double)bytes;
+}
+
+/* Seconds it takes to bring an entry back into the cache. An entry that was read
+   before costs what that read took, so small reads pay for their latency; one
+   built in core is priced at the shortest read seen plus its size at the measured
+   bandwidth. A dirty entry is also written out first. */
+double file4_cache_reload_time(const dpd_file4_cache_entry *entry) {
+    double seconds_per_word = file4_cache_seconds_per_word();
+    auto timed = dpd_main.file4_cache_load_time.find(
+        file4_cache_key(entry->dpdnum, entry->filenum, entry->irrep, entry->pqnum, entry->rsnum, entry->label));
+    double cost;
+    if (timed != dpd_main.file4_cache_load_time.end())
+        cost = timed->second;
+    else
+        cost = dpd_main.file4_cache_read_latency + entry->size * seconds_per_word;
+    if (!entry->clean) cost += entry->size * seconds_per_word;
+    return cost;
+}
+
+/* Benefit per word of keeping an entry in the cost-aware cache: its inflation
+   value at last access plus the access frequency times the cost of bringing it
+   back per word of memory. */
+double file4_cache_benefit(const dpd_file4_cache_entry *entry) {
+    double size = entry->size ? (double)entry->size : 1.0;
+    return entry->age + (double)entry->usage * file4_cache_reload_time(entry) / size;
+}
+
+/* Remember an automatically evicted entry so a later re-read can be counted */
+void file4_cache_note_eviction(const dpd_file4_cache_entry *entry) {
+    dpd_main.file4_cache_evicted.insert(
+        file4_cache_key(entry->dpdnum, entry->filenum, entry->irrep, entry->pqnum, entry->rsnum, entry->label));
+    if (!entry->clean) dpd_main.file4_cache_bytes_written += (size_t)entry->size * sizeof(double);
+}
+
+}  // namespace
+
 void DPD::file4_cache_init() {
     dpd_main.file4_cache = nullptr;
     dpd_main.file4_cache_most_recent = 0;
     dpd_main.file4_cache_least_recent = 1;
     dpd_main.file4_cache_lru_del = 0;
     dpd_main.file4_cache_low_del = 0;
+    dpd_main.file4_cache_cost_del = 0;
+    dpd_main.file4_cache_age = 0.0;
+    dpd_main.file4_cache_hits = 0;
+    dpd_main.file4_cache_misses = 0;
+    dpd_main.file4_cache_bytes_read = 0;
+    dpd_main.file4_cache_bytes_reread = 0;
+    dpd_main.file4_cache_bytes_written = 0;
+    dpd_main.file4_cache_read_time = 0.0;
+    dpd_main.file4_cache_write_time = 0.0;
+    dpd_main.file4_cache_bytes_timed_written = 0;
+    dpd_main.file4_cache_load_time.clear();
+    dpd_main.file4_cache_read_latency = 0.0;
+    dpd_main.file4_cache_cost_nonlfu = 0;
+    dpd_main.file4_cache_evicted.clear();
 }
 
 void DPD::file4_cache_close() {
@@ -98,6 +165,9 @@ dpd_file4_cache_entry *DPD::file4_cache_scan(int filenum, int irrep, int pqnum,
             /* increment the usage counter */
             this_entry->usage++;
 
+            /* refresh the cost-aware inflation value */
+            this_entry->age = dpd_main.file4_cache_age;
+
             return (this_entry);
         }
 
@@ -137,6 +207,7 @@ int DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
     } else if (this_entry != nullptr && File->incore) {
         /* We already have this one in cache, but change its priority level */
         this_entry->priority = priority;
+        dpd_main.file4_cache_hits++;
         return 0;
     } else if (this_entry == nullptr && !(File->incore)) { /* New cache entry */
 
@@ -146,13 +217,27 @@ int DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
         dpdnum = dpd_default;
         dpd_set_default(File->dpdnum);
 
-        /* Read all data into core */
+        /* Read all data into core, timing the read for the cost-aware policy */
+        auto start = std::chrono::steady_clock::now();
         this_entry->size = 0;
         for (h = 0; h < File->params->nirreps; h++) {
             this_entry->size += File->params->rowtot[h] * File->params->coltot[h ^ (File->my_irrep)];
             file4_mat_irrep_init(File, h);
             file4_mat_irrep_rd(File, h);
         }
+        double read_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        /* Update the cache statistics */
+        size_t bytes = (size_t)this_entry->size * sizeof(double);
+        dpd_main.file4_cache_misses++;
+        dpd_main.file4_cache_bytes_read += bytes;
+        dpd_main.file4_cache_read_time += read_time;
+        if (dpd_main.file4_cache_misses == 1 || read_time < dpd_main.file4_cache_read_latency)
+            dpd_main.file4_cache_read_latency = read_time;
+        std::string key = file4_cache_key(File->dpdnum, File->filenum, File->my_irrep, File->params->pqnum,
+                                          File->params->rsnum, File->label);
+        dpd_main.file4_cache_load_time[key] = read_time;
+        if (dpd_main.file4_cache_evicted.count(key)) dpd_main.file4_cache_bytes_reread += bytes;
 
         this_entry->dpdnum = File->dpdnum;
         this_entry->filenum = File->filenum;
@@ -176,6 +261,7 @@ int DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
 
         /* initialize the usage counter */
         this_entry->usage = 1;
+        this_entry->age = dpd_main.file4_cache_age;
 
         /* Set the clean flag */
         this_entry->clean = 1;
@@ -219,11 +305,17 @@ int DPD::file4_cache_del(dpdfile4 *File) {
 
         File->incore = 0;
 
-        /* Write all the data to disk and free the memory */
+        /* Write all the data to disk and free the memory, timing the write-back for the cost-aware policy */
+        auto start = std::chrono::steady_clock::now();
         for (h = 0; h < File->params->nirreps; h++) {
             if (!(this_entry->clean)) file4_mat_irrep_wrt(File, h);
             file4_mat_irrep_close(File, h);
         }
+        if (!(this_entry->clean)) {
+            dpd_main.file4_cache_write_time +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            dpd_main.file4_cache_bytes_timed_written += (size_t)this_entry->size * sizeof(double);
+        }
 
         next_entry = this_entry->next;
         last_entry = this_entry->last;
@@ -367,6 +459,7 @@ int DPD::file4_cache_del_lru() {
 
         /* increment the global LRU deletion counter */
         dpd_main.file4_cache_lru_del++;
+        file4_cache_note_eviction(this_entry);
 
         /* Save the current dpd_default */
         dpdnum = dpd_default;
@@ -470,6 +563,7 @@ int DPD::file4_cache_del_low() {
 
         /* increment the global LOW deletion counter */
         dpd_main.file4_cache_low_del++;
+        file4_cache_note_eviction(this_entry);
 
         /* save the current dpd default value */
         dpdnum = dpd_default;
@@ -492,6 +586,104 @@ int DPD::file4_cache_del_low() {
     }
 }
 
+/* file4_cache_find_cost(): Locates the unlocked entry with the smallest
+** benefit per word of memory, i.e. the cheapest one to evict under the
+** cost-aware (cachetype = 2) policy. The inflation value of each entry
+** is refreshed on access, so long-unused entries age out as in LRU while
+** frequently re-read or expensive entries are retained.
+*/
+dpd_file4_cache_entry *DPD::file4_cache_find_cost() {
+    dpd_file4_cache_entry *this_entry, *low_entry;
+    double low_benefit = 0.0;
+
+    low_entry = nullptr;
+    for (this_entry = dpd_main.file4_cache; this_entry != nullptr; this_entry = this_entry->next) {
+        if (this_entry->lock) continue;
+        double benefit = file4_cache_benefit(this_entry);
+        if (low_entry == nullptr || benefit < low_benefit) {
+            low_entry = this_entry;
+            low_benefit = benefit;
+        }
+    }
+
+    return low_entry;
+}
+
+int DPD::file4_cache_del_cost() {
+    int dpdnum;
+    dpdfile4 File;
+    dpd_file4_cache_entry *this_entry;
+
+#ifdef DPD_TIMER
+    timer_on("cache_cost");
+#endif
+
+    this_entry = file4_cache_find_cost();
+
+    if (this_entry == nullptr) {
+#ifdef DPD_TIMER
+        timer_off("cache_cost");
+#endif
+        return 1; /* there is no cache or everything is locked */
+    } else {
+        /* increment the global cost-aware deletion counter */
+        dpd_main.file4_cache_cost_del++;
+        file4_cache_note_eviction(this_entry);
+
+        /* count the evictions LFU would not have made */
+        for (dpd_file4_cache_entry *other = dpd_main.file4_cache; other != nullptr; other = other->next) {
+            if (!other->lock && other->usage < this_entry->usage) {
+                dpd_main.file4_cache_cost_nonlfu++;
+                break;
+            }
+        }
+
+        /* entries still in the cache now have to beat the benefit of the one we evicted */
+        dpd_main.file4_cache_age = file4_cache_benefit(this_entry);
+
+        /* save the current dpd default value */
+        dpdnum = dpd_default;
+
+        dpd_set_default(this_entry->dpdnum);
+
+        file4_init(&File, this_entry->filenum, this_entry->irrep, this_entry->pqnum, this_entry->rsnum,
+                   this_entry->label);
+        file4_cache_del(&File);
+        file4_close(&File);
+
+        /* return the default dpd to its original value */
+        dpd_set_default(dpdnum);
+
+#ifdef DPD_TIMER
+        timer_off("cache_cost");
+#endif
+
+        return 0;
+    }
+}
+
+void DPD::file4_cache_print_stats(std::string out) {
+    std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
+    size_t lookups = dpd_main.file4_cache_hits + dpd_main.file4_cache_misses;
+    const char *policy = dpd_main.cachetype == 2 ? "COST" : (dpd_main.cachetype == 1 ? "LOW" : "LRU");
+
+    printer->Printf("\n\tDPD File4 Cache Statistics (%s):\n\n", policy);
+    printer->Printf("\tHits                = %12zu\n", dpd_main.file4_cache_hits);
+    printer->Printf("\tMisses              = %12zu\n", dpd_main.file4_cache_misses);
+    printer->Printf("\tHit rate            = %12.2f %%\n",
+                    lookups ? 100.0 * dpd_main.file4_cache_hits / (double)lookups : 0.0);
+    printer->Printf("\tEvictions           = %12zu\n",
+                    dpd_main.file4_cache_lru_del + dpd_main.file4_cache_low_del + dpd_main.file4_cache_cost_del);
+    printer->Printf("\tRead into cache     = %12.1f MB (%.2f s)\n", dpd_main.file4_cache_bytes_read / 1e6,
+                    dpd_main.file4_cache_read_time);
+    printer->Printf("\tRe-read after evict = %12.1f MB\n", dpd_main.file4_cache_bytes_reread / 1e6);
+    printer->Printf("\tWritten on evict    = %12.1f MB\n", dpd_main.file4_cache_bytes_written / 1e6);
+    if (dpd_main.cachetype == 2)
+        printer->Printf("\tEvictions not LFU   = %12zu\n", dpd_main.file4_cache_cost_nonlfu);
+}
+
+size_t DPD::file4_cache_nonlfu_evictions() const { return dpd_main.file4_cache_cost_nonlfu; }
+
 void DPD::file4_cache_lock(dpdfile4 *File) {
     int h;
     dpd_file4_cache_entry *this_entry;
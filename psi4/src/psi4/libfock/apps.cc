@@ -258,6 +258,7 @@ double RCPHF::compute_energy() {
     // Extra Knobs
     H->set_print(print_);
     H->set_debug(debug_);
+    H->set_product_cutoff(options_.get_double("SOLVER_PRODUCT_CUTOFF"));
     solver->set_convergence(convergence_);
 
     // Addition of force vectors
@@ -345,6 +346,12 @@ void RCIS::sort_states() {
     }
 
     std::sort(states_.begin(), states_.end());
+
+    for (size_t i = 0; i < states_.size(); i++) {
+        std::stringstream s;
+        s << "CIS ROOT 0 -> ROOT " << (i + 1) << " EXCITATION ENERGY";
+        set_scalar_variable(s.str(), std::get<0>(states_[i]));
+    }
 }
 void RCIS::print_wavefunctions() {
     outfile->Printf("  ==> Excitation Energies <==\n\n");
@@ -938,6 +945,8 @@ double RCIS::compute_energy() {
         solver = DLRSolver::build_solver(options_, H);
     else if (options_.get_str("SOLVER_TYPE") == "RAYLEIGH")
         solver = RayleighRSolver::build_solver(options_, H);
+    else if (options_.get_str("SOLVER_TYPE") == "DAVIDSON")
+        solver = DavidsonRSolver::build_solver(options_, H);
 
     // Extra Knobs
     H->set_print(print_);
@@ -954,6 +963,9 @@ double RCIS::compute_energy() {
     H->print_header();
     jk_->print_header();
 
+    // Hamiltonian products (JK builds) over the singlet and triplet solves
+    int nproduct = 0;
+
     // Singlets
     if (options_.get_bool("DO_SINGLETS")) {
         H->set_singlet(true);
@@ -972,6 +984,7 @@ double RCIS::compute_energy() {
         }
 
         solver->solve();
+        nproduct += solver->nproduct();
 
         // Unpack
         const std::vector<std::shared_ptr<Vector> > singlets = solver->eigenvectors();
@@ -1013,6 +1026,7 @@ double RCIS::compute_energy() {
         }
 
         solver->solve();
+        nproduct += solver->nproduct();
 
         const std::vector<std::shared_ptr<Vector> > triplets = solver->eigenvectors();
         const std::vector<std::vector<double> > E_triplets = solver->eigenvalues();
@@ -1042,6 +1056,8 @@ double RCIS::compute_energy() {
         }
     }
 
+    set_scalar_variable("CIS HAMILTONIAN PRODUCTS", nproduct);
+
     // Finalize solver
     solver->finalize();
 
@@ -1092,6 +1108,7 @@ double RTDHF::compute_energy() {
     // Extra Knobs
     H->set_print(print_);
     H->set_debug(debug_);
+    H->set_product_cutoff(options_.get_double("SOLVER_PRODUCT_CUTOFF"));
     solver->set_convergence(convergence_);
 
     // Initialization
@@ -1283,7 +1300,11 @@ double RTDA::compute_energy() {
 
     // Construct components
     auto H = std::make_shared<TDARHamiltonian>(jk_, v_, Cocc_, Caocc_, Cavir_, eps_aocc_, eps_avir_);
-    std::shared_ptr<DLRSolver> solver = DLRSolver::build_solver(options_, H);
+    std::shared_ptr<DLRSolver> solver;
+    if (options_.get_str("SOLVER_TYPE") == "DAVIDSON")
+        solver = DavidsonRSolver::build_solver(options_, H);
+    else
+        solver = DLRSolver::build_solver(options_, H);
 
     // Extra Knobs
     H->set_print(print_);
@@ -1298,6 +1319,9 @@ double RTDA::compute_energy() {
     H->print_header();
     jk_->print_header();
 
+    // Hamiltonian products (JK builds) over the singlet and triplet solves
+    int nproduct = 0;
+
     // Singlets
     if (options_.get_bool("DO_SINGLETS")) {
         H->set_singlet(true);
@@ -1316,6 +1340,7 @@ double RTDA::compute_energy() {
         }
 
         solver->solve();
+        nproduct += solver->nproduct();
 
         // Unpack
         const std::vector<std::shared_ptr<Vector> > singlets = solver->eigenvectors();
@@ -1357,6 +1382,7 @@ double RTDA::compute_energy() {
         }
 
         solver->solve();
+        nproduct += solver->nproduct();
 
         const std::vector<std::shared_ptr<Vector> > triplets = solver->eigenvectors();
         const std::vector<std::vector<double> > E_triplets = solver->eigenvalues();
@@ -1386,6 +1412,8 @@ double RTDA::compute_energy() {
         }
     }
 
+    set_scalar_variable("CIS HAMILTONIAN PRODUCTS", nproduct);
+
     // Finalize solver
     solver->finalize();
 
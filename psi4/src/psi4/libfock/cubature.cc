@@ -2772,14 +2772,18 @@ class NuclearWeightMgr {
     //// These are the member variables
     enum NuclearSchemes scheme_;
     std::shared_ptr<Molecule> molecule_;
+    int natom_;
     double **inv_dist_;
     double **amatrix_;
+    // Atomic coordinates in SoA layout, so the point-to-atom distances vectorize
+    std::vector<double> xa_;
+    std::vector<double> ya_;
+    std::vector<double> za_;
     ////
 
     inline double distToAtom(MassPoint mp, int A) const {
-        return sqrt((mp.x - molecule_->x(A)) * (mp.x - molecule_->x(A)) +
-                    (mp.y - molecule_->y(A)) * (mp.y - molecule_->y(A)) +
-                    (mp.z - molecule_->z(A)) * (mp.z - molecule_->z(A)));
+        return sqrt((mp.x - xa_[A]) * (mp.x - xa_[A]) + (mp.y - ya_[A]) * (mp.y - ya_[A]) +
+                    (mp.z - za_[A]) * (mp.z - za_[A]));
     }
 
     static double BeckeMu(double ri, double rj, double inv_rij);
@@ -2794,14 +2798,24 @@ class NuclearWeightMgr {
         return (a < -0.5) ? -0.5 : (a > 0.5) ? 0.5 : a;
     }
 
+    template <double (*muFunction)(double, double, double), double (*stepFunction)(double)>
+    double cellFunctionRatio(int nactive, const int *order, const double *dist) const;
+
    public:
+    // Per-thread scratch space for computeNuclearWeight, sized once per atomic grid instead of once per point.
+    struct Workspace {
+        std::vector<double> dist;
+        std::vector<int> order;
+    };
+
     static int WhichScheme(const char *schemename);
     static const char *SchemeName(int which) { return nuclearschemenames[which]; }
 
     NuclearWeightMgr(std::shared_ptr<Molecule> mol, int scheme);
     ~NuclearWeightMgr();
     double GetStratmannCutoff(int A) const;
-    double computeNuclearWeight(MassPoint mp, int A, double stratmannCutoff) const;
+    void initWorkspace(Workspace &work) const;
+    double computeNuclearWeight(MassPoint mp, int A, double stratmannCutoff, Workspace &work) const;
 };
 
 const char *NuclearWeightMgr::nuclearschemenames[] = {"NAIVE", "BECKE", "TREUTLER", "STRATMANN",
@@ -2811,9 +2825,19 @@ NuclearWeightMgr::NuclearWeightMgr(std::shared_ptr<Molecule> mol, int scheme) {
     int natom = mol->natom();
     scheme_ = (enum NuclearSchemes)scheme;
     molecule_ = mol;
+    natom_ = natom;
     inv_dist_ = block_matrix(natom, natom);
     amatrix_ = block_matrix(natom, natom);
 
+    xa_.resize(natom);
+    ya_.resize(natom);
+    za_.resize(natom);
+    for (int A = 0; A < natom; A++) {
+        xa_[A] = mol->x(A);
+        ya_[A] = mol->y(A);
+        za_[A] = mol->z(A);
+    }
+
     // inv_dist[A][B] = 1/(distance between atoms A and B)
     for (int A = 0; A < natom; A++) {
         for (int B = 0; B < A; B++) {
@@ -2947,37 +2971,103 @@ double NuclearWeightMgr::GetStratmannCutoff(int A) const {
     return distToNearestAtom * (1 + mucutoff) / 2;
 }
 
-double NuclearWeightMgr::computeNuclearWeight(MassPoint mp, int A, double stratmannCutoff) const {
-    // Stratmann's step function gives us this handy check
-    if (scheme_ == STRATMANN && distToAtom(mp, A) <= stratmannCutoff) return 1;
-
-    int natom = molecule_->natom();
-    // Find the distance from point mp to each atom in the molecule.
-    std::vector<double> dist(natom);
-    for (int l = 0; l < natom; l++) dist[l] = distToAtom(mp, l);
-
-    double (*stepFunction)(double) = (scheme_ == STRATMANN) ? StratmannStepFunction : BeckeStepFunction;
-    double (*muFunction)(double, double, double) = (scheme_ == SBECKE) ? SmoothBeckeMu : BeckeMu;
+void NuclearWeightMgr::initWorkspace(Workspace &work) const {
+    work.dist.resize(natom_);
+    work.order.resize(natom_);
+}
 
+// Computes P_A / sum_i P_i, where P_i = prod_j s(nu_ij) is the cell function of atom i. Only the first `nactive'
+// atoms in `order' can have nonzero cell functions, and order[0] must be the parent atom A.
+template <double (*muFunction)(double, double, double), double (*stepFunction)(double)>
+double NuclearWeightMgr::cellFunctionRatio(int nactive, const int *order, const double *dist) const {
     double numerator = NAN;
     double denominator = 0;
-    for (int i = 0; i < natom; i++) {
+    for (int ii = 0; ii < nactive; ii++) {
+        int i = order[ii];
+        const double *inv_dist_i = inv_dist_[i];
+        const double *amatrix_i = amatrix_[i];
         double prod = 1;
-        for (int j = 0; j < natom; j++) {
+        // Nearby atoms come first in `order', and are the ones most likely to zero out the product.
+        for (int jj = 0; jj < natom_; jj++) {
+            int j = order[jj];
             if (i == j) continue;
-            // if ( dist[j] >= (dist[i]+RCut) ) continue; // sugested cutoff
-            double mu = muFunction(dist[i], dist[j], inv_dist_[i][j]);
-            double nu = mu + amatrix_[i][j] * (1 - mu * mu);  // Adjust for ratios between atomic radii
-            double s = stepFunction(nu);
-            prod *= s;
+            double mu = muFunction(dist[i], dist[j], inv_dist_i[j]);
+            double nu = mu + amatrix_i[j] * (1 - mu * mu);  // Adjust for ratios between atomic radii
+            prod *= stepFunction(nu);
             if (prod == 0) break;  // Under the Stratmann scheme, this should happen often enough to be worth the test.
         }
-        if (i == A) numerator = prod;  // Meow: If we do `i == A' first, then we can check to see if numerator == 0...
+        if (ii == 0) {
+            // The parent atom is done first, so a vanishing weight skips everyone else.
+            if (prod == 0) return 0;
+            numerator = prod;
+        }
         denominator += prod;
     }
     return numerator / denominator;
 }
 
+double NuclearWeightMgr::computeNuclearWeight(MassPoint mp, int A, double stratmannCutoff, Workspace &work) const {
+    // Stratmann's step function gives us this handy check
+    if (scheme_ == STRATMANN && distToAtom(mp, A) <= stratmannCutoff) return 1;
+
+    const int natom = natom_;
+    const double *xa = xa_.data();
+    const double *ya = ya_.data();
+    const double *za = za_.data();
+    double *dist = work.dist.data();
+    int *order = work.order.data();
+
+    // Find the distance from point mp to each atom in the molecule.
+#pragma omp simd
+    for (int l = 0; l < natom; l++) {
+        double dx = mp.x - xa[l];
+        double dy = mp.y - ya[l];
+        double dz = mp.z - za[l];
+        dist[l] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Partition the atoms into those whose cell function may be nonzero at this point (first, with A leading)
+    // and the rest. Every atom still enters the products below; only the outer sum is restricted.
+    int nactive = natom;
+    if (scheme_ == STRATMANN) {
+        // The Stratmann step function vanishes for mu > 0.64, and mu(i,N) >= (r_i - r_N) / (r_i + r_N) by the
+        // triangle inequality. With N the atom nearest to the point, P_i is therefore exactly zero whenever
+        // r_i > r_N * (1 + 0.64) / (1 - 0.64). The amatrix is zero in this scheme, so nu == mu.
+        const double ratio = (1.0 + 0.64) / (1.0 - 0.64) * (1.0 + 1.0E-12);
+        double rmin = dist[A];
+        for (int l = 0; l < natom; l++) rmin = std::min(rmin, dist[l]);
+        double rcut = ratio * rmin;
+        if (dist[A] > rcut) return 0;
+
+        int front = 0;
+        int back = natom;
+        order[front++] = A;
+        for (int l = 0; l < natom; l++) {
+            if (l == A) continue;
+            if (dist[l] <= rcut) {
+                order[front++] = l;
+            } else {
+                order[--back] = l;
+            }
+        }
+        nactive = front;
+    } else {
+        int n = 0;
+        order[n++] = A;
+        for (int l = 0; l < natom; l++) {
+            if (l != A) order[n++] = l;
+        }
+    }
+
+    if (scheme_ == STRATMANN) {
+        return cellFunctionRatio<BeckeMu, StratmannStepFunction>(nactive, order, dist);
+    } else if (scheme_ == SBECKE) {
+        return cellFunctionRatio<SmoothBeckeMu, BeckeStepFunction>(nactive, order, dist);
+    } else {
+        return cellFunctionRatio<BeckeMu, BeckeStepFunction>(nactive, order, dist);
+    }
+}
+
 class OrientationMgr {
     // "Local" vector, matrix, atom, and molecule definitions.
     // It makes some of the code easier to read.
@@ -3743,11 +3833,13 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
     std::vector<std::vector<BrianBlock>> atomBlocks(molecule_->natom());
 #endif
 
-// Iterate over atoms
-#pragma omp parallel for schedule(static)
+// Iterate over atoms; heavy and light atoms carry very different numbers of points, so balance dynamically
+#pragma omp parallel for schedule(dynamic)
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
         double stratmannCutoff = nuc.GetStratmannCutoff(A);
+        NuclearWeightMgr::Workspace nucwork;
+        nuc.initWorkspace(nucwork);
         
 #ifdef USING_BrianQC
         if (brianEnable and brianEnableDFT) {
@@ -3804,8 +3896,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
                     MassPoint mp = {r[i] * anggrid[j].x, r[i] * anggrid[j].y, r[i] * anggrid[j].z,
                                     wr[i] * anggrid[j].w};
                     mp = std_orientation.MoveIntoPosition(mp, A);
-                    mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff);  // This ain't gonna fly. Must abate this
-                                                                               // mickey mouse a most rikky tikki tavi.
+                    mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff, nucwork);
                     if (std::abs(mp.w) > weightcut) {grid[A].push_back(mp);}
                     assert(!std::isnan(mp.w));
                 }
@@ -3823,9 +3914,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
 
             for (int i = 0; i < npts; i++) {
                 MassPoint mp = std_orientation.MoveIntoPosition(sg[i], A);
-                mp.w *= nuc.computeNuclearWeight(
-                    mp, A,
-                    stratmannCutoff);  // This ain't gonna fly. Must abate this mickey mouse a most rikky tikki tavi.
+                mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff, nucwork);
                 if (std::abs(mp.w) > weightcut) {grid[A].push_back(mp);}
                 assert(!std::isnan(mp.w));
             }
@@ -3948,11 +4037,13 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt, const
     radial_grids_.resize(molecule_->natom());
     spherical_grids_.resize(molecule_->natom());
 
-// Iterate over atoms
-#pragma omp parallel for schedule(static)
+// Iterate over atoms; heavy and light atoms carry very different numbers of points, so balance dynamically
+#pragma omp parallel for schedule(dynamic)
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
         double stratmannCutoff = nuc.GetStratmannCutoff(A);
+        NuclearWeightMgr::Workspace nucwork;
+        nuc.initWorkspace(nucwork);
 
         std::vector<double> r(rs[A].size()), wr(rs[A].size());
         double alpha = GetBSRadius(Z) * opt.bs_radius_alpha;
@@ -3978,9 +4069,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt, const
             for (int j = 0; j < numAngPts; j++) {
                 MassPoint mp = {r[i] * anggrid[j].x, r[i] * anggrid[j].y, r[i] * anggrid[j].z, wr[i] * anggrid[j].w};
                 mp = std_orientation.MoveIntoPosition(mp, A);
-                mp.w *= nuc.computeNuclearWeight(
-                    mp, A,
-                    stratmannCutoff);  // This ain't gonna fly. Must abate this mickey mouse a most rikky tikki tavi.
+                mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff, nucwork);
                 if (std::abs(mp.w) > weightcut) {grid[A].push_back(mp);}
                 assert(!std::isnan(mp.w));
             }
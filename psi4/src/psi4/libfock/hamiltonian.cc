@@ -37,7 +37,10 @@
 #include "psi4/libmints/matrix.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
+#include <cmath>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -53,6 +56,15 @@ void Hamiltonian::common_init() {
     debug_ = 0;
     bench_ = 0;
     exact_diagonal_ = false;
+    product_cutoff_ = 0.0;
+}
+bool Hamiltonian::significant(const std::shared_ptr<Vector>& x, int h) const {
+    int n = x->dimpi()[h];
+    double* xp = x->pointer(h);
+    for (int i = 0; i < n; ++i) {
+        if (std::fabs(xp[i]) > product_cutoff_) return true;
+    }
+    return false;
 }
 
 RHamiltonian::RHamiltonian(std::shared_ptr<JK> jk) : Hamiltonian(jk) {}
@@ -456,8 +468,14 @@ void TDHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
 
     int nirrep = (x.size() ? x[0]->nirrep() : 0);
 
+    // Position of the X part of each (symm, N) block in the JK batch, Y follows; -1 if screened out
+    std::vector<int> jk_index(nirrep * x.size(), -1);
+
     for (int symm = 0; symm < nirrep; ++symm) {
         for (size_t N = 0; N < x.size(); ++N) {
+            if (!significant(x[N], symm)) continue;
+            jk_index[symm * x.size() + N] = C_left.size();
+
             C_left.push_back(Caocc_);
             C_left.push_back(Caocc_);
 
@@ -511,7 +529,7 @@ void TDHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
         }
     }
 
-    jk_->compute();
+    if (!C_left.empty()) jk_->compute();
 
     const std::vector<SharedMatrix>& J = jk_->J();
     const std::vector<SharedMatrix>& K = jk_->K();
@@ -524,6 +542,7 @@ void TDHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
 
             double* bp = b[N]->pointer(symm);
             double* xp = x[N]->pointer(symm);
+            int index = jk_index[symm * x.size() + N];
             long int offset = 0L;
 
             for (int h = 0; h < Caocc_->nirrep(); ++h) {
@@ -539,51 +558,58 @@ void TDHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
                 double* eop = eps_aocc_->pointer(h);
                 double* evp = eps_avir_->pointer(h ^ symm);
 
-                double** JXp = J[2 * symm * x.size() + 2 * N]->pointer(h);
-                double** KXp = K[2 * symm * x.size() + 2 * N]->pointer(h);
-                double** KX2p = K[2 * symm * x.size() + 2 * N]->pointer(h ^ symm);
-                double** JYp = J[2 * symm * x.size() + 2 * N + 1]->pointer(h);
-                double** KYp = K[2 * symm * x.size() + 2 * N + 1]->pointer(h);
-                double** KY2p = K[2 * symm * x.size() + 2 * N + 1]->pointer(h ^ symm);
+                if (index < 0) {
+                    ::memset((void*)&bp[offset], '\0', sizeof(double) * nocc * nvir);
+                    ::memset((void*)&bp[offset + nov], '\0', sizeof(double) * nocc * nvir);
+                } else {
+                    double** JXp = J[index]->pointer(h);
+                    double** KXp = K[index]->pointer(h);
+                    double** KX2p = K[index]->pointer(h ^ symm);
+                    double** JYp = J[index + 1]->pointer(h);
+                    double** KYp = K[index + 1]->pointer(h);
+                    double** KY2p = K[index + 1]->pointer(h ^ symm);
 
-                // A terms
+                    // A terms
 
-                // -(ij|ab)P_jb = C_im K_mn C_na
-                // AX -> SX
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KXp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
-                // -AY -> SY
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KYp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset + nov], nvir);
-
-                if (singlet_) {
-                    // 2(ia|jb)P_jb = C_im J_mn C_na
+                    // -(ij|ab)P_jb = C_im K_mn C_na
                     // AX -> SX
-                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JXp[0], nsovir, 0.0, Tp, nsovir);
-                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KXp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
                     // -AY -> SY
-                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JYp[0], nsovir, 0.0, Tp, nsovir);
-                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov], nvir);
-                }
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KYp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset + nov], nvir);
+
+                    if (singlet_) {
+                        // 2(ia|jb)P_jb = C_im J_mn C_na
+                        // AX -> SX
+                        C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JXp[0], nsovir, 0.0, Tp, nsovir);
+                        C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                        // -AY -> SY
+                        C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JYp[0], nsovir, 0.0, Tp, nsovir);
+                        C_DGEMM('N', 'N', nocc, nvir, nsovir, -2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov],
+                                nvir);
+                    }
 
-                // B terms
+                    // B terms
 
-                // -(ib|ja)P_jb = C_in K_nm C_ma
-                // BY -> SX
-                C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KY2p[0], nsoocc, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
-                // -BX -> SY
-                C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KX2p[0], nsoocc, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov], nvir);
-
-                if (singlet_) {
-                    // 2(ia|jb)P_jb = C_im J_mn C_na
+                    // -(ib|ja)P_jb = C_in K_nm C_ma
                     // BY -> SX
-                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JYp[0], nsovir, 0.0, Tp, nsovir);
-                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KY2p[0], nsoocc, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
                     // -BX -> SY
-                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JXp[0], nsovir, 0.0, Tp, nsovir);
-                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov], nvir);
+                    C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KX2p[0], nsoocc, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov], nvir);
+
+                    if (singlet_) {
+                        // 2(ia|jb)P_jb = C_im J_mn C_na
+                        // BY -> SX
+                        C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JYp[0], nsovir, 0.0, Tp, nsovir);
+                        C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                        // -BX -> SY
+                        C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, JXp[0], nsovir, 0.0, Tp, nsovir);
+                        C_DGEMM('N', 'N', nocc, nvir, nsovir, -2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset + nov],
+                                nvir);
+                    }
                 }
 
                 // Diagonal terms
@@ -692,8 +718,14 @@ void CPHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
 
     int nirrep = (x.size() ? x[0]->nirrep() : 0);
 
+    // Position of each (symm, N) block in the JK batch, -1 if screened out
+    std::vector<int> jk_index(nirrep * x.size(), -1);
+
     for (int symm = 0; symm < nirrep; ++symm) {
         for (size_t N = 0; N < x.size(); ++N) {
+            if (!significant(x[N], symm)) continue;
+            jk_index[symm * x.size() + N] = C_left.size();
+
             C_left.push_back(Caocc_);
             double* xp = x[N]->pointer(symm);
 
@@ -721,7 +753,7 @@ void CPHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
         }
     }
 
-    jk_->compute();
+    if (!C_left.empty()) jk_->compute();
 
     const std::vector<SharedMatrix>& J = jk_->J();
     const std::vector<SharedMatrix>& K = jk_->K();
@@ -732,6 +764,7 @@ void CPHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
         for (size_t N = 0; N < x.size(); ++N) {
             double* bp = b[N]->pointer(symm);
             double* xp = x[N]->pointer(symm);
+            int index = jk_index[symm * x.size() + N];
             long int offset = 0L;
 
             for (int h = 0; h < Caocc_->nirrep(); ++h) {
@@ -746,21 +779,26 @@ void CPHFRHamiltonian::product(const std::vector<std::shared_ptr<Vector> >& x,
                 double** Cvp = Cavir_->pointer(h ^ symm);
                 double* eop = eps_aocc_->pointer(h);
                 double* evp = eps_avir_->pointer(h ^ symm);
-                double** Jp = J[N]->pointer(h);
-                double** Kp = K[N]->pointer(h);
-                double** K2p = K[N]->pointer(h ^ symm);
 
-                // 4(ia|jb)P_jb = C_im J_mn C_na
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 4.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
+                if (index < 0) {
+                    ::memset((void*)&bp[offset], '\0', sizeof(double) * nocc * nvir);
+                } else {
+                    double** Jp = J[index]->pointer(h);
+                    double** Kp = K[index]->pointer(h);
+                    double** K2p = K[index]->pointer(h ^ symm);
 
-                // -(ib|ja)P_jb = C_in K_nm C_ma
-                C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, K2p[0], nsoocc, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // 4(ia|jb)P_jb = C_im J_mn C_na
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 4.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
 
-                // -(ij|ab)P_jb = C_im K_mn C_ra
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // -(ib|ja)P_jb = C_in K_nm C_ma
+                    C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, K2p[0], nsoocc, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+
+                    // -(ij|ab)P_jb = C_im K_mn C_ra
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
 
                 for (int i = 0; i < nocc; ++i) {
                     for (int a = 0; a < nvir; ++a) {
@@ -1369,10 +1407,16 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
     int nirrepa = (x.size() ? x[0].first->nirrep() : 0);
     int nirrepb = (x.size() ? x[0].second->nirrep() : 0);
 
+    // Position of each alpha, then beta, (symm, N) block in the JK batch, -1 if screened out
+    std::vector<int> jk_index((nirrepa + nirrepb) * x.size(), -1);
+
     //    Alpha orbitals are handled first
 
     for (int symm = 0; symm < nirrepa; ++symm) {
         for (size_t N = 0; N < x.size(); ++N) {
+            if (!significant(x[N].first, symm)) continue;
+            jk_index[symm * x.size() + N] = C_left.size();
+
             double* xp = x[N].first->pointer(symm);
             long int offset = 0L;
 
@@ -1462,6 +1506,9 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
 
     for (int symm = 0; symm < nirrepb; ++symm) {
         for (size_t N = 0; N < x.size(); ++N) {
+            if (!significant(x[N].second, symm)) continue;
+            jk_index[(nirrepa + symm) * x.size() + N] = C_left.size();
+
             double* xp = x[N].second->pointer(symm);
             long int offset = 0L;
 
@@ -1547,7 +1594,7 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
         }
     }
 
-    jk_->compute();
+    if (!C_left.empty()) jk_->compute();
 
     const std::vector<SharedMatrix>& J = jk_->J();
     const std::vector<SharedMatrix>& K = jk_->K();
@@ -1560,6 +1607,9 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
         for (size_t N = 0; N < x.size(); ++N) {
             double* bp = b[N].first->pointer(symm);
             double* xp = x[N].first->pointer(symm);
+            int index_a = jk_index[symm * x.size() + N];
+            int index_b = jk_index[(nirrepa + symm) * x.size() + N];
+            int index = index_a;
             long int offset = 0L;
 
             for (int h = 0; h < Cocca_->nirrep(); ++h) {
@@ -1575,28 +1625,38 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
                 double* eop = eps_occa_->pointer(h);
                 double* evp = eps_vira_->pointer(h ^ symm);
 
-                double** Jap = J[symm * x.size() + N]->pointer(h);
-                double** Jbp = J[(nirrepa + symm) * x.size() + N]->pointer(h);
-                double** Kp = K[symm * x.size() + N]->pointer(h);
-                double** KTp = K[symm * x.size() + N]->pointer(h ^ symm);
-                // We need to use h^symm representation of h because we want the
-                // columns to be in h^symm so that the transpose has lines in h^symm
+                ::memset((void*)&bp[offset], '\0', sizeof(double) * nocc * nvir);
 
-                // -(ij|ab)P_jb = C_im K_mn C_na
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
+                if (index >= 0) {
+                    double** Kp = K[index]->pointer(h);
+                    double** KTp = K[index]->pointer(h ^ symm);
+                    // We need to use h^symm representation of h because we want the
+                    // columns to be in h^symm so that the transpose has lines in h^symm
 
-                // -(ib|ja) P_jb = C_im (K^{T})_mn C_na
-                C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KTp[0], nsoocc, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // -(ij|ab)P_jb = C_im K_mn C_na
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+
+                    // -(ib|ja) P_jb = C_im (K^{T})_mn C_na
+                    C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KTp[0], nsoocc, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
 
-                // 2(ia|jb)P_jb = C_im J_mn C_na for J alpha
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jap[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                if (index_a >= 0) {
+                    double** Jap = J[index_a]->pointer(h);
 
-                // 2(ia|jb)P_jb = C_im J_mn C_na for J beta
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jbp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // 2(ia|jb)P_jb = C_im J_mn C_na for J alpha
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jap[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
+
+                if (index_b >= 0) {
+                    double** Jbp = J[index_b]->pointer(h);
+
+                    // 2(ia|jb)P_jb = C_im J_mn C_na for J beta
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jbp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
 
                 for (int i = 0; i < nocc; ++i) {
                     for (int a = 0; a < nvir; ++a) {
@@ -1619,6 +1679,9 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
         for (size_t N = 0; N < x.size(); ++N) {
             double* bp = b[N].second->pointer(symm);
             double* xp = x[N].second->pointer(symm);
+            int index_a = jk_index[symm * x.size() + N];
+            int index_b = jk_index[(nirrepa + symm) * x.size() + N];
+            int index = index_b;
             long int offset = 0L;
 
             for (int h = 0; h < Coccb_->nirrep(); ++h) {
@@ -1634,26 +1697,36 @@ void USTABHamiltonian::product(const std::vector<std::pair<std::shared_ptr<Vecto
                 double* eop = eps_occb_->pointer(h);
                 double* evp = eps_virb_->pointer(h ^ symm);
 
-                double** Jap = J[symm * x.size() + N]->pointer(h);
-                double** Jbp = J[(nirrepa + symm) * x.size() + N]->pointer(h);
-                double** Kp = K[(nirrepa + symm) * x.size() + N]->pointer(h);
-                double** KTp = K[(nirrepa + symm) * x.size() + N]->pointer(h ^ symm);
+                ::memset((void*)&bp[offset], '\0', sizeof(double) * nocc * nvir);
 
-                // -(ij|ab)P_jb = C_im K_mn C_na
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 0.0, &bp[offset], nvir);
+                if (index >= 0) {
+                    double** Kp = K[index]->pointer(h);
+                    double** KTp = K[index]->pointer(h ^ symm);
 
-                // -(ib|ja) P_jb = C_im (K^{T})_mn C_na
-                C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KTp[0], nsoocc, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // -(ij|ab)P_jb = C_im K_mn C_na
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Kp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
 
-                // 2(ia|jb)P_jb = C_im J_mn C_na for J alpha
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jap[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // -(ib|ja) P_jb = C_im (K^{T})_mn C_na
+                    C_DGEMM('T', 'T', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, KTp[0], nsoocc, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, -1.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
+
+                if (index_a >= 0) {
+                    double** Jap = J[index_a]->pointer(h);
 
-                // 2(ia|jb)P_jb = C_im J_mn C_na for J beta
-                C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jbp[0], nsovir, 0.0, Tp, nsovir);
-                C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                    // 2(ia|jb)P_jb = C_im J_mn C_na for J alpha
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jap[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
+
+                if (index_b >= 0) {
+                    double** Jbp = J[index_b]->pointer(h);
+
+                    // 2(ia|jb)P_jb = C_im J_mn C_na for J beta
+                    C_DGEMM('T', 'N', nocc, nsovir, nsoocc, 1.0, Cop[0], nocc, Jbp[0], nsovir, 0.0, Tp, nsovir);
+                    C_DGEMM('N', 'N', nocc, nvir, nsovir, 2.0, Tp, nsovir, Cvp[0], nvir, 1.0, &bp[offset], nvir);
+                }
 
                 for (int i = 0; i < nocc; ++i) {
                     for (int a = 0; a < nvir; ++a) {
@@ -50,6 +50,8 @@ class Hamiltonian {
     int bench_;
     /// Use exact diagonal, if available?
     bool exact_diagonal_;
+    /// Trial vector blocks with no element above this are left out of the JK build, defaults to 0.0
+    double product_cutoff_;
     /// jk object
     std::shared_ptr<JK> jk_;
     /// v object
@@ -57,6 +59,13 @@ class Hamiltonian {
 
     void common_init();
 
+    /**
+    * Does block h of x have an element above product_cutoff_?
+    * Blocks that do not contribute nothing to J and K and are screened out
+    * of the JK build; their product is the orbital energy difference term alone.
+    */
+    bool significant(const std::shared_ptr<Vector>& x, int h) const;
+
    public:
     // => Constructors < = //
 
@@ -104,6 +113,8 @@ class Hamiltonian {
     void set_bench(int bench) { bench_ = bench; }
     /// User the exact diagonal, if available? (defaults to false)
     void set_exact_diagonal(bool diag) { exact_diagonal_ = diag; }
+    /// Screening cutoff on the trial vector elements for the JK build (defaults to 0.0, exact)
+    void set_product_cutoff(double cutoff) { product_cutoff_ = cutoff; }
 };
 
 class RHamiltonian : public Hamiltonian {
@@ -48,5 +48,7 @@
   calculations. I. Atoms", Int J Quantum Chem. e25945 (2019).
   DOI: 10.1002/qua.25945
 */
+/* Radius in bohr beyond which the effective charge vanishes */
+double sap_cutoff_radius();
 double sap_effective_charge(int Z, double r);
 #endif
@@ -29,6 +29,7 @@
 #include "solver.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <sstream>
 
@@ -40,6 +41,7 @@
 #include "psi4/psi4-dec.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libmints/matrix.h"
+#include "psi4/libmints/basisset.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
@@ -285,25 +287,39 @@ void CGRSolver::products_x() {
     }
 }
 void CGRSolver::products_p() {
+    // p = z + beta p_old, so after the first iteration only H z is needed: A p = A z + beta A p_old.
+    // z shrinks with the residual, and the Hamiltonian screens its small blocks out of the JK build.
+    bool incremental = (iteration_ > 1);
+
     std::vector<std::shared_ptr<Vector>> p;
     std::vector<std::shared_ptr<Vector>> Ap;
 
     for (size_t N = 0; N < b_.size(); ++N) {
         if (r_converged_[N]) continue;
-        p.push_back(p_[N]);
-        Ap.push_back(Ap_[N]);
+        if (incremental) {
+            p.push_back(z_[N]);
+            Ap.push_back(std::make_shared<Vector>("Az", b_[N]->dimpi()));
+        } else {
+            p.push_back(p_[N]);
+            Ap.push_back(Ap_[N]);
+        }
     }
 
     H_->product(p, Ap);
 
-    for (size_t N = 0; N < b_.size(); ++N) {
+    for (size_t N = 0, M = 0; N < b_.size(); ++N) {
         if (r_converged_[N]) continue;
+        if (incremental) {
+            Ap_[N]->scale(beta_[N]);
+            Ap_[N]->add(Ap[M]);
+        }
         for (int h = 0; h < diag_->nirrep(); h++) {
             if (shifts_[h][N] != 0.0) {
                 double lambda = shifts_[h][N];
-                C_DAXPY(diag_->dimpi()[h], -lambda, p_[N]->pointer(h), 1, Ap_[N]->pointer(h), 1);
+                C_DAXPY(diag_->dimpi()[h], -lambda, p[M]->pointer(h), 1, Ap_[N]->pointer(h), 1);
             }
         }
+        M++;
     }
 
     if (debug_) {
@@ -476,7 +492,8 @@ DLRSolver::DLRSolver(std::shared_ptr<RHamiltonian> H)
       min_subspace_(2),
       nguess_(1),
       nsubspace_(0),
-      nconverged_(0) {
+      nconverged_(0),
+      nproduct_(0) {
     name_ = "DLR";
 }
 DLRSolver::~DLRSolver() {}
@@ -552,6 +569,7 @@ void DLRSolver::solve() {
     iteration_ = 0;
     converged_ = false;
     nconverged_ = 0;
+    nproduct_ = 0;
     convergence_ = 0.0;
 
     if (print_ > 1) {
@@ -603,6 +621,7 @@ void DLRSolver::solve() {
         } else if (print_ > 1) {
             outfile->Printf("    %sSolver converged.\n\n", name_.c_str());
         }
+        outfile->Printf("    %s: %d Hamiltonian products (JK builds).\n\n", name_.c_str(), nproduct_);
     }
 }
 void DLRSolver::finalize() {
@@ -721,6 +740,7 @@ void DLRSolver::sigma() {
     }
 
     H_->product(x, b);
+    nproduct_++;
 
     if (debug_) {
         outfile->Printf("   > Sigma <\n\n");
@@ -766,31 +786,46 @@ void DLRSolver::subspaceDiagonalization() {
         npi[h] = n;
     }
 
-    SharedMatrix G2(G_->clone());
     a_ = std::make_shared<Matrix>("Subspace Eigenvectors", npi, npi);
     l_ = std::make_shared<Vector>("Subspace Eigenvalues", npi);
 
-    G2->diagonalize(a_, l_);
-
-    // Resort to remove false zeros for cases with too small of irreps
     for (int h = 0; h < nirrep; h++) {
         int dim = diag_->dimpi()[h];
+        if (!dim) continue;
 
-        int nfalse = n - dim;
+        // Subspace vectors with no component in this irrep (more vectors than the irrep has functions,
+        // or roots converged in it) would give false zeros, so only the others are diagonalized.
+        // The false zeros are left at the end as zero eigenpairs.
+        std::vector<int> live;
+        for (int i = 0; i < n; i++) {
+            double* bp = b_[i]->pointer(h);
+            if (C_DDOT(dim, bp, 1, bp, 1) > 0.0) live.push_back(i);
+        }
+        int nlive = live.size();
+        if (!nlive) continue;
 
-        if (nfalse <= 0) continue;
+        auto G2 = std::make_shared<Matrix>("G2", nlive, nlive);
+        auto U = std::make_shared<Matrix>("U", nlive, nlive);
+        auto L = std::make_shared<Vector>("L", nlive);
+        double** Gp = G_->pointer(h);
+        double** G2p = G2->pointer();
+        for (int i = 0; i < nlive; i++) {
+            for (int j = 0; j < nlive; j++) {
+                G2p[i][j] = Gp[live[i]][live[j]];
+            }
+        }
+
+        G2->diagonalize(U, L);
 
         double** ap = a_->pointer(h);
         double* lp = l_->pointer(h);
-
-        for (int m = 0; m < n - nfalse; m++) {
-            lp[m] = lp[m + nfalse];
-            C_DCOPY(n, &ap[0][m + nfalse], n, &ap[0][m], n);
-        }
-
-        for (int m = 0; m < nfalse; m++) {
-            lp[n - m - 1] = 0;
-            C_DSCAL(n, 0.0, &ap[0][n - m - 1], n);
+        double** Up = U->pointer();
+        double* Lp = L->pointer();
+        for (int m = 0; m < nlive; m++) {
+            lp[m] = Lp[m];
+            for (int i = 0; i < nlive; i++) {
+                ap[live[i]][m] = Up[i][m];
+            }
         }
     }
 
@@ -856,6 +891,7 @@ void DLRSolver::eigenvals() {
 }
 void DLRSolver::residuals() {
     n_.resize(nroot_);
+    nh_.assign(nroot_, std::vector<double>(diag_->nirrep(), 0.0));
     nconverged_ = 0;
 
     if (r_.size() != (size_t)nroot_) {
@@ -887,11 +923,14 @@ void DLRSolver::residuals() {
                 double* sp = s_[i]->pointer(h);
                 C_DAXPY(dimension, ap[i][k], sp, 1, rp, 1);
             }
-            S2 += C_DDOT(dimension, rp, 1, rp, 1);
+            double S2h = C_DDOT(dimension, rp, 1, rp, 1);
+            S2 += S2h;
 
             C_DAXPY(dimension, -lp[k], cp, 1, rp, 1);
 
-            R2 += C_DDOT(dimension, rp, 1, rp, 1);
+            double R2h = C_DDOT(dimension, rp, 1, rp, 1);
+            R2 += R2h;
+            nh_[k][h] = (S2h > 0.0 ? sqrt(R2h / S2h) : 0.0);
         }
 
         // Residual norm k
@@ -943,6 +982,13 @@ void DLRSolver::correctors() {
             double* dp = d->pointer(h);
             double* rp = r_[k]->pointer(h);
 
+            // The irreps this root has converged in get no new direction, which keeps
+            // them out of the JK build of the next sigma vectors
+            if (nh_[k][h] < criteria_) {
+                ::memset((void*)dp, '\0', dimension * sizeof(double));
+                continue;
+            }
+
             if (precondition_ == "SUBSPACE") {
                 for (int m = 0; m < dimension; m++) {
                     dp[m] = rp[m] / (hp[m] - lambda);
@@ -1070,11 +1116,13 @@ void DLRSolver::subspaceExpansion() {
 }
 void DLRSolver::subspaceCollapse() {
     if (nsubspace_ <= max_subspace_) return;
-
+    collapse(min_subspace_);
+}
+void DLRSolver::collapse(int nkeep) {
     std::vector<std::shared_ptr<Vector>> s2;
     std::vector<std::shared_ptr<Vector>> b2;
 
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < nkeep; ++k) {
         std::stringstream bs;
         bs << "Subspace Vector " << k;
         b2.push_back(std::make_shared<Vector>(bs.str(), diag_->dimpi()));
@@ -1084,7 +1132,7 @@ void DLRSolver::subspaceCollapse() {
     }
 
     int n = a_->rowspi()[0];
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < nkeep; ++k) {
         for (int h = 0; h < diag_->nirrep(); ++h) {
             int dimension = diag_->dimpi()[h];
             if (!dimension) continue;
@@ -1117,6 +1165,136 @@ void DLRSolver::subspaceCollapse() {
     }
 }
 
+DavidsonRSolver::DavidsonRSolver(std::shared_ptr<RHamiltonian> H) : DLRSolver(H) {
+    name_ = "DavidsonR";
+}
+DavidsonRSolver::~DavidsonRSolver() {}
+std::shared_ptr<DavidsonRSolver> DavidsonRSolver::build_solver(Options& options, std::shared_ptr<RHamiltonian> H) {
+    auto solver = std::make_shared<DavidsonRSolver>(H);
+
+    if (options["PRINT"].has_changed()) {
+        solver->set_print(options.get_int("PRINT") + 1);
+    }
+    if (options["DEBUG"].has_changed()) {
+        solver->set_debug(options.get_int("DEBUG"));
+    }
+    if (options["BENCH"].has_changed()) {
+        solver->set_bench(options.get_int("BENCH"));
+    }
+    if (options["SOLVER_MAXITER"].has_changed()) {
+        solver->set_maxiter(options.get_int("SOLVER_MAXITER"));
+    }
+    if (options["SOLVER_CONVERGENCE"].has_changed()) {
+        solver->set_convergence(options.get_double("SOLVER_CONVERGENCE"));
+    }
+    if (options["SOLVER_N_ROOT"].has_changed()) {
+        solver->set_nroot(options.get_int("SOLVER_N_ROOT"));
+    }
+    if (options["SOLVER_N_GUESS"].has_changed()) {
+        solver->set_nguess(options.get_int("SOLVER_N_GUESS"));
+    }
+    if (options["SOLVER_MIN_SUBSPACE"].has_changed()) {
+        solver->set_min_subspace(options.get_int("SOLVER_MIN_SUBSPACE"));
+    }
+    if (options["SOLVER_MAX_SUBSPACE"].has_changed()) {
+        solver->set_max_subspace(options.get_int("SOLVER_MAX_SUBSPACE"));
+    }
+    if (options["SOLVER_NORM"].has_changed()) {
+        solver->set_norm(options.get_double("SOLVER_NORM"));
+    }
+    if (options["SOLVER_PRECONDITION"].has_changed()) {
+        solver->set_precondition(options.get_str("SOLVER_PRECONDITION"));
+    }
+
+    return solver;
+}
+void DavidsonRSolver::print_header() const {
+    if (print_) {
+        outfile->Printf("  ==> DavidsonRSolver <== \n\n");
+        outfile->Printf("   Number of roots         = %11d\n", nroot_);
+        outfile->Printf("   Number of guess vectors = %11d\n", nguess_);
+        outfile->Printf("   Maximum subspace size   = %11d\n", max_size());
+        outfile->Printf("   Collapsed subspace size = %11d\n", collapse_size());
+        outfile->Printf("   Subspace expansion norm = %11.0E\n", norm_);
+        outfile->Printf("   Convergence cutoff      = %11.0E\n", criteria_);
+        outfile->Printf("   Maximum iterations      = %11d\n", maxiter_);
+        outfile->Printf("   Preconditioning         = %11s\n\n", precondition_.c_str());
+    }
+}
+int DavidsonRSolver::collapse_size() const { return std::max(min_subspace_, 2 * nroot_); }
+int DavidsonRSolver::max_size() const {
+    // Room for at least one full set of correctors on top of the collapsed subspace
+    return std::max(max_subspace_, collapse_size() + nroot_);
+}
+size_t DavidsonRSolver::memory_estimate() {
+    size_t dimension = 0L;
+    if (!diag_) diag_ = H_->diagonal();
+    for (int h = 0; h < diag_->nirrep(); h++) {
+        dimension += diag_->dimpi()[h];
+    }
+    return (2L * (max_size() + nroot_) + 3L * nroot_ + 1L) * dimension;
+}
+size_t DavidsonRSolver::batch_size() {
+    std::shared_ptr<JK> jk = H_->jk();
+    if (!jk) return b_.size();
+
+    // D, J and K of every irrep of a trial vector, and their AO copies
+    size_t nbf = jk->basisset()->nbf();
+    size_t per_vector = 6L * diag_->nirrep() * nbf * nbf;
+
+    size_t doubles = Process::environment.get_memory() / sizeof(double);
+    size_t used = jk->memory_estimate() + memory_estimate();
+    if (doubles <= used + per_vector) return 1;
+    return (doubles - used) / per_vector;
+}
+void DavidsonRSolver::sigma() {
+    int n = b_.size() - s_.size();
+    int offset = s_.size();
+    for (int i = 0; i < n; i++) {
+        std::stringstream s;
+        s << "Sigma Vector " << (i + offset);
+        s_.push_back(std::make_shared<Vector>(s.str(), diag_->dimpi()));
+    }
+
+    // All new vectors go in one product, unless their JK densities do not fit in memory together
+    int nbatch = std::max<size_t>(1L, std::min<size_t>(n, batch_size()));
+    for (int start = 0; start < n; start += nbatch) {
+        int stop = std::min(n, start + nbatch);
+
+        std::vector<std::shared_ptr<Vector>> x;
+        std::vector<std::shared_ptr<Vector>> b;
+        for (int i = offset + start; i < offset + stop; i++) {
+            x.push_back(b_[i]);
+            b.push_back(s_[i]);
+        }
+
+        H_->product(x, b);
+        nproduct_++;
+    }
+
+    if (debug_) {
+        outfile->Printf("   > Sigma <\n\n");
+        for (size_t i = 0; i < s_.size(); i++) {
+            s_[i]->print();
+        }
+    }
+}
+void DavidsonRSolver::subspaceCollapse() {
+    // Thick restart: the Ritz vectors of the roots and as many above them are kept. Their sigma
+    // vectors are combinations of the current ones, so the collapse costs no products.
+    if (nsubspace_ <= max_size()) return;
+    collapse(collapse_size());
+}
+void DavidsonRSolver::solve() {
+    auto start = std::chrono::steady_clock::now();
+
+    DLRSolver::solve();
+
+    if (print_ > 1) {
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        outfile->Printf("    %s: solved in %.2f s.\n\n", name_.c_str(), wall.count());
+    }
+}
 RayleighRSolver::RayleighRSolver(std::shared_ptr<RHamiltonian> H) : DLRSolver(H) {
     name_ = "RayleighR";
     precondition_maxiter_ = 1;
@@ -233,6 +233,7 @@ class CGRSolver : public RSolver {
     void residual();
     /// Write (H_-shifts_)*x_ to Ap_
     void products_x();
+    /// Write (H_-shifts_)*p_ to Ap_, from H_*z_ and the previous products after the first iteration
     void products_p();
     void alpha();
     void update_x();
@@ -287,6 +288,8 @@ class DLRSolver : public RSolver {
     int nsubspace_;
     /// The number of converged roots
     int nconverged_;
+    /// Number of Hamiltonian products (JK builds) in the last solve
+    int nproduct_;
 
     // => State values <= //
 
@@ -312,6 +315,8 @@ class DLRSolver : public RSolver {
     std::vector<std::shared_ptr<Vector> > r_;
     /// Residual vector 2-norms (nroots)
     std::vector<double> n_;
+    /// Residual vector 2-norms by irrep (nroots x nirrep)
+    std::vector<std::vector<double> > nh_;
     /// Correction vectors (nroots)
     std::vector<std::shared_ptr<Vector> > d_;
     /// Diagonal of Hamiltonian
@@ -322,7 +327,7 @@ class DLRSolver : public RSolver {
     // Guess, based on diagonal
     void guess();
     // Compute sigma vectors for the given set of b
-    void sigma();
+    virtual void sigma();
     // Compute subspace Hamiltonian
     void subspaceHamiltonian();
     // Diagonalize subspace Hamiltonian
@@ -338,7 +343,9 @@ class DLRSolver : public RSolver {
     // Orthogonalize/add significant correctors
     void subspaceExpansion();
     // Collapse subspace if needed
-    void subspaceCollapse();
+    virtual void subspaceCollapse();
+    // Collapse the subspace onto its nkeep lowest Ritz vectors
+    void collapse(int nkeep);
 
    public:
     // => Constructors <= //
@@ -365,6 +372,8 @@ class DLRSolver : public RSolver {
     const std::vector<std::shared_ptr<Vector> >& eigenvectors() const { return c_; }
     /// Eigenvalues, by state/irrep
     const std::vector<std::vector<double> >& eigenvalues() const { return E_; }
+    /// Number of Hamiltonian products (JK builds) in the last solve
+    int nproduct() const { return nproduct_; }
 
     // => Knobs <= //
 
@@ -414,6 +423,41 @@ class RayleighRSolver : public DLRSolver {
     void set_quantity(const std::string& quantity) { quantity_ = quantity; }
 };
 
+// Block Davidson for many roots (TDA/CIS). The new trial vectors of an iteration go through the
+// Hamiltonian in as few products as the JK memory allows, the subspace is collapsed onto the Ritz
+// vectors of twice the requested roots (thick restart), and converged roots get no new correctors.
+class DavidsonRSolver : public DLRSolver {
+   protected:
+    /// Number of Ritz vectors kept on collapse
+    int collapse_size() const;
+    /// Subspace size that triggers a collapse
+    int max_size() const;
+    /// Number of trial vectors whose JK densities fit in memory at once
+    size_t batch_size();
+
+    // Compute sigma vectors for the new b, in memory-sized batches
+    void sigma() override;
+    // Thick-restart collapse
+    void subspaceCollapse() override;
+
+   public:
+    // => Constructors <= //
+
+    /// Constructor
+    DavidsonRSolver(std::shared_ptr<RHamiltonian> H);
+    /// Destructor
+    ~DavidsonRSolver() override;
+
+    /// Static constructor, uses Options object
+    static std::shared_ptr<DavidsonRSolver> build_solver(Options& options, std::shared_ptr<RHamiltonian> H);
+
+    // => Required Methods <= //
+
+    void print_header() const override;
+    size_t memory_estimate() override;
+    void solve() override;
+};
+
 class DLRXSolver : public RSolver {
    protected:
     // => Control parameters <= //
@@ -78,7 +78,7 @@ SharedWavefunction libfock(SharedWavefunction ref_wfn, Options& options) {
         throw PSIEXCEPTION("Libfock: Applications module not recognized");
     }
 
-    //    wfn->compute_energy();
+    wfn->compute_energy();
 
     tstop();
 
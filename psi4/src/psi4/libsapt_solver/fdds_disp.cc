@@ -40,6 +40,8 @@
 #include "psi4/libpsi4util/process.h"
 #include "psi4/lib3index/dfhelper.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 // OMP
@@ -377,6 +379,27 @@ std::vector<SharedMatrix> FDDS_Dispersion::project_densities(std::vector<SharedM
 }
 
 SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double omega) {
+    size_t doubles = Process::environment.get_memory() * 0.8 / sizeof(double);
+    return form_unc_amplitudes(monomer, {omega}, doubles)[0];
+}
+
+size_t FDDS_Dispersion::omega_batch_size(size_t nwork) {
+    size_t naux = auxiliary_->nbf();
+    size_t nov = std::max(vector_cache_["eps_occ_A"]->dim(0) * vector_cache_["eps_vir_A"]->dim(0),
+                          vector_cache_["eps_occ_B"]->dim(0) * vector_cache_["eps_vir_B"]->dim(0));
+    size_t nvir = std::max(vector_cache_["eps_vir_A"]->dim(0), vector_cache_["eps_vir_B"]->dim(0));
+
+    // Each frequency of a batch holds its A and B amplitudes (the A ones while B is formed) and an
+    // ov scaling matrix; the caller's work and two ovQ block buffers are set aside once
+    size_t doubles = Process::environment.get_memory() * 0.8 / sizeof(double);
+    size_t reserve = nwork * naux * naux + 2 * naux * nvir;
+    size_t per_omega = 2 * naux * naux + nov;
+    if (doubles <= reserve + per_omega) return 1;
+    return (doubles - reserve) / per_omega;
+}
+
+std::vector<SharedMatrix> FDDS_Dispersion::form_unc_amplitudes(std::string monomer, std::vector<double> omegas,
+                                                               size_t doubles) {
     // ==> Configuration <==
     SharedVector eps_occ, eps_vir;
     std::string ovQ_tensor_name;
@@ -398,35 +421,42 @@ SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double ome
     size_t nocc = eps_occ->dim(0);
     size_t nvir = eps_vir->dim(0);
     size_t naux = auxiliary_->nbf();
+    size_t nomega = omegas.size();
 
-    // Check on memory real quick
-    size_t doubles = Process::environment.get_memory() * 0.8 / sizeof(double);
-    size_t mem_size = 2 * naux * nvir + naux * naux + nvir * nocc;
+    // With several frequencies the raw block is kept and each frequency scales a copy of it
+    size_t nbuffer = (nomega > 1 ? 2 : 1);
+
+    // Check on memory real quick; doubles is what the caller has left for this call
+    size_t mem_size = nbuffer * naux * nvir + nomega * (naux * naux + nvir * nocc);
     if (mem_size > doubles) {
         std::stringstream message;
         double mem_gb = ((double)(mem_size) / 0.8 * sizeof(double));
-        message << "FDDS Dispersion requires at least naux * nvir + naux * naux of memory." << std::endl;
+        message << "FDDS Dispersion requires at least naux * nvir + nomega * naux * naux of memory." << std::endl;
         message << "       After taxes this is " << std::setprecision(2) << mem_gb << " GB of memory.";
         throw PSIEXCEPTION(message.str());
     }
 
     // ==> Uncoupled Amplitudes <==
-    auto amp = std::make_shared<Matrix>(nocc, nvir);
-
-    double** ampp = amp->pointer();
     double* eoccp = eps_occ->pointer();
     double* evirp = eps_vir->pointer();
 
+    std::vector<SharedMatrix> amps;
+    for (size_t w = 0; w < nomega; w++) {
+        amps.push_back(std::make_shared<Matrix>(nocc, nvir));
+        double** ampp = amps[w]->pointer();
+        double omega = omegas[w];
+
 #pragma omp parallel for
-    for (size_t i = 0; i < nocc; i++) {
-        for (size_t a = 0; a < nvir; a++) {
-            double val = -1.0 * (eoccp[i] - evirp[a]);
-            double tmp = 4.0 * val / (val * val + omega * omega);
-            // Lets see how stable this is, should be fine
-            if (tmp < 1.e-14) {
-                ampp[i][a] = 0.0;
-            } else {
-                ampp[i][a] = std::pow(tmp, 0.5);
+        for (size_t i = 0; i < nocc; i++) {
+            for (size_t a = 0; a < nvir; a++) {
+                double val = -1.0 * (eoccp[i] - evirp[a]);
+                double tmp = 4.0 * val / (val * val + omega * omega);
+                // Lets see how stable this is, should be fine
+                if (tmp < 1.e-14) {
+                    ampp[i][a] = 0.0;
+                } else {
+                    ampp[i][a] = std::pow(tmp, 0.5);
+                }
             }
         }
     }
@@ -435,8 +465,9 @@ SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double ome
 
     // ==> Contract <==
 
-    size_t dmem = doubles - naux * naux - nvir * nocc;
-    size_t bsize = dmem / (naux * nvir);
+    // The ovQ tensor is streamed once in blocks of occupied orbitals for all frequencies
+    size_t dmem = doubles - nomega * (naux * naux + nvir * nocc);
+    size_t bsize = dmem / (nbuffer * naux * nvir);
     if (bsize > nocc) {
         bsize = nocc;
     }
@@ -445,18 +476,21 @@ SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double ome
     // printf("dmem:    %zu\n", dmem);
     // printf("bsize:   %zu\n", bsize);
 
-    auto ret = std::make_shared<Matrix>("UNC Amplitude", naux, naux);
+    std::vector<SharedMatrix> ret;
+    for (size_t w = 0; w < nomega; w++) {
+        ret.push_back(std::make_shared<Matrix>("UNC Amplitude", naux, naux));
+    }
     auto tmp = std::make_shared<Matrix>("iaQ tmp", bsize * nvir, naux);
+    SharedMatrix scaled = (nbuffer > 1 ? std::make_shared<Matrix>("iaQ scaled", bsize * nvir, naux) : tmp);
 
     double** tmpp = tmp->pointer();
-    double** retp = ret->pointer();
+    double** scaledp = scaled->pointer();
 
-    size_t rstat, osize;
+    size_t osize;
     for (size_t block = 0, bcount = 0; block < nblocks; block++) {
         // printf("Block %zu\n", block);
         if (((block + 1) * bsize) > nocc) {
             osize = nocc - block * bsize;
-            tmp->zero();
         } else {
             osize = bsize;
         }
@@ -464,21 +498,35 @@ SharedMatrix FDDS_Dispersion::form_unc_amplitude(std::string monomer, double ome
         dfh_->fill_tensor(ovQ_tensor_name, tmp, {bcount, bcount + osize});
         size_t shift_i = block * bsize;
 
+        for (size_t w = 0; w < nomega; w++) {
+            double** ampp = amps[w]->pointer();
+
 #pragma omp parallel for collapse(2)
-        for (size_t i = 0; i < osize; i++) {
-            for (size_t a = 0; a < nvir; a++) {
-                double val = ampp[i + shift_i][a];
+            for (size_t i = 0; i < osize; i++) {
+                for (size_t a = 0; a < nvir; a++) {
+                    double val = ampp[i + shift_i][a];
 #pragma omp simd
-                for (size_t Q = 0; Q < naux; Q++) {
-                    tmpp[i * nvir + a][Q] *= val;
+                    for (size_t Q = 0; Q < naux; Q++) {
+                        scaledp[i * nvir + a][Q] = tmpp[i * nvir + a][Q] * val;
+                    }
                 }
             }
-        }
 
-        ret->gemm(true, false, 1.0, tmp, tmp, 1.0);
+            // Only the lower triangle; the upper one is filled in at the end
+            C_DSYRK('L', 'T', naux, osize * nvir, 1.0, scaledp[0], naux, 1.0, ret[w]->pointer()[0], naux);
+        }
         bcount += osize;
     }
 
+    for (size_t w = 0; w < nomega; w++) {
+        double** retp = ret[w]->pointer();
+        for (size_t P = 0; P < naux; P++) {
+            for (size_t Q = 0; Q < P; Q++) {
+                retp[Q][P] = retp[P][Q];
+            }
+        }
+    }
+
     return ret;
 }
 }  // namespace sapt
@@ -31,6 +31,8 @@
 
 #include "psi4/libmints/typedefs.h"
 
+#include <vector>
+
 namespace psi {
 
 class BasisSet;
@@ -88,6 +90,26 @@ class FDDS_Dispersion {
      */
     SharedMatrix form_unc_amplitude(std::string monomer, double omega);
 
+    /**
+     * Forms the uncoupled amplitudes of several frequencies in one pass over Qia.
+     * Only the uncoupled amplitudes are batched: holding a batch raises the peak memory by
+     * nomega * naux * naux over the per-frequency path, and the coupled solve stays per frequency.
+     * @param  monomer Monomer "A" or "B"
+     * @param  omegas  Time dependent values
+     * @param  doubles Memory left for this call, in doubles, after what the caller still holds
+     * @return         "PQ" amplitude tensor of each omega
+     */
+    std::vector<SharedMatrix> form_unc_amplitudes(std::string monomer, std::vector<double> omegas,
+                                                  size_t doubles);
+
+    /**
+     * Number of frequencies whose A and B uncoupled amplitudes fit in memory at once, leaving
+     * room for the caller's naux x naux work
+     * @param  nwork   naux x naux matrices the caller keeps besides the amplitude batches
+     * @return         Frequencies per batch, at least one
+     */
+    size_t omega_batch_size(size_t nwork);
+
     /**
      * Returns the metric matrix
      * @return Metric
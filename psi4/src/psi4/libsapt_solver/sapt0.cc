@@ -71,6 +71,7 @@ SAPT0::SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA, SharedWavefu
     no_response_ = !options_.get_bool("COUPLED_INDUCTION");
     aio_cphf_ = options_.get_bool("AIO_CPHF");
     aio_dfints_ = options_.get_bool("AIO_DF_INTS");
+    aio_dfblocks_ = options_.get_bool("AIO_DF_BLOCKS");
     do_e10_ = options_.get_bool("SAPT0_E10");
     do_e20ind_ = options_.get_bool("SAPT0_E20IND");
     do_e20disp_ = options_.get_bool("SAPT0_E20DISP");
@@ -84,9 +85,14 @@ SAPT0::SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA, SharedWavefu
 
     wBAR_ = nullptr;
     wABS_ = nullptr;
+
+    df_aio_end_ = PSIO_ZERO;
+    io_wait_ = 0.0;
+    term_io_wait_ = 0.0;
 }
 
 SAPT0::~SAPT0() {
+    io_sync();
     if (wBAR_ != nullptr) free_block(wBAR_);
     if (wABS_ != nullptr) free_block(wABS_);
     psio_->close(PSIF_SAPT_AA_DF_INTS, 1);
@@ -110,45 +116,62 @@ double SAPT0::compute_energy() {
         df_integrals();
     timer_off("DF Integrals       ");
     timer_on("W Integrals        ");
+    term_on();
     w_integrals();
+    term_off("W Integrals");
     timer_off("W Integrals        ");
     if (!elst_basis_) {
         if (do_e10_) {
             timer_on("Elst10             ");
+            term_on();
             elst10();
+            term_off("Elst10");
             timer_off("Elst10             ");
             timer_on("Exch10             ");
+            term_on();
             exch10();
+            term_off("Exch10");
             timer_off("Exch10             ");
             timer_on("Exch10 S^2         ");
+            term_on();
             exch10_s2();
+            term_off("Exch10 S^2");
             timer_off("Exch10 S^2         ");
         }
     }
     if (do_e20ind_) {
         timer_on("Ind20              ");
+        term_on();
         if (debug_ || no_response_) ind20();
         if (!no_response_) ind20r();
+        term_off("Ind20");
         timer_off("Ind20              ");
         timer_on("Exch-Ind20         ");
+        term_on();
         exch_ind20A_B();
         exch_ind20B_A();
+        term_off("Exch-Ind20");
         timer_off("Exch-Ind20         ");
     }
     if (do_e20disp_) {
         if (debug_) disp20();
         timer_on("Exch-Disp20 N^5    ");
+        term_on();
         psio_->open(PSIF_SAPT_TEMP, PSIO_OPEN_NEW);
         exch_disp20_n5();
+        term_off("Exch-Disp20 N^5");
         timer_off("Exch-Disp20 N^5    ");
         timer_on("Exch-Disp20 N^4    ");
+        term_on();
         exch_disp20_n4();
         psio_->close(PSIF_SAPT_TEMP, 0);
+        term_off("Exch-Disp20 N^4");
         timer_off("Exch-Disp20 N^4    ");
     }
 
     if (!options_.get_bool("SAPT_QUIET")) {
         print_results();
+        print_io_times();
     }
 
     set_scalar_variable("E Elst10", e_elst10_);
@@ -348,6 +371,17 @@ void SAPT0::print_results() {
     }
 }
 
+void SAPT0::print_io_times() {
+    outfile->Printf("\n    DF Integral Reads       Compute [s]  I/O Wait [s]\n");
+    outfile->Printf("  ----------------------------------------------------\n");
+    for (const auto &term : io_times_) {
+        double wall = std::get<1>(term);
+        double wait = std::get<2>(term);
+        outfile->Printf("    %-20s %14.3lf %13.3lf\n", std::get<0>(term).c_str(), wall - wait, wait);
+    }
+    outfile->Printf("\n");
+}
+
 void SAPT0::check_memory() {
     double memory = 8.0 * mem_ / 1000000.0;
 
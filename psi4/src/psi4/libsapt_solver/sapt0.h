@@ -34,6 +34,11 @@
 #include "psi4/libpsio/config.h"
 #include "psi4/libmints/matrix.h"
 
+#include <chrono>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace psi {
 namespace sapt {
 
@@ -97,6 +102,16 @@ class SAPT0 : public SAPT {
     void read_block(Iterator *, SAPTDFInts *);
     void read_block(Iterator *, SAPTDFInts *, SAPTDFInts *);
 
+    bool prefetch_block(long int, SAPTDFInts *);
+    long int block_rows(Iterator *, size_t, SAPTDFInts *, bool);
+    void read_rows(SAPTDFInts *, double **, long int, bool);
+    void fill_dress(SAPTDFInts *, long int);
+    void io_sync();
+
+    void term_on();
+    void term_off(const std::string &);
+    void print_io_times();
+
     void ind20rA_B();
     void ind20rB_A();
     void ind20rA_B_aio();
@@ -130,6 +145,7 @@ class SAPT0 : public SAPT {
     bool no_response_;
     bool aio_cphf_;
     bool aio_dfints_;
+    bool aio_dfblocks_;
     bool do_e10_;
     bool do_e20ind_;
     bool do_e20disp_;
@@ -157,6 +173,15 @@ class SAPT0 : public SAPT {
     double **wBAR_;
     double **wABS_;
 
+    // Blocked DF integral reads that run ahead of the terms; one handler so they never overlap
+    std::shared_ptr<AIOHandler> df_aio_;
+    psio_address df_aio_end_;
+    // Seconds the terms spent waiting on DF integral reads, and per term (label, wall, wait)
+    double io_wait_;
+    double term_io_wait_;
+    std::chrono::steady_clock::time_point term_start_;
+    std::vector<std::tuple<std::string, double, double>> io_times_;
+
    public:
     SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA, SharedWavefunction MonomerB, Options &options,
           std::shared_ptr<PSIO> psio);
@@ -188,6 +213,7 @@ struct SAPTDFInts {
     size_t j_start_;
 
     SharedMatrix BpMat_;
+    SharedMatrix BpNext_;
     SharedMatrix BdMat_;
     double **B_p_{nullptr};
     double **B_d_{nullptr};
@@ -197,6 +223,14 @@ struct SAPTDFInts {
 
     psio_address next_DF_ = PSIO_ZERO;
 
+    // Set while blocks are read ahead into BpNext_; a read still in flight is waited for before
+    // the buffers or the file position are reset
+    std::shared_ptr<AIOHandler> aio_;
+
+    void io_sync() {
+        if (aio_) aio_->synchronize();
+    };
+
     SAPTDFInts() {
         next_DF_ = PSIO_ZERO;
         B_p_ = nullptr;
@@ -206,14 +240,21 @@ struct SAPTDFInts {
         B_p_ = nullptr;
         B_d_ = nullptr;
     };
-    void rewind() { next_DF_ = PSIO_ZERO; };
+    void rewind() {
+        io_sync();
+        next_DF_ = PSIO_ZERO;
+    };
     void clear() {
+        io_sync();
         BpMat_.reset();
+        BpNext_.reset();
         B_p_ = nullptr;
         next_DF_ = PSIO_ZERO;
     };
     void done() {
+        io_sync();
         BpMat_.reset();
+        BpNext_.reset();
         if (dress_) BdMat_.reset();
         B_p_ = nullptr;
         B_d_ = nullptr;
@@ -227,7 +268,16 @@ struct Iterator {
     size_t curr_block;
     long int curr_size;
 
+    // Read each next block into the BpNext_ buffers while the current one is used. A
+    // prefetch is in flight from one read_block() to the next, so loops read every block.
+    bool prefetch = false;
+    bool pending = false;
+    std::shared_ptr<AIOHandler> aio;
+
+    // A loop left early may still have a block in flight; it is waited for and dropped
     void rewind() {
+        if (pending && aio) aio->synchronize();
+        pending = false;
         curr_block = 1;
         curr_size = 0;
     };
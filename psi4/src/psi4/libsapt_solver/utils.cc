@@ -34,11 +34,20 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/libqt/qt.h"
 
+#include <chrono>
 #include <cmath>
 
 namespace psi {
 namespace sapt {
 
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
 void SAPT::zero_disk(int file, const char *array, int rows, int columns) {
     double *zero = init_array(columns);
     psio_address next_PSIF = PSIO_ZERO;
@@ -50,6 +59,9 @@ void SAPT::zero_disk(int file, const char *array, int rows, int columns) {
 }
 
 void SAPT0::read_all(SAPTDFInts *ints) {
+    auto start = std::chrono::steady_clock::now();
+    io_sync();
+
     long int nri = ndf_;
     if (ints->dress_) nri += 3L;
 
@@ -71,103 +83,104 @@ void SAPT0::read_all(SAPTDFInts *ints) {
                         ints->next_DF_, &ints->next_DF_);
         }
     }
+    io_wait_ += seconds_since(start);
 
     if (ints->dress_ && !ints->dress_disk_)
         C_DCOPY(3L * ints->ij_length_, &(ints->B_d_[0][0]), 1, &(ints->B_p_[ndf_][0]), 1);
 }
 
-void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA) {
-    bool last_block = false;
-    if (iter->curr_block == iter->num_blocks) last_block = true;
-    bool dress = false;
-    if (intA->dress_) dress = true;
-    long int block_length = iter->block_size[iter->curr_block - 1];
-    iter->curr_block++;
-
-    //  printf("%d %d %d %d %d %d\n",iter->num_blocks,block_length,
-    //    iter->curr_block,block_length,last_block,dress);
-
-    iter->curr_size = block_length;
-    if (last_block && dress) block_length -= 3;
+void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA) { read_block(iter, intA, nullptr); }
 
-    if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * block_length * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
-    } else if (!intA->active_) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
-    } else {
-        for (int p = 0; p < block_length; p++) {
-            intA->next_DF_ = psio_get_address(intA->next_DF_, sizeof(double) * intA->i_start_ * intA->j_length_);
-            psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[p][0]), sizeof(double) * intA->ij_length_,
-                        intA->next_DF_, &intA->next_DF_);
+void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB) {
+    SAPTDFInts *ints[2] = {intA, intB};
+    int nints = (intB == nullptr ? 1 : 2);
+    bool dress = intA->dress_ || (intB != nullptr && intB->dress_);
+    size_t block = iter->curr_block - 1;
+    bool last_block = (iter->curr_block == iter->num_blocks);
+    iter->curr_block++;
+    iter->curr_size = iter->block_size[block];
+
+    auto start = std::chrono::steady_clock::now();
+    if (iter->pending) {
+        df_aio_->synchronize();
+        for (int n = 0; n < nints; n++) {
+            ints[n]->BpMat_.swap(ints[n]->BpNext_);
+            ints[n]->B_p_ = ints[n]->BpMat_->pointer();
         }
+        iter->pending = false;
+    } else {
+        io_sync();
+        for (int n = 0; n < nints; n++)
+            read_rows(ints[n], ints[n]->B_p_, block_rows(iter, block, ints[n], dress), false);
     }
+    io_wait_ += seconds_since(start);
 
     if (dress && last_block) {
-        if (intA->dress_ && !intA->dress_disk_) {
-            C_DCOPY(3L * intA->ij_length_, &(intA->B_d_[0][0]), 1, &(intA->B_p_[block_length][0]), 1);
-        } else if (!intA->dress_disk_) {
-            memset(&(intA->B_p_[block_length][0]), '\0', sizeof(double) * 3L * intA->ij_length_);
-        }
+        for (int n = 0; n < nints; n++) fill_dress(ints[n], iter->curr_size - 3L);
     }
-}
-
-void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB) {
-    bool last_block = false;
-    if (iter->curr_block == iter->num_blocks) last_block = true;
-    bool dress = false;
-    if (intA->dress_ || intB->dress_) dress = true;
-    long int block_length = iter->block_size[iter->curr_block - 1];
-    iter->curr_block++;
 
-    //  printf("%d %d %d %d %d %d\n",iter->num_blocks,block_length,
-    //    iter->curr_block,block_length,last_block,dress);
+    // The next block is read while the caller works on this one
+    if (iter->prefetch && !last_block) {
+        for (int n = 0; n < nints; n++)
+            read_rows(ints[n], ints[n]->BpNext_->pointer(), block_rows(iter, block + 1, ints[n], dress), true);
+        iter->pending = true;
+    }
+}
 
-    iter->curr_size = block_length;
-    if (last_block && dress) block_length -= 3;
+// Rows of a block that come from disk; the three dressing rows of the last block are only read
+// when they are stored with the integrals
+long int SAPT0::block_rows(Iterator *iter, size_t block, SAPTDFInts *ints, bool dress) {
+    long int rows = iter->block_size[block];
+    if (dress && block + 1 == iter->num_blocks) {
+        rows -= 3L;
+        if (!ints->active_ && ints->dress_disk_) rows += 3L;
+    }
+    return rows;
+}
 
-    if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * block_length * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
-    } else if (!intA->active_) {
-        psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intA->ij_length_, intA->next_DF_, &intA->next_DF_);
+void SAPT0::read_rows(SAPTDFInts *ints, double **B, long int rows, bool async) {
+    if (!ints->active_) {
+        size_t size = sizeof(double) * rows * ints->ij_length_;
+        if (async) {
+            df_aio_->read(ints->filenum_, ints->label_, (char *)&(B[0][0]), size, ints->next_DF_, &df_aio_end_);
+            ints->next_DF_ = psio_get_address(ints->next_DF_, size);
+        } else {
+            psio_->read(ints->filenum_, ints->label_, (char *)&(B[0][0]), size, ints->next_DF_, &ints->next_DF_);
+        }
+    } else if (async) {
+        size_t skip = ints->i_start_ * ints->j_length_;
+        df_aio_->read_discont(ints->filenum_, ints->label_, B, rows, ints->ij_length_, skip,
+                              psio_get_address(ints->next_DF_, sizeof(double) * skip));
+        ints->next_DF_ = psio_get_address(ints->next_DF_, sizeof(double) * rows * (skip + ints->ij_length_));
     } else {
-        for (int p = 0; p < block_length; p++) {
-            intA->next_DF_ = psio_get_address(intA->next_DF_, sizeof(double) * intA->i_start_ * intA->j_length_);
-            psio_->read(intA->filenum_, intA->label_, (char *)&(intA->B_p_[p][0]), sizeof(double) * intA->ij_length_,
-                        intA->next_DF_, &intA->next_DF_);
+        for (int p = 0; p < rows; p++) {
+            ints->next_DF_ = psio_get_address(ints->next_DF_, sizeof(double) * ints->i_start_ * ints->j_length_);
+            psio_->read(ints->filenum_, ints->label_, (char *)&(B[p][0]), sizeof(double) * ints->ij_length_,
+                        ints->next_DF_, &ints->next_DF_);
         }
     }
+}
 
-    if (!intB->active_ && (!intB->dress_disk_ || !last_block)) {
-        psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[0][0]),
-                    sizeof(double) * block_length * intB->ij_length_, intB->next_DF_, &intB->next_DF_);
-    } else if (!intB->active_) {
-        psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[0][0]),
-                    sizeof(double) * (block_length + 3L) * intB->ij_length_, intB->next_DF_, &intB->next_DF_);
-    } else {
-        for (int p = 0; p < block_length; p++) {
-            intB->next_DF_ = psio_get_address(intB->next_DF_, sizeof(double) * intB->i_start_ * intB->j_length_);
-            psio_->read(intB->filenum_, intB->label_, (char *)&(intB->B_p_[p][0]), sizeof(double) * intB->ij_length_,
-                        intB->next_DF_, &intB->next_DF_);
-        }
+void SAPT0::fill_dress(SAPTDFInts *ints, long int row) {
+    if (ints->dress_ && !ints->dress_disk_) {
+        C_DCOPY(3L * ints->ij_length_, &(ints->B_d_[0][0]), 1, &(ints->B_p_[row][0]), 1);
+    } else if (!ints->dress_disk_) {
+        memset(&(ints->B_p_[row][0]), '\0', sizeof(double) * 3L * ints->ij_length_);
     }
+}
 
-    if (dress && last_block) {
-        if (intA->dress_ && !intA->dress_disk_) {
-            C_DCOPY(3L * intA->ij_length_, &(intA->B_d_[0][0]), 1, &(intA->B_p_[block_length][0]), 1);
-        } else if (!intA->dress_disk_) {
-            memset(&(intA->B_p_[block_length][0]), '\0', sizeof(double) * 3L * intA->ij_length_);
-        }
+// Blocks of length rows are read ahead, in two buffers of half the length, when that leaves
+// blocks that still hold the dressing rows. Only the DF integral files qualify: they are written
+// once by df_integrals() and only read while the terms run, so the reads may overlap the terms'
+// own I/O on the scratch files.
+bool SAPT0::prefetch_block(long int length, SAPTDFInts *ints) {
+    if (!aio_dfblocks_ || length / 2 <= 3) return false;
+    return ints->filenum_ == PSIF_SAPT_AA_DF_INTS || ints->filenum_ == PSIF_SAPT_BB_DF_INTS ||
+           ints->filenum_ == PSIF_SAPT_AB_DF_INTS;
+}
 
-        if (intB->dress_ && !intB->dress_disk_) {
-            C_DCOPY(3L * intB->ij_length_, &(intB->B_d_[0][0]), 1, &(intB->B_p_[block_length][0]), 1);
-        } else if (!intB->dress_disk_) {
-            memset(&(intB->B_p_[block_length][0]), '\0', sizeof(double) * 3L * intB->ij_length_);
-        }
-    }
+void SAPT0::io_sync() {
+    if (df_aio_) df_aio_->synchronize();
 }
 
 Iterator SAPT0::get_iterator(long int mem, SAPTDFInts *intA, bool alloc) {
@@ -178,7 +191,20 @@ Iterator SAPT0::get_iterator(long int mem, SAPTDFInts *intA, bool alloc) {
     long int length = mem / ij_size;
     if (length > max_length) length = max_length;
 
-    return (set_iterator(length, intA, alloc));
+    bool prefetch = alloc && length < max_length && prefetch_block(length, intA);
+    if (prefetch) length /= 2;
+
+    Iterator iter = set_iterator(length, intA, alloc);
+
+    if (prefetch) {
+        intA->BpNext_ = std::make_shared<Matrix>(iter.block_size[0], intA->ij_length_);
+        if (!df_aio_) df_aio_ = std::make_shared<AIOHandler>(psio_);
+        intA->aio_ = df_aio_;
+        iter.aio = df_aio_;
+        iter.prefetch = true;
+    }
+
+    return (iter);
 }
 
 Iterator SAPT0::set_iterator(long int length, SAPTDFInts *intA, bool alloc) {
@@ -224,7 +250,22 @@ Iterator SAPT0::get_iterator(long int mem, SAPTDFInts *intA, SAPTDFInts *intB, b
     long int length = mem / ij_size;
     if (length > max_length) length = max_length;
 
-    return (set_iterator(length, intA, intB, alloc));
+    bool prefetch = alloc && length < max_length && prefetch_block(length, intA) && prefetch_block(length, intB);
+    if (prefetch) length /= 2;
+
+    Iterator iter = set_iterator(length, intA, intB, alloc);
+
+    if (prefetch) {
+        intA->BpNext_ = std::make_shared<Matrix>(iter.block_size[0], intA->ij_length_);
+        intB->BpNext_ = std::make_shared<Matrix>(iter.block_size[0], intB->ij_length_);
+        if (!df_aio_) df_aio_ = std::make_shared<AIOHandler>(psio_);
+        intA->aio_ = df_aio_;
+        intB->aio_ = df_aio_;
+        iter.aio = df_aio_;
+        iter.prefetch = true;
+    }
+
+    return (iter);
 }
 
 Iterator SAPT0::set_iterator(long int length, SAPTDFInts *intA, SAPTDFInts *intB, bool alloc) {
@@ -264,6 +305,15 @@ Iterator SAPT0::set_iterator(long int length, SAPTDFInts *intA, SAPTDFInts *intB
     return (iter);
 }
 
+void SAPT0::term_on() {
+    term_start_ = std::chrono::steady_clock::now();
+    term_io_wait_ = io_wait_;
+}
+
+void SAPT0::term_off(const std::string &label) {
+    io_times_.emplace_back(label, seconds_since(term_start_), io_wait_ - term_io_wait_);
+}
+
 SAPTDFInts SAPT0::set_A_AA() {
     double enuc, NA, NB;
 
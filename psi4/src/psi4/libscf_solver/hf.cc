@@ -1187,6 +1187,17 @@ void HF::guess() {
         form_D();
         guess_E = compute_initial_E();
 
+    } else if (guess_type == "SAPGAU") {
+        // SAP guess, potentials from Gaussian fits
+        if (print_)
+            outfile->Printf(
+                "  SCF Guess: Superposition of Atomic Potentials, Gaussian fit (doi:10.1021/acs.jctc.8b01089).\n\n");
+
+        compute_SAPGAU_guess();
+        form_initial_C();
+        form_D();
+        guess_E = compute_initial_E();
+
     } else {
         throw PSIEXCEPTION("  SCF Guess: No guess was found!");
     }
@@ -214,6 +214,8 @@ class HF : public Wavefunction {
     virtual void compute_SAD_guess(bool natorb);
     /// Huckel guess
     virtual void compute_huckel_guess();
+    /// SAP guess from Gaussian fits of the atomic potentials, without a grid
+    void compute_SAPGAU_guess();
 
     /** Transformation, diagonalization, and backtransform of Fock matrix */
     virtual void diagonalize_F(const SharedMatrix& F, SharedMatrix& C, std::shared_ptr<Vector>& eps);
@@ -34,10 +34,13 @@
  *
  */
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <exception>
+#include <fstream>
 #include <vector>
 #include <utility>
 
@@ -81,6 +84,100 @@ static bool SAD_use_fitting(const Options& opt) {
     throw PSIEXCEPTION("SAD_SCF_TYPE " + opt.get_str("SAD_SCF_TYPE") + " not implemented.\n");
 }
 
+// FNV-1a over the bytes of the things the atomic density depends on
+static void sad_hash(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+static void sad_hash(uint64_t& hash, double value) { sad_hash(hash, &value, sizeof(double)); }
+static void sad_hash(uint64_t& hash, int value) { sad_hash(hash, &value, sizeof(int)); }
+static void sad_hash(uint64_t& hash, const std::string& value) { sad_hash(hash, value.data(), value.size()); }
+static void sad_hash(uint64_t& hash, std::shared_ptr<BasisSet> bas) {
+    sad_hash(hash, bas->name());
+    sad_hash(hash, bas->nbf());
+    sad_hash(hash, static_cast<int>(bas->has_puream()));
+    sad_hash(hash, bas->n_ecp_core());
+    for (int Q = 0; Q < bas->nshell(); Q++) {
+        const GaussianShell& shell = bas->shell(Q);
+        sad_hash(hash, shell.am());
+        for (int K = 0; K < shell.nprimitive(); K++) {
+            sad_hash(hash, shell.exp(K));
+            sad_hash(hash, shell.original_coef(K));
+        }
+    }
+    for (int Q = 0; Q < bas->n_ecp_shell(); Q++) {
+        const GaussianShell& shell = bas->ecp_shell(Q);
+        sad_hash(hash, shell.am());
+        for (int K = 0; K < shell.nprimitive(); K++) {
+            sad_hash(hash, shell.exp(K));
+            sad_hash(hash, shell.coef(K));
+        }
+    }
+}
+
+// Name of the cached atomic density: the element, then a hash of the basis, the fitting basis,
+// the occupations and the atomic UHF settings
+static std::string SAD_cache_name(const Options& opt, int Z, std::shared_ptr<BasisSet> bas,
+                                  std::shared_ptr<BasisSet> fit, SharedVector occ_a, SharedVector occ_b) {
+    uint64_t hash = 14695981039346656037ULL;
+    sad_hash(hash, bas);
+    if (fit) sad_hash(hash, fit);
+    for (int i = 0; i < occ_a->dim(); i++) sad_hash(hash, occ_a->get(i));
+    sad_hash(hash, -1);
+    for (int i = 0; i < occ_b->dim(); i++) sad_hash(hash, occ_b->get(i));
+    sad_hash(hash, opt.get_double("SAD_E_CONVERGENCE"));
+    sad_hash(hash, opt.get_double("SAD_D_CONVERGENCE"));
+    sad_hash(hash, opt.get_int("SAD_MAXITER"));
+    sad_hash(hash, static_cast<int>(opt.get_bool("DIIS_RMS_ERROR")));
+
+    char name[64];
+    snprintf(name, sizeof(name), "psi.sad.%d.%016llx.dat", Z, static_cast<unsigned long long>(hash));
+    return std::string(name);
+}
+
+// Cached atomic density, orbitals and orbital energies; false if absent or not of this shape
+static bool SAD_read_cache(const std::string& filename, SharedMatrix D, SharedMatrix Chu, SharedVector Ehu) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+    int nbf = 0, nhu = 0;
+    file.read(reinterpret_cast<char*>(&nbf), sizeof(int));
+    file.read(reinterpret_cast<char*>(&nhu), sizeof(int));
+    if (!file || nbf != D->rowdim() || nhu != Chu->coldim()) return false;
+    file.read(reinterpret_cast<char*>(D->pointer()[0]), sizeof(double) * nbf * nbf);
+    if (nhu) {
+        file.read(reinterpret_cast<char*>(Chu->pointer()[0]), sizeof(double) * nbf * nhu);
+        file.read(reinterpret_cast<char*>(Ehu->pointer()), sizeof(double) * nhu);
+    }
+    return static_cast<bool>(file);
+}
+
+// Written under a private name and renamed, so concurrent jobs only ever see complete files
+static void SAD_write_cache(const std::string& filename, SharedMatrix D, SharedMatrix Chu, SharedVector Ehu) {
+    std::string tmpname = filename + "." + psio_getpid();
+    {
+        std::ofstream file(tmpname, std::ios::binary);
+        if (!file) return;
+        int nbf = D->rowdim();
+        int nhu = Chu->coldim();
+        file.write(reinterpret_cast<const char*>(&nbf), sizeof(int));
+        file.write(reinterpret_cast<const char*>(&nhu), sizeof(int));
+        file.write(reinterpret_cast<const char*>(D->pointer()[0]), sizeof(double) * nbf * nbf);
+        if (nhu) {
+            file.write(reinterpret_cast<const char*>(Chu->pointer()[0]), sizeof(double) * nbf * nhu);
+            file.write(reinterpret_cast<const char*>(Ehu->pointer()), sizeof(double) * nhu);
+        }
+        if (!file) {
+            file.close();
+            std::remove(tmpname.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpname.c_str(), filename.c_str())) std::remove(tmpname.c_str());
+}
+
 SADGuess::SADGuess(std::shared_ptr<BasisSet> basis, std::vector<std::shared_ptr<BasisSet>> atomic_bases,
                    Options& options)
     : basis_(basis), atomic_bases_(atomic_bases), options_(options) {
@@ -240,7 +337,17 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
     // Atomic orbital energies for Huckel
     std::vector<SharedVector> atomic_Ehu(nunique);
 
-    if (print_ > 1) outfile->Printf("\n  Performing Atomic UHF Computations:\n");
+    bool use_fitting = SAD_use_fitting(options_);
+    std::string cache_dir = options_.get_str("SAD_CACHE_DIR");
+
+    // Occupations of the unique atoms
+    std::vector<SharedVector> atomic_occ_a(nunique);
+    std::vector<SharedVector> atomic_occ_b(nunique);
+    // Cached atomic density files
+    std::vector<std::string> cache_files(nunique);
+    // Unique atoms that need an atomic UHF computation
+    std::vector<int> uhf_atoms;
+
     for (int uniA = 0; uniA < nunique; uniA++) {
         int index = atomic_indices[uniA];
         int nbf = atomic_bases_[index]->nbf();
@@ -250,11 +357,6 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
             continue;
         }
 
-        if (print_ > 1) {
-            outfile->Printf("\n  UHF Computation for Unique Atom %d which is Atom %d:\n", uniA, index);
-            outfile->Printf("  Occupation: nalpha = %.1f, nbeta = %.1f, nbf = %d\n", nalpha[uniA], nbeta[uniA], nbf);
-        }
-
         // Occupation numbers
         SharedVector occ_a, occ_b;
         // Number of orbitals occupied, partially or fully
@@ -326,16 +428,63 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
         atomic_Chu[uniA] = std::make_shared<Matrix>("Atomic Huckel C", nbf, nhu);
         atomic_Ehu[uniA] = std::make_shared<Vector>("Atomic Huckel E", nhu);
 
-        if (SAD_use_fitting(options_)) {
-            get_uhf_atomic_density(atomic_bases_[index], atomic_fit_bases_[index], occ_a, occ_b, atomic_D[uniA],
-                                   atomic_Chu[uniA], atomic_Ehu[uniA]);
-        } else {
-            std::shared_ptr<BasisSet> zbas = BasisSet::zero_ao_basis_set();
-            get_uhf_atomic_density(atomic_bases_[index], zbas, occ_a, occ_b, atomic_D[uniA], atomic_Chu[uniA],
-                                   atomic_Ehu[uniA]);
+        atomic_occ_a[uniA] = occ_a;
+        atomic_occ_b[uniA] = occ_b;
+
+        if (!cache_dir.empty()) {
+            std::shared_ptr<BasisSet> fit = use_fitting ? atomic_fit_bases_[index] : nullptr;
+            cache_files[uniA] =
+                cache_dir + "/" + SAD_cache_name(options_, Z, atomic_bases_[index], fit, occ_a, occ_b);
+            if (SAD_read_cache(cache_files[uniA], atomic_D[uniA], atomic_Chu[uniA], atomic_Ehu[uniA])) {
+                if (print_ > 1)
+                    outfile->Printf("  Atomic density of unique atom %d read from %s\n", uniA,
+                                    cache_files[uniA].c_str());
+                continue;
+            }
+        }
+        uhf_atoms.push_back(uniA);
+    }
+
+    // The atoms are independent, so each thread runs whole atomic UHF computations with a JK of its own.
+    // Verbose output of several atoms would interleave, so that stays serial.
+    int nuhf = uhf_atoms.size();
+    int nparallel = (print_ > 1) ? 1 : std::max(1, std::min(Process::environment.get_n_threads(), nuhf));
+    std::vector<std::exception_ptr> errors(nuhf);
+    std::vector<int> converged(nuhf, 0);
+
+    if (print_ > 1) outfile->Printf("\n  Performing Atomic UHF Computations:\n");
+#pragma omp parallel for schedule(dynamic) num_threads(nparallel)
+    for (int task = 0; task < nuhf; task++) {
+        int uniA = uhf_atoms[task];
+        int index = atomic_indices[uniA];
+        if (print_ > 1) {
+            outfile->Printf("\n  UHF Computation for Unique Atom %d which is Atom %d:\n", uniA, index);
+            outfile->Printf("  Occupation: nalpha = %.1f, nbeta = %.1f, nbf = %d\n", nalpha[index], nbeta[index],
+                            atomic_bases_[index]->nbf());
+        }
+
+        try {
+            std::shared_ptr<BasisSet> fit = use_fitting ? atomic_fit_bases_[index] : BasisSet::zero_ao_basis_set();
+            converged[task] = get_uhf_atomic_density(atomic_bases_[index], fit, atomic_occ_a[uniA],
+                                                     atomic_occ_b[uniA], atomic_D[uniA], atomic_Chu[uniA],
+                                                     atomic_Ehu[uniA], nparallel);
+        } catch (...) {
+            errors[task] = std::current_exception();
         }
         if (print_ > 1) outfile->Printf("Finished UHF Computation!\n");
     }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Only converged atoms go into the cache
+    if (!cache_dir.empty()) {
+        for (int task = 0; task < nuhf; task++) {
+            int uniA = uhf_atoms[task];
+            if (converged[task])
+                SAD_write_cache(cache_files[uniA], atomic_D[uniA], atomic_Chu[uniA], atomic_Ehu[uniA]);
+        }
+    }
     if (print_) outfile->Printf("\n");
 
     // Add atomic_D into D (scale by 1/2, we like effective pairs)
@@ -392,8 +541,9 @@ void SADGuess::run_atomic_calculations(SharedMatrix& DAO, SharedMatrix& HuckelC,
         HuckelE->print();
     }
 }
-void SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, std::shared_ptr<BasisSet> fit, SharedVector occ_a,
-                                      SharedVector occ_b, SharedMatrix D, SharedMatrix Chuckel, SharedVector Ehuckel) {
+bool SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, std::shared_ptr<BasisSet> fit, SharedVector occ_a,
+                                      SharedVector occ_b, SharedMatrix D, SharedMatrix Chuckel, SharedVector Ehuckel,
+                                      int nparallel) {
     std::shared_ptr<Molecule> mol = bas->molecule();
     mol->update_geometry();
     if (print_ > 1) {
@@ -522,15 +672,19 @@ void SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, std::shared
         if (options_["DF_INTS_NUM_THREADS"].has_changed())
             dfjk->set_df_ints_num_threads(options_.get_int("DF_INTS_NUM_THREADS"));
         dfjk->dfh()->set_print_lvl(0);
+        if (nparallel > 1) dfjk->set_df_ints_num_threads(1);
         jk = std::unique_ptr<JK>(dfjk);
     } else {
         DirectJK* directjk(new DirectJK(bas));
         if (options_["DF_INTS_NUM_THREADS"].has_changed())
             directjk->set_df_ints_num_threads(options_.get_int("DF_INTS_NUM_THREADS"));
+        if (nparallel > 1) directjk->set_df_ints_num_threads(1);
         jk = std::unique_ptr<JK>(directjk);
     }
 
-    jk->set_memory((size_t)(0.5 * (Process::environment.get_memory() / 8L)));
+    // Atoms computed side by side share the threads and the memory
+    if (nparallel > 1) jk->set_omp_nthread(1);
+    jk->set_memory((size_t)(0.5 * (Process::environment.get_memory() / 8L) / nparallel));
     jk->initialize();
     if (print_ > 1) jk->print_header();
 
@@ -615,6 +769,7 @@ void SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, std::shared
         }
 
         if (iteration > sad_maxiter) {
+#pragma omp critical
             outfile->Printf(
                 "\n WARNING: Atomic UHF is not converging! Try casting from a smaller basis or call Rob at CCMST.\n");
             break;
@@ -636,6 +791,8 @@ void SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, std::shared
     for (int i = 0; i < occ_a->dim(); i++) {
         Eoccp[i] = Ep[i];
     }
+
+    return converged;
 }
 void SADGuess::form_gradient(SharedMatrix grad, SharedMatrix F, SharedMatrix D, SharedMatrix S, SharedMatrix X) {
     int nbf = X->rowdim();
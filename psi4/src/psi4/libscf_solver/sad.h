@@ -58,9 +58,10 @@ class SADGuess {
 
     void run_atomic_calculations(SharedMatrix& D_AO, SharedMatrix& Huckel_C, SharedVector& Huckel_E);
     void form_gradient(SharedMatrix grad, SharedMatrix F, SharedMatrix D, SharedMatrix S, SharedMatrix X);
-    void get_uhf_atomic_density(std::shared_ptr<BasisSet> atomic_basis, std::shared_ptr<BasisSet> fit_basis,
+    /// Atomic UHF density and occupied orbitals; nparallel atoms are computed side by side. True if converged
+    bool get_uhf_atomic_density(std::shared_ptr<BasisSet> atomic_basis, std::shared_ptr<BasisSet> fit_basis,
                                 SharedVector occ_a, SharedVector occ_b, SharedMatrix D, SharedMatrix Chuckel,
-                                SharedVector Ehuckel);
+                                SharedVector Ehuckel, int nparallel = 1);
     void form_C_and_D(SharedMatrix X, SharedMatrix F, SharedMatrix C, SharedVector E, SharedMatrix Cocc,
                       SharedVector occ, SharedMatrix D);
 
@@ -0,0 +1,213 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2019 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+/*
+ * Superposition of atomic potentials without a quadrature grid. The screening of every nucleus,
+ * Z - Zeff(r) from the tabulated SAP effective charges, is fitted to a sum of error functions,
+ * which is the Coulomb potential of a set of normalized Gaussian charges. The potential matrix is
+ * then one contraction of three-index (P|mn) integrals, with P one contracted charge per atom,
+ * Schwarz-screened over the orbital pairs.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "psi4/libfock/sap.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libmints/sieve.h"
+#include "psi4/libmints/twobody.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libqt/qt.h"
+#include "hf.h"
+
+namespace psi {
+namespace scf {
+
+// Even-tempered exponents of the screening charges, from the valence tail to deep in the core
+static std::vector<double> SAPGAU_exponents() {
+    std::vector<double> alpha;
+    for (int k = 0; k < 27; k++) alpha.push_back(0.02 * std::pow(2.0, k));
+    return alpha;
+}
+
+// Least-squares fit of Z - Zeff(r) = sum_k c_k erf(sqrt(alpha_k) r) on a logarithmic radial grid,
+// with the c_k summing to Z so that the atom is neutral at long range
+static std::vector<double> SAPGAU_fit(int Z, const std::vector<double>& alpha) {
+    const int nrad = 400;
+    const double rmin = 1.0E-4;
+    const double rmax = std::min(30.0, sap_cutoff_radius());
+    int nfit = alpha.size();
+    int nfree = nfit - 1;
+
+    // The last coefficient is eliminated through the charge constraint
+    auto A = std::make_shared<Matrix>("SAP Fit Functions", nrad, nfree);
+    auto y = std::make_shared<Vector>("SAP Fit Screening", nrad);
+    double** Ap = A->pointer();
+    double* yp = y->pointer();
+    for (int i = 0; i < nrad; i++) {
+        double r = rmin * std::pow(rmax / rmin, i / (nrad - 1.0));
+        double last = std::erf(std::sqrt(alpha[nfree]) * r);
+        for (int k = 0; k < nfree; k++) Ap[i][k] = std::erf(std::sqrt(alpha[k]) * r) - last;
+        yp[i] = Z - sap_effective_charge(Z, r) - Z * last;
+    }
+
+    // The error functions are nearly dependent, so the normal equations go through the pseudoinverse
+    auto AtA = linalg::doublet(A, A, true, false);
+    auto Aty = std::make_shared<Vector>("SAP Fit Projection", nfree);
+    C_DGEMV('T', nrad, nfree, 1.0, Ap[0], nfree, yp, 1, 0.0, Aty->pointer(), 1);
+    AtA->power(-1.0, 1.0E-12);
+
+    std::vector<double> c(nfit, 0.0);
+    C_DGEMV('N', nfree, nfree, 1.0, AtA->pointer()[0], nfree, Aty->pointer(), 1, 0.0, c.data(), 1);
+    c[nfree] = Z;
+    for (int k = 0; k < nfree; k++) c[nfree] -= c[k];
+    return c;
+}
+
+void HF::compute_SAPGAU_guess() {
+    // The charges live on a copy, so the basis labels of the caller's molecule stay as they are
+    auto mol = std::make_shared<Molecule>(*basisset_->molecule());
+    std::vector<double> alpha = SAPGAU_exponents();
+
+    // One contracted s shell per atom, none on ghosts: the primitive coefficients are chosen so that
+    // the shell is the fitted charge density sum_k c_k (alpha_k/pi)^3/2 exp(-alpha_k r^2) up to the
+    // contraction normalization
+    std::map<std::string, std::map<std::string, std::vector<ShellInfo>>> shell_map;
+    std::map<std::string, std::map<std::string, std::vector<ShellInfo>>> ecp_shell_map;
+    std::map<int, std::vector<double>> fits;
+    for (int A = 0; A < mol->natom(); A++) {
+        int Z = std::round(mol->Z(A));
+        std::string name = "SAPGAU-" + std::to_string(Z);
+        mol->set_basis_by_number(A, name, "SAPGAU");
+        std::vector<ShellInfo>& shells = shell_map[name][mol->label(A)];
+        if (Z == 0 || !shells.empty()) continue;
+        if (Z > 118) throw PSIEXCEPTION("SAPGAU guess: atomic potentials are not available beyond Oganesson");
+        if (!fits.count(Z)) fits[Z] = SAPGAU_fit(Z, alpha);
+        std::vector<double> coef;
+        for (size_t k = 0; k < alpha.size(); k++) {
+            coef.push_back(fits[Z][k] * std::pow(alpha[k] / M_PI, 1.5) / std::pow(2.0 * alpha[k] / M_PI, 0.75));
+        }
+        shells.push_back(ShellInfo(0, coef, alpha, Cartesian, Unnormalized));
+    }
+    auto charges = std::make_shared<BasisSet>("SAPGAU", mol, shell_map, ecp_shell_map);
+
+    // (P|mn) holds the normalized contraction; the weight undoes the contraction normalization.
+    // Every primitive carries the same factor, so it is read off the one with the largest charge.
+    std::vector<double> weight(charges->nshell());
+    for (int P = 0; P < charges->nshell(); P++) {
+        const GaussianShell& shell = charges->shell(P);
+        int Z = std::round(mol->Z(shell.ncenter()));
+        const std::vector<double>& c = fits[Z];
+        int kmax = 0;
+        for (size_t k = 1; k < c.size(); k++) {
+            if (std::fabs(c[k]) > std::fabs(c[kmax])) kmax = k;
+        }
+        weight[P] = c[kmax] * std::pow(alpha[kmax] / M_PI, 1.5) / shell.coef(kmax);
+    }
+
+    int nthread = Process::environment.get_n_threads();
+    auto zero = BasisSet::zero_ao_basis_set();
+    auto factory = std::make_shared<IntegralFactory>(charges, zero, basisset_, basisset_);
+    std::vector<std::shared_ptr<TwoBodyAOInt>> eri;
+    for (int thread = 0; thread < nthread; thread++) eri.push_back(std::shared_ptr<TwoBodyAOInt>(factory->eri()));
+
+    // => Schwarz Bounds <= //
+
+    // |(P|mn)| <= sqrt((P|P)) sqrt((mn|mn)); the charge side carries its weight
+    std::vector<double> Pbound(charges->nshell());
+    {
+        auto Pfactory = std::make_shared<IntegralFactory>(charges, zero, charges, zero);
+        std::shared_ptr<TwoBodyAOInt> Peri(Pfactory->eri());
+        const double* Pbuffer = Peri->buffer();
+        for (int P = 0; P < charges->nshell(); P++) {
+            Peri->compute_shell(P, 0, P, 0);
+            Pbound[P] = std::fabs(weight[P]) * std::sqrt(std::fabs(Pbuffer[0]));
+        }
+    }
+    double Pmax = 0.0;
+    for (double bound : Pbound) Pmax = std::max(Pmax, bound);
+    auto sieve = std::make_shared<ERISieve>(basisset_, integral_threshold_);
+
+    auto Vao = std::make_shared<Matrix>("SAP Screening (AO)", basisset_->nbf(), basisset_->nbf());
+    double** Vp = Vao->pointer();
+
+    // Each thread owns the (M,N) and (N,M) blocks of its M
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (int M = 0; M < basisset_->nshell(); M++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        const double* buffer = eri[thread]->buffer();
+        int nm = basisset_->shell(M).nfunction();
+        int sm = basisset_->shell(M).function_index();
+        for (int N = 0; N <= M; N++) {
+            double MNbound = std::sqrt(sieve->shell_pair_value(M, N));
+            if (MNbound * Pmax < integral_threshold_) continue;
+            int nn = basisset_->shell(N).nfunction();
+            int sn = basisset_->shell(N).function_index();
+            for (int P = 0; P < charges->nshell(); P++) {
+                if (MNbound * Pbound[P] < integral_threshold_) continue;
+                eri[thread]->compute_shell(P, 0, M, N);
+                for (int om = 0; om < nm; om++) {
+                    for (int on = 0; on < nn; on++) {
+                        Vp[sm + om][sn + on] += weight[P] * buffer[om * nn + on];
+                    }
+                }
+            }
+            if (N == M) continue;
+            for (int om = 0; om < nm; om++) {
+                for (int on = 0; on < nn; on++) {
+                    Vp[sn + on][sm + om] = Vp[sm + om][sn + on];
+                }
+            }
+        }
+    }
+
+    // The -Z/r of every nucleus is already in H
+    auto Vsap = std::make_shared<Matrix>("SAP Screening", AO2SO_->colspi(), AO2SO_->colspi());
+    Vsap->apply_symmetry(Vao, AO2SO_);
+    Fa_->copy(H_);
+    Fa_->add(Vsap);
+    Fb_->copy(Fa_);
+}
+
+}  // namespace scf
+}  // namespace psi
@@ -149,6 +149,7 @@ double UStab::compute_energy() {
     H->set_debug(debug_);
     H->set_bench(bench_);
     H->set_exact_diagonal(options_.get_bool("SOLVER_EXACT_DIAGONAL"));
+    H->set_product_cutoff(options_.get_double("SOLVER_PRODUCT_CUTOFF"));
     solver->set_convergence(convergence_);
 
     // Initialization/Memory
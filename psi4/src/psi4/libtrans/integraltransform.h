@@ -30,6 +30,7 @@
 #define _PSI_SRC_LIB_LIBTRANS_INTEGRALTRANSFORM_H_
 
 #include <array>
+#include <functional>
 #include <map>
 #include <vector>
 #include <string>
@@ -255,6 +256,12 @@ class PSI_API IntegralTransform {
     void trans_one(int m, int n, double *input, double *output, double **C, int soOffset, int *order,
                    bool backtransform = false, double scale = 0.0);
 
+    void transform_tei_ket(dpdbuf4 *J, dpdbuf4 *K, int h, const SharedMatrix &CR, const SharedMatrix &CS,
+                           const int *RPI, const int *SPI,
+                           const std::function<void(double **, size_t, int)> &bucket_done = nullptr);
+    void transform_tei_ket_rows(double **Jrows, double **Krows, int nrows, const dpdbuf4 *J, const dpdbuf4 *K, int h,
+                                const SharedMatrix &CR, const SharedMatrix &CS, const int *RPI, const int *SPI);
+
     // Has this instance been initialized yet?
     bool initialized_;
 
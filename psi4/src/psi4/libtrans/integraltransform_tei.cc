@@ -31,9 +31,15 @@
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libqt/qt.h"
+#include "psi4/libdpd/dpd.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include <algorithm>
 #include <cmath>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <thread>
 #include "psi4/psifiles.h"
 #include "mospace.h"
 
@@ -61,3 +67,160 @@ void IntegralTransform::transform_tei(const std::shared_ptr<MOSpace> s1, const s
     }
     transform_tei_second_half(s1, s2, s3, s4);
 }
+
+/**
+ * Transform the ket of one irrep of a buf4, (pq|rs) -> (pq|RS), with all threads
+ * working on the rows of J in core.  The first quarter transformation is done a row
+ * at a time; the second is one GEMM over a batch of rows, which keeps it efficient
+ * even when the irreps are small.
+ *
+ * @param Jrows - the rows of J to transform
+ * @param Krows - the corresponding rows of K
+ * @param nrows - the number of rows
+ * @param J - the buf4 holding the rows of J
+ * @param K - the buf4 holding the rows of K
+ * @param h - the irrep of the rows
+ * @param CR - the coefficients for the third index
+ * @param CS - the coefficients for the fourth index
+ * @param RPI - the number of orbitals per irrep for the third index
+ * @param SPI - the number of orbitals per irrep for the fourth index
+ */
+void IntegralTransform::transform_tei_ket_rows(double **Jrows, double **Krows, int nrows, const dpdbuf4 *J,
+                                               const dpdbuf4 *K, int h, const SharedMatrix &CR, const SharedMatrix &CS,
+                                               const int *RPI, const int *SPI) {
+    const int batch = 32;
+
+#pragma omp parallel
+    {
+        std::vector<double> X, Y;
+
+#pragma omp for schedule(dynamic)
+        for (int first = 0; first < nrows; first += batch) {
+            int nb = std::min(batch, nrows - first);
+            for (int Gr = 0; Gr < nirreps_; Gr++) {
+                int Gs = h ^ Gr;
+                int nr = sopi_[Gr];
+                int ns = sopi_[Gs];
+                int nR = RPI[Gr];
+                int nS = SPI[Gs];
+                if (!nr || !ns || !nR || !nS) continue;
+                int ldx = nb * nS;
+                X.resize(static_cast<size_t>(nr) * ldx);
+                Y.resize(static_cast<size_t>(nR) * ldx);
+
+                // ( n n | n n ) -> ( n n | n S ), row pq goes to columns pq*nS of X
+                double **pCS = CS->pointer(Gs);
+                for (int pq = 0; pq < nb; pq++)
+                    C_DGEMM('n', 'n', nr, nS, ns, 1.0, &Jrows[first + pq][J->col_offset[h][Gr]], ns, pCS[0], nS, 0.0,
+                            &X[static_cast<size_t>(pq) * nS], ldx);
+
+                // ( n n | n S ) -> ( n n | R S ) for the whole batch
+                double **pCR = CR->pointer(Gr);
+                C_DGEMM('t', 'n', nR, ldx, nr, 1.0, pCR[0], nR, X.data(), ldx, 0.0, Y.data(), ldx);
+
+                int rs = K->col_offset[h][Gr];
+                for (int pq = 0; pq < nb; pq++)
+                    for (int R = 0; R < nR; R++)
+                        ::memcpy(&Krows[first + pq][rs + R * nS], &Y[static_cast<size_t>(R) * ldx + pq * nS],
+                                 sizeof(double) * nS);
+            } /* Gr */
+        }     /* pq batches */
+    }
+}
+
+/**
+ * Transform the ket of one irrep of J into K, reading J from and writing K to disk in
+ * buckets of rows.  When the irrep does not fit in core, two buckets each of J and K
+ * are held, so that a helper thread can write the previous bucket of K and read the
+ * next bucket of J while the current one is transformed.  The helper is the only
+ * thread that calls into libdpd and libpsio until it is joined.
+ *
+ * @param J - the buf4 to transform, with its file open
+ * @param K - the buf4 to write, with its file open
+ * @param h - the irrep to transform
+ * @param CR - the coefficients for the third index
+ * @param CS - the coefficients for the fourth index
+ * @param RPI - the number of orbitals per irrep for the third index
+ * @param SPI - the number of orbitals per irrep for the fourth index
+ * @param bucket_done - if given, called on the main thread with each finished bucket of K,
+ *                      its first row and its number of rows, before it is written
+ */
+void IntegralTransform::transform_tei_ket(dpdbuf4 *J, dpdbuf4 *K, int h, const SharedMatrix &CR,
+                                          const SharedMatrix &CS, const int *RPI, const int *SPI,
+                                          const std::function<void(double **, size_t, int)> &bucket_done) {
+    size_t rowtot = J->params->rowtot[h];
+    size_t Jcols = J->params->coltot[h];
+    size_t Kcols = K->params->coltot[h];
+    size_t rowsPerBucket = 0;
+    size_t memFree = 0;
+    int nBuckets = 0;
+    bool stream = false;
+
+    if (Jcols && rowtot) {
+        memFree = static_cast<size_t>(dpd_memfree() - Jcols - Kcols);
+        rowsPerBucket = memFree / (2 * Jcols);
+        if (rowsPerBucket < rowtot && memFree / (4 * Jcols) > 0) {
+            rowsPerBucket = memFree / (4 * Jcols);
+            stream = true;
+        }
+        if (rowsPerBucket > rowtot) rowsPerBucket = rowtot;
+        nBuckets = static_cast<int>(ceil(static_cast<double>(rowtot) / static_cast<double>(rowsPerBucket)));
+    }
+
+    if (print_ > 1) {
+        outfile->Printf("\th = %d; memfree         = %lu\n", h, memFree);
+        outfile->Printf("\th = %d; rows_per_bucket = %lu\n", h, rowsPerBucket);
+        outfile->Printf("\th = %d; rows_left       = %lu\n", h, rowsPerBucket ? rowtot % rowsPerBucket : 0);
+        outfile->Printf("\th = %d; nbuckets        = %d\n", h, nBuckets);
+    }
+
+    global_dpd_->buf4_mat_irrep_init_block(J, h, rowsPerBucket);
+    global_dpd_->buf4_mat_irrep_init_block(K, h, rowsPerBucket);
+    double **Jbuf[2] = {J->matrix[h], nullptr};
+    double **Kbuf[2] = {K->matrix[h], nullptr};
+    if (stream) {
+        Jbuf[1] = global_dpd_->dpd_block_matrix(rowsPerBucket, Jcols);
+        Kbuf[1] = global_dpd_->dpd_block_matrix(rowsPerBucket, Kcols);
+    }
+
+    auto bucket_rows = [&](int n) { return static_cast<int>(std::min(rowsPerBucket, rowtot - n * rowsPerBucket)); };
+    auto read_bucket = [&](int n, int b) {
+        J->matrix[h] = Jbuf[b];
+        global_dpd_->buf4_mat_irrep_rd_block(J, h, n * rowsPerBucket, bucket_rows(n));
+    };
+    auto write_bucket = [&](int n, int b) {
+        K->matrix[h] = Kbuf[b];
+        global_dpd_->buf4_mat_irrep_wrt_block(K, h, n * rowsPerBucket, bucket_rows(n));
+    };
+
+    if (nBuckets) read_bucket(0, 0);
+    for (int n = 0; n < nBuckets; n++) {
+        int b = stream ? n % 2 : 0;
+        std::thread io;
+        if (stream) {
+            io = std::thread([&, n, b]() {
+                if (n > 0) write_bucket(n - 1, 1 - b);
+                if (n + 1 < nBuckets) read_bucket(n + 1, 1 - b);
+            });
+        }
+
+        transform_tei_ket_rows(Jbuf[b], Kbuf[b], bucket_rows(n), J, K, h, CR, CS, RPI, SPI);
+
+        if (io.joinable()) io.join();
+        if (bucket_done) bucket_done(Kbuf[b], n * rowsPerBucket, bucket_rows(n));
+        if (!stream) {
+            write_bucket(n, 0);
+            if (n + 1 < nBuckets) read_bucket(n + 1, 0);
+        }
+    }
+    if (stream) write_bucket(nBuckets - 1, (nBuckets - 1) % 2);
+
+    J->matrix[h] = Jbuf[0];
+    K->matrix[h] = Kbuf[0];
+    if (stream) {
+        global_dpd_->free_dpd_block(Jbuf[1], rowsPerBucket, Jcols);
+        global_dpd_->free_dpd_block(Kbuf[1], rowsPerBucket, Kcols);
+    }
+    global_dpd_->buf4_mat_irrep_close_block(J, h, rowsPerBucket);
+    global_dpd_->buf4_mat_irrep_close_block(K, h, rowsPerBucket);
+}
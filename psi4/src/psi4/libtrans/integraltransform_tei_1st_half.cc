@@ -67,14 +67,6 @@ void IntegralTransform::transform_tei_first_half(const std::shared_ptr<MOSpace>
     int currentActiveDPD = psi::dpd_default;
     dpd_set_default(myDPDNum_);
 
-    int nBuckets;
-    int thisBucketRows;
-    size_t rowsPerBucket;
-    size_t rowsLeft;
-    size_t memFree;
-
-    double **TMP = block_matrix(nso_, nso_);
-
     /*** AA/AB two-electron integral transformation ***/
 
     if (print_) {
@@ -101,67 +93,8 @@ void IntegralTransform::transform_tei_first_half(const std::shared_ptr<MOSpace>
     if (print_ > 5)
         outfile->Printf("Initializing %s, in core:(%d|%d) on disk(%d|%d)\n", label, braCore, ketCore, braDisk, ketDisk);
 
-    for (int h = 0; h < nirreps_; h++) {
-        if (J.params->coltot[h] && J.params->rowtot[h]) {
-            memFree = static_cast<size_t>(dpd_memfree() - J.params->coltot[h] - K.params->coltot[h]);
-            rowsPerBucket = memFree / (2 * J.params->coltot[h]);
-            if (rowsPerBucket > J.params->rowtot[h]) rowsPerBucket = (size_t)J.params->rowtot[h];
-            nBuckets =
-                static_cast<int>(ceil(static_cast<double>(J.params->rowtot[h]) / static_cast<double>(rowsPerBucket)));
-            rowsLeft = static_cast<size_t>(J.params->rowtot[h] % rowsPerBucket);
-        } else {
-            nBuckets = 0;
-            rowsPerBucket = 0;
-            rowsLeft = 0;
-        }
-
-        if (print_ > 1) {
-            outfile->Printf("\th = %d; memfree         = %lu\n", h, memFree);
-            outfile->Printf("\th = %d; rows_per_bucket = %lu\n", h, rowsPerBucket);
-            outfile->Printf("\th = %d; rows_left       = %lu\n", h, rowsLeft);
-            outfile->Printf("\th = %d; nbuckets        = %d\n", h, nBuckets);
-        }
-
-        global_dpd_->buf4_mat_irrep_init_block(&J, h, rowsPerBucket);
-        global_dpd_->buf4_mat_irrep_init_block(&K, h, rowsPerBucket);
-
-        for (int n = 0; n < nBuckets; n++) {
-            if (nBuckets == 1)
-                thisBucketRows = rowsPerBucket;
-            else
-                thisBucketRows = (n < nBuckets - 1) ? rowsPerBucket : rowsLeft;
-            global_dpd_->buf4_mat_irrep_rd_block(&J, h, n * rowsPerBucket, thisBucketRows);
-            for (int pq = 0; pq < thisBucketRows; pq++) {
-                for (int Gr = 0; Gr < nirreps_; Gr++) {
-                    // Transform ( n n | n n ) -> ( n n | n S2 )
-                    int Gs = h ^ Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = aOrbsPI2[Gs];
-                    int nlinks = sopi_[Gs];
-                    int rs = J.col_offset[h][Gr];
-                    double **pc2a = c2a->pointer(Gs);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc2a[0], ncols, 0.0,
-                                TMP[0], nso_);
-                    // TODO else if s1->label() == MOSPACE_NIL, copy buffer...
-
-                    // Transform ( n n | n S2 ) -> ( n n | S1 S2 )
-                    nrows = aOrbsPI1[Gr];
-                    ncols = aOrbsPI2[Gs];
-                    nlinks = sopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    double **pc1a = c1a->pointer(Gr);
-                    if (nrows && ncols && nlinks)
-                        C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc1a[0], nrows, TMP[0], nso_, 0.0,
-                                &K.matrix[h][pq][rs], ncols);
-                    // TODO else if s2->label() == MOSPACE_NIL, copy buffer...
-                } /* Gr */
-            }     /* pq */
-            global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
-        }
-        global_dpd_->buf4_mat_irrep_close_block(&J, h, rowsPerBucket);
-        global_dpd_->buf4_mat_irrep_close_block(&K, h, rowsPerBucket);
-    }
+    for (int h = 0; h < nirreps_; h++)
+        transform_tei_ket(&J, &K, h, c1a, c2a, aOrbsPI1, aOrbsPI2);
     global_dpd_->buf4_close(&K);
     global_dpd_->buf4_close(&J);
 
@@ -209,67 +142,8 @@ void IntegralTransform::transform_tei_first_half(const std::shared_ptr<MOSpace>
             outfile->Printf("Initializing %s, in core:(%d|%d) on disk(%d|%d)\n", label, braCore, ketCore, braDisk,
                             ketDisk);
 
-        for (int h = 0; h < nirreps_; h++) {
-            if (J.params->coltot[h] && J.params->rowtot[h]) {
-                memFree = static_cast<size_t>(dpd_memfree() - J.params->coltot[h] - K.params->coltot[h]);
-                rowsPerBucket = memFree / (2 * J.params->coltot[h]);
-                if (rowsPerBucket > J.params->rowtot[h]) rowsPerBucket = static_cast<size_t>(J.params->rowtot[h]);
-                nBuckets = static_cast<int>(
-                    ceil(static_cast<double>(J.params->rowtot[h]) / static_cast<double>(rowsPerBucket)));
-                rowsLeft = static_cast<size_t>(J.params->rowtot[h] % rowsPerBucket);
-            } else {
-                nBuckets = 0;
-                rowsPerBucket = 0;
-                rowsLeft = 0;
-            }
-
-            if (print_ > 1) {
-                outfile->Printf("\th = %d; memfree         = %lu\n", h, memFree);
-                outfile->Printf("\th = %d; rows_per_bucket = %lu\n", h, rowsPerBucket);
-                outfile->Printf("\th = %d; rows_left       = %lu\n", h, rowsLeft);
-                outfile->Printf("\th = %d; nbuckets        = %d\n", h, nBuckets);
-            }
-
-            global_dpd_->buf4_mat_irrep_init_block(&J, h, rowsPerBucket);
-            global_dpd_->buf4_mat_irrep_init_block(&K, h, rowsPerBucket);
-
-            for (int n = 0; n < nBuckets; n++) {
-                if (nBuckets == 1)
-                    thisBucketRows = rowsPerBucket;
-                else
-                    thisBucketRows = (n < nBuckets - 1) ? rowsPerBucket : rowsLeft;
-                global_dpd_->buf4_mat_irrep_rd_block(&J, h, n * rowsPerBucket, thisBucketRows);
-                for (int pq = 0; pq < thisBucketRows; pq++) {
-                    for (int Gr = 0; Gr < nirreps_; Gr++) {
-                        // Transform ( n n | n n ) -> ( n n | n s2 )
-                        int Gs = h ^ Gr;
-                        int nrows = sopi_[Gr];
-                        int ncols = bOrbsPI2[Gs];
-                        int nlinks = sopi_[Gs];
-                        int rs = J.col_offset[h][Gr];
-                        double **pc2b = c2b->pointer(Gs);
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs], nlinks, pc2b[0], ncols,
-                                    0.0, TMP[0], nso_);
-                        // TODO else if s2->label() == MOSPACE_NIL, copy buffer...
-
-                        // Transform ( n n | n s2 ) -> ( n n | s1 s2 )
-                        nrows = bOrbsPI1[Gr];
-                        ncols = bOrbsPI2[Gs];
-                        nlinks = sopi_[Gr];
-                        rs = K.col_offset[h][Gr];
-                        double **pc1b = c1b->pointer(Gr);
-                        if (nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc1b[0], nrows, TMP[0], nso_, 0.0,
-                                    &K.matrix[h][pq][rs], ncols);
-                        // TODO else if s1->label() == MOSPACE_NIL, copy buffer...
-                    } /* Gr */
-                }     /* pq */
-                global_dpd_->buf4_mat_irrep_wrt_block(&K, h, n * rowsPerBucket, thisBucketRows);
-            }
-            global_dpd_->buf4_mat_irrep_close_block(&J, h, rowsPerBucket);
-            global_dpd_->buf4_mat_irrep_close_block(&K, h, rowsPerBucket);
-        }
+        for (int h = 0; h < nirreps_; h++)
+            transform_tei_ket(&J, &K, h, c1b, c2b, bOrbsPI1, bOrbsPI2);
         global_dpd_->buf4_close(&K);
         global_dpd_->buf4_close(&J);
 
@@ -299,7 +173,6 @@ void IntegralTransform::transform_tei_first_half(const std::shared_ptr<MOSpace>
 
     psio_->close(PSIF_SO_PRESORT, keepDpdSoInts_);
 
-    free_block(TMP);
     delete[] label;
 
     if (print_) {
@@ -28,6 +28,9 @@
 
 #include "jk_grad.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "psi4/libqt/qt.h"
 #include "psi4/lib3index/3index.h"
 #include "psi4/libpsio/psio.hpp"
@@ -689,8 +692,9 @@ void DFJKGrad::build_AB_inv_terms()
     if (!(do_K_ || do_wK_))
         return;
 
+    // The metric stays in core; the (A|ij) columns stream through what is left
     int max_cols;
-    size_t effective_memory = memory_ - 1L * naux * naux;
+    size_t effective_memory = (memory_ > 1L * naux * naux ? memory_ - 1L * naux * naux : 0L);
     size_t col_cost = 2L * naux;
     size_t cols = effective_memory / col_cost;
     cols = (cols > na * (size_t) na ? na * (size_t) na : cols);
@@ -765,9 +769,9 @@ void DFJKGrad::build_UV_terms()
     // => Memory Constraints <= //
 
     int max_rows;
-    size_t effective_memory = memory_ - 1L * naux * naux;
+    size_t effective_memory = (memory_ > 1L * naux * naux ? memory_ - 1L * naux * naux : 0L);
     size_t row_cost = 2L * na * (size_t) na;
-    size_t rows = memory_ / row_cost;
+    size_t rows = effective_memory / row_cost;
     rows = (rows > naux ? naux : rows);
     rows = (rows < 1L ? 1L : rows);
     max_rows = (int) rows;
@@ -1014,6 +1018,53 @@ void DFJKGrad::build_Amn_x_terms()
         }
     }
 
+    // => Density Screening <= //
+
+    // (P|MN)^x is skipped when the Schwarz bound sqrt((P|P)(MN|MN)) times the largest density
+    // element it is contracted with falls below the cutoff
+
+    std::vector<double> Pbound(auxiliary_->nshell(), 0.0);
+    {
+        auto metricfactory = std::make_shared<IntegralFactory>(auxiliary_, BasisSet::zero_ao_basis_set(),
+                                                               auxiliary_, BasisSet::zero_ao_basis_set());
+        std::shared_ptr<TwoBodyAOInt> metric_eri(metricfactory->eri());
+        const double* buffer = metric_eri->buffer();
+        for (int P = 0; P < auxiliary_->nshell(); P++) {
+            metric_eri->compute_shell(P, 0, P, 0);
+            int nP = auxiliary_->shell(P).nfunction();
+            for (int p = 0; p < nP; p++) {
+                Pbound[P] = std::max(Pbound[P], std::sqrt(std::fabs(buffer[p * nP + p])));
+            }
+        }
+    }
+
+    std::vector<double> MNbound(npairs);
+    std::vector<double> MNdensity(npairs, 0.0);
+    for (int MN = 0; MN < npairs; MN++) {
+        int M = shell_pairs[MN].first;
+        int N = shell_pairs[MN].second;
+        MNbound[MN] = std::sqrt(sieve_->shell_pair_value(M, N));
+        if (do_J_) {
+            int oM = primary_->shell(M).function_index();
+            int oN = primary_->shell(N).function_index();
+            for (int m = 0; m < primary_->shell(M).nfunction(); m++) {
+                for (int n = 0; n < primary_->shell(N).nfunction(); n++) {
+                    MNdensity[MN] = std::max(MNdensity[MN], std::fabs(Dtp[m + oM][n + oN]));
+                }
+            }
+        }
+    }
+
+    std::vector<double> Pdensity(auxiliary_->nshell(), 0.0);
+    if (do_J_) {
+        for (int P = 0; P < auxiliary_->nshell(); P++) {
+            int oP = auxiliary_->shell(P).function_index();
+            for (int p = 0; p < auxiliary_->shell(P).nfunction(); p++) {
+                Pdensity[P] = std::max(Pdensity[P], std::fabs(dp[p + oP]));
+            }
+        }
+    }
+
     // => R/U doubling factor <= //
 
     double factor = (restricted ? 2.0 : 1.0);
@@ -1099,10 +1150,6 @@ void DFJKGrad::build_Amn_x_terms()
             int M = shell_pairs[MN].first;
             int N = shell_pairs[MN].second;
 
-            eri[thread]->compute_shell_deriv1(P,0,M,N);
-
-            const double* buffer = eri[thread]->buffer();
-
             int nP = auxiliary_->shell(P).nfunction();
             int cP = auxiliary_->shell(P).ncartesian();
             int aP = auxiliary_->shell(P).ncenter();
@@ -1118,6 +1165,23 @@ void DFJKGrad::build_Amn_x_terms()
             int aN = primary_->shell(N).ncenter();
             int oN = primary_->shell(N).function_index();
 
+            // > Density screening < //
+            double density = Pdensity[P] * MNdensity[MN];
+            for (int p = 0; p < nP && (do_K_ || do_wK_); p++) {
+                for (int m = 0; m < nM; m++) {
+                    const double* Krow = &Kmnp[p + oP][(m + oM) * nso + oN];
+                    for (int n = 0; n < nN; n++) density = std::max(density, std::fabs(Krow[n]));
+                    if (!do_wK_) continue;
+                    const double* wKrow = &wKmnp[p + oP][(m + oM) * nso + oN];
+                    for (int n = 0; n < nN; n++) density = std::max(density, 0.5 * std::fabs(wKrow[n]));
+                }
+            }
+            if (Pbound[P] * MNbound[MN] * density < cutoff_) continue;
+
+            eri[thread]->compute_shell_deriv1(P,0,M,N);
+
+            const double* buffer = eri[thread]->buffer();
+
             int ncart = cP * cM * cN;
             const double *Px = buffer + 0*ncart;
             const double *Py = buffer + 1*ncart;
@@ -1131,19 +1195,11 @@ void DFJKGrad::build_Amn_x_terms()
 
             double perm = (M == N ? 1.0 : 2.0);
 
-            double** grad_Jp;
-            double** grad_Kp;
-            double** grad_wKp;
-
-            if (do_J_) {
-                grad_Jp = Jtemps[thread]->pointer();
-            }
-            if (do_K_) {
-                grad_Kp = Ktemps[thread]->pointer();
-            }
-            if (do_wK_) {
-                grad_wKp = wKtemps[thread]->pointer();
-            }
+            // Contributions of this shell triplet to its three centers, P x y z, M x y z, N x y z;
+            // they go into the thread's gradient once the triplet is done
+            double grad_J[9] = {0.0};
+            double grad_K[9] = {0.0};
+            double grad_wK[9] = {0.0};
 
             for (int p = 0; p < nP; p++) {
                 for (int m = 0; m < nM; m++) {
@@ -1152,45 +1208,45 @@ void DFJKGrad::build_Amn_x_terms()
                         //  J^x = (A|pq)^x d_A Dt_pq
                         if (do_J_) {
                             double Ival = 1.0 * perm * dp[p + oP + pstart] * Dtp[m + oM][n + oN];
-                            grad_Jp[aP][0] += Ival * (*Px);
-                            grad_Jp[aP][1] += Ival * (*Py);
-                            grad_Jp[aP][2] += Ival * (*Pz);
-                            grad_Jp[aM][0] += Ival * (*Mx);
-                            grad_Jp[aM][1] += Ival * (*My);
-                            grad_Jp[aM][2] += Ival * (*Mz);
-                            grad_Jp[aN][0] += Ival * (*Nx);
-                            grad_Jp[aN][1] += Ival * (*Ny);
-                            grad_Jp[aN][2] += Ival * (*Nz);
+                            grad_J[0] += Ival * (*Px);
+                            grad_J[1] += Ival * (*Py);
+                            grad_J[2] += Ival * (*Pz);
+                            grad_J[3] += Ival * (*Mx);
+                            grad_J[4] += Ival * (*My);
+                            grad_J[5] += Ival * (*Mz);
+                            grad_J[6] += Ival * (*Nx);
+                            grad_J[7] += Ival * (*Ny);
+                            grad_J[8] += Ival * (*Nz);
                         }
 
 
                         //  K^x = (A|pq)^x (A|pq)
                         if (do_K_) {
                             double Kval = 1.0 * perm * Kmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_Kp[aP][0] += Kval * (*Px);
-                            grad_Kp[aP][1] += Kval * (*Py);
-                            grad_Kp[aP][2] += Kval * (*Pz);
-                            grad_Kp[aM][0] += Kval * (*Mx);
-                            grad_Kp[aM][1] += Kval * (*My);
-                            grad_Kp[aM][2] += Kval * (*Mz);
-                            grad_Kp[aN][0] += Kval * (*Nx);
-                            grad_Kp[aN][1] += Kval * (*Ny);
-                            grad_Kp[aN][2] += Kval * (*Nz);
+                            grad_K[0] += Kval * (*Px);
+                            grad_K[1] += Kval * (*Py);
+                            grad_K[2] += Kval * (*Pz);
+                            grad_K[3] += Kval * (*Mx);
+                            grad_K[4] += Kval * (*My);
+                            grad_K[5] += Kval * (*Mz);
+                            grad_K[6] += Kval * (*Nx);
+                            grad_K[7] += Kval * (*Ny);
+                            grad_K[8] += Kval * (*Nz);
                         }
 
 
                         // wK^x = 0.5 * (A|pq)^x (A|w|pq)
                         if (do_wK_) {
                             double wKval = 0.5 * perm * wKmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_wKp[aP][0] += wKval * (*Px);
-                            grad_wKp[aP][1] += wKval * (*Py);
-                            grad_wKp[aP][2] += wKval * (*Pz);
-                            grad_wKp[aM][0] += wKval * (*Mx);
-                            grad_wKp[aM][1] += wKval * (*My);
-                            grad_wKp[aM][2] += wKval * (*Mz);
-                            grad_wKp[aN][0] += wKval * (*Nx);
-                            grad_wKp[aN][1] += wKval * (*Ny);
-                            grad_wKp[aN][2] += wKval * (*Nz);
+                            grad_wK[0] += wKval * (*Px);
+                            grad_wK[1] += wKval * (*Py);
+                            grad_wK[2] += wKval * (*Pz);
+                            grad_wK[3] += wKval * (*Mx);
+                            grad_wK[4] += wKval * (*My);
+                            grad_wK[5] += wKval * (*Mz);
+                            grad_wK[6] += wKval * (*Nx);
+                            grad_wK[7] += wKval * (*Ny);
+                            grad_wK[8] += wKval * (*Nz);
                         }
 
                         Px++;
@@ -1226,15 +1282,15 @@ void DFJKGrad::build_Amn_x_terms()
                     for (int m = 0; m < nM; m++) {
                         for (int n = 0; n < nN; n++) {
                             double wKval = 0.5 * perm * Kmnp[p + oP][(m + oM) * nso + (n + oN)];
-                            grad_wKp[aP][0] += wKval * (*Px);
-                            grad_wKp[aP][1] += wKval * (*Py);
-                            grad_wKp[aP][2] += wKval * (*Pz);
-                            grad_wKp[aM][0] += wKval * (*Mx);
-                            grad_wKp[aM][1] += wKval * (*My);
-                            grad_wKp[aM][2] += wKval * (*Mz);
-                            grad_wKp[aN][0] += wKval * (*Nx);
-                            grad_wKp[aN][1] += wKval * (*Ny);
-                            grad_wKp[aN][2] += wKval * (*Nz);
+                            grad_wK[0] += wKval * (*Px);
+                            grad_wK[1] += wKval * (*Py);
+                            grad_wK[2] += wKval * (*Pz);
+                            grad_wK[3] += wKval * (*Mx);
+                            grad_wK[4] += wKval * (*My);
+                            grad_wK[5] += wKval * (*Mz);
+                            grad_wK[6] += wKval * (*Nx);
+                            grad_wK[7] += wKval * (*Ny);
+                            grad_wK[8] += wKval * (*Nz);
                             Px++;
                             Py++;
                             Pz++;
@@ -1250,6 +1306,21 @@ void DFJKGrad::build_Amn_x_terms()
                 }
 
             }
+
+            // > Accumulate < //
+            const int centers[3] = {aP, aM, aN};
+            if (do_J_) {
+                double** grad_Jp = Jtemps[thread]->pointer();
+                for (int c = 0; c < 9; c++) grad_Jp[centers[c / 3]][c % 3] += grad_J[c];
+            }
+            if (do_K_) {
+                double** grad_Kp = Ktemps[thread]->pointer();
+                for (int c = 0; c < 9; c++) grad_Kp[centers[c / 3]][c % 3] += grad_K[c];
+            }
+            if (do_wK_) {
+                double** grad_wKp = wKtemps[thread]->pointer();
+                for (int c = 0; c < 9; c++) grad_wKp[centers[c / 3]][c % 3] += grad_wK[c];
+            }
         }
     }
 
@@ -2285,7 +2356,7 @@ void DirectJKGrad::compute_gradient()
         for (int thread = 0; thread < ints_num_threads_; thread++) {
             ints.push_back(std::shared_ptr<TwoBodyAOInt>(factory->eri(1)));
         }
-        std::map<std::string, std::shared_ptr<Matrix> > vals = compute1(ints);
+        std::map<std::string, std::shared_ptr<Matrix> > vals = compute1(ints, do_J_, do_K_);
         if (do_J_) {
             gradients_["Coulomb"]->copy(vals["J"]);
             // gradients_["Coulomb"]->print();
@@ -2300,16 +2371,17 @@ void DirectJKGrad::compute_gradient()
         for (int thread = 0; thread < ints_num_threads_; thread++) {
             ints.push_back(std::shared_ptr<TwoBodyAOInt>(factory->erf_eri(omega_,1)));
         }
-        std::map<std::string, std::shared_ptr<Matrix> > vals = compute1(ints);
+        std::map<std::string, std::shared_ptr<Matrix> > vals = compute1(ints, false, true);
         gradients_["Exchange,LR"]->copy(vals["K"]);
         // gradients_["Exchange,LR"]->print();
     }
 }
-std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute1(std::vector<std::shared_ptr<TwoBodyAOInt> >& ints)
+std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute1(std::vector<std::shared_ptr<TwoBodyAOInt> >& ints, bool do_J, bool do_K)
 {
     int nthreads = ints.size();
 
     int natom = primary_->molecule()->natom();
+    int nshell = primary_->nshell();
 
     std::vector<std::shared_ptr<Matrix> > Jgrad;
     std::vector<std::shared_ptr<Matrix> > Kgrad;
@@ -2318,179 +2390,165 @@ std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute1(std::vect
         Kgrad.push_back(std::make_shared<Matrix>("KGrad",natom,3));
     }
 
-    const std::vector<std::pair<int, int> >& shell_pairs = sieve_->shell_pairs();
-    size_t npairs = shell_pairs.size();
-    size_t npairs2 = npairs * npairs;
-
     double** Dtp = Dt_->pointer();
     double** Dap = Da_->pointer();
     double** Dbp = Db_->pointer();
 
-#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
-    for (size_t index = 0L; index < npairs2; index++) {
-
-        size_t PQ = index / npairs;
-        size_t RS = index % npairs;
+    // => Density Bounds <= //
+
+    // Largest |D| in each shell pair block: Dt for J, Da/Db for K
+    std::vector<double> Jmax(static_cast<size_t>(nshell) * nshell, 0.0);
+    std::vector<double> Kmax(static_cast<size_t>(nshell) * nshell, 0.0);
+    for (int M = 0; M < nshell; M++) {
+        int Moff = primary_->shell(M).function_index();
+        int Msize = primary_->shell(M).nfunction();
+        for (int N = 0; N < nshell; N++) {
+            int Noff = primary_->shell(N).function_index();
+            int Nsize = primary_->shell(N).nfunction();
+            double Jval = 0.0;
+            double Kval = 0.0;
+            for (int m = Moff; m < Moff + Msize; m++) {
+                for (int n = Noff; n < Noff + Nsize; n++) {
+                    Jval = std::max(Jval, std::fabs(Dtp[m][n]));
+                    Kval = std::max(Kval, std::max(std::fabs(Dap[m][n]), std::fabs(Dbp[m][n])));
+                }
+            }
+            Jmax[M * static_cast<size_t>(nshell) + N] = Jval;
+            Kmax[M * static_cast<size_t>(nshell) + N] = Kval;
+        }
+    }
 
-        if (RS > PQ) continue;
+    // => Angular Momentum Batching <= //
 
-        int P = shell_pairs[PQ].first;
-        int Q = shell_pairs[PQ].second;
-        int R = shell_pairs[RS].first;
-        int S = shell_pairs[RS].second;
+    // Significant pairs ordered by angular momentum class, heaviest first, so that consecutive
+    // quartets hit the same integral kernels and the dynamic schedule hands out the big tasks early
+    std::vector<std::pair<int, int> > shell_pairs = sieve_->shell_pairs();
+    std::stable_sort(shell_pairs.begin(), shell_pairs.end(),
+                     [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                         int la = primary_->shell(a.first).am() + primary_->shell(a.second).am();
+                         int lb = primary_->shell(b.first).am() + primary_->shell(b.second).am();
+                         if (la != lb) return la > lb;
+                         return primary_->shell(a.first).am() > primary_->shell(b.first).am();
+                     });
+    size_t npairs = shell_pairs.size();
 
-        if (!sieve_->shell_significant(P,Q,R,S)) continue;
+    std::vector<double> pair_bound(npairs);
+    for (size_t PQ = 0; PQ < npairs; PQ++) {
+        pair_bound[PQ] = std::sqrt(sieve_->shell_pair_value(shell_pairs[PQ].first, shell_pairs[PQ].second));
+    }
 
-        //outfile->Printf("(%d,%d,%d,%d)\n", P,Q,R,S);
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for (size_t PQ = 0L; PQ < npairs; PQ++) {
 
         int thread = 0;
 #ifdef _OPENMP
         thread = omp_get_thread_num();
 #endif
 
-        ints[thread]->compute_shell_deriv1(P,Q,R,S);
-
         const double* buffer = ints[thread]->buffer();
-
         double** Jp = Jgrad[thread]->pointer();
         double** Kp = Kgrad[thread]->pointer();
 
+        int P = shell_pairs[PQ].first;
+        int Q = shell_pairs[PQ].second;
+
         int Psize = primary_->shell(P).nfunction();
         int Qsize = primary_->shell(Q).nfunction();
-        int Rsize = primary_->shell(R).nfunction();
-        int Ssize = primary_->shell(S).nfunction();
-
         int Pncart = primary_->shell(P).ncartesian();
         int Qncart = primary_->shell(Q).ncartesian();
-        int Rncart = primary_->shell(R).ncartesian();
-        int Sncart = primary_->shell(S).ncartesian();
-
         int Poff = primary_->shell(P).function_index();
         int Qoff = primary_->shell(Q).function_index();
-        int Roff = primary_->shell(R).function_index();
-        int Soff = primary_->shell(S).function_index();
-
         int Pcenter = primary_->shell(P).ncenter();
         int Qcenter = primary_->shell(Q).ncenter();
-        int Rcenter = primary_->shell(R).ncenter();
-        int Scenter = primary_->shell(S).ncenter();
 
-        double prefactor = 1.0;
-        if (P != Q)   prefactor *= 2.0;
-        if (R != S)   prefactor *= 2.0;
-        if (PQ != RS) prefactor *= 2.0;
+        for (size_t RS = PQ; RS < npairs; RS++) {
 
-        size_t stride = static_cast<size_t> (Pncart) * Qncart * Rncart * Sncart;
+            int R = shell_pairs[RS].first;
+            int S = shell_pairs[RS].second;
 
-        double val;
-        double Dpq, Drs;
-        size_t delta;
-        double Ax, Ay, Az;
-        double Bx, By, Bz;
-        double Cx, Cy, Cz;
-        double Dx, Dy, Dz;
+            if (!sieve_->shell_significant(P,Q,R,S)) continue;
 
-        // => Coulomb Term <= //
+            // => Density Screening <= //
 
-        Ax = 0.0; Ay = 0.0; Az = 0.0;
-        Bx = 0.0; By = 0.0; Bz = 0.0;
-        Cx = 0.0; Cy = 0.0; Cz = 0.0;
-        Dx = 0.0; Dy = 0.0; Dz = 0.0;
-        delta = 0L;
-        for (int p = 0; p < Psize; p++) {
-            for (int q = 0; q < Qsize; q++) {
-                for (int r = 0; r < Rsize; r++) {
-                    for (int s = 0; s < Ssize; s++) {
-                        Dpq = Dtp[p + Poff][q + Qoff];
-                        Drs = Dtp[r + Roff][s + Soff];
-                        val = prefactor * Dpq * Drs;
-                        Ax += val * buffer[0 * stride + delta];
-                        Ay += val * buffer[1 * stride + delta];
-                        Az += val * buffer[2 * stride + delta];
-                        Cx += val * buffer[3 * stride + delta];
-                        Cy += val * buffer[4 * stride + delta];
-                        Cz += val * buffer[5 * stride + delta];
-                        Dx += val * buffer[6 * stride + delta];
-                        Dy += val * buffer[7 * stride + delta];
-                        Dz += val * buffer[8 * stride + delta];
-                        delta++;
-                    }
-                }
+            double Dbound = 0.0;
+            if (do_J) {
+                Dbound = Jmax[P * static_cast<size_t>(nshell) + Q] * Jmax[R * static_cast<size_t>(nshell) + S];
             }
-        }
-        Bx = -(Ax + Cx + Dx);
-        By = -(Ay + Cy + Dy);
-        Bz = -(Az + Cz + Dz);
-
-        Jp[Pcenter][0] += Ax;
-        Jp[Pcenter][1] += Ay;
-        Jp[Pcenter][2] += Az;
-        Jp[Qcenter][0] += Bx;
-        Jp[Qcenter][1] += By;
-        Jp[Qcenter][2] += Bz;
-        Jp[Rcenter][0] += Cx;
-        Jp[Rcenter][1] += Cy;
-        Jp[Rcenter][2] += Cz;
-        Jp[Scenter][0] += Dx;
-        Jp[Scenter][1] += Dy;
-        Jp[Scenter][2] += Dz;
+            if (do_K) {
+                Dbound = std::max(Dbound, Kmax[P * static_cast<size_t>(nshell) + R] * Kmax[Q * static_cast<size_t>(nshell) + S] +
+                                          Kmax[P * static_cast<size_t>(nshell) + S] * Kmax[Q * static_cast<size_t>(nshell) + R]);
+            }
+            if (pair_bound[PQ] * pair_bound[RS] * Dbound < cutoff_) continue;
 
-        // => Exchange Term <= //
+            ints[thread]->compute_shell_deriv1(P,Q,R,S);
 
-        Ax = 0.0; Ay = 0.0; Az = 0.0;
-        Bx = 0.0; By = 0.0; Bz = 0.0;
-        Cx = 0.0; Cy = 0.0; Cz = 0.0;
-        Dx = 0.0; Dy = 0.0; Dz = 0.0;
-        delta = 0L;
-        for (int p = 0; p < Psize; p++) {
-            for (int q = 0; q < Qsize; q++) {
-                for (int r = 0; r < Rsize; r++) {
-                    for (int s = 0; s < Ssize; s++) {
-                        val = 0.0;
-                        Dpq = Dap[p + Poff][r + Roff];
-                        Drs = Dap[q + Qoff][s + Soff];
-                        val += prefactor * Dpq * Drs;
-                        Dpq = Dap[p + Poff][s + Soff];
-                        Drs = Dap[q + Qoff][r + Roff];
-                        val += prefactor * Dpq * Drs;
-                        Dpq = Dbp[p + Poff][r + Roff];
-                        Drs = Dbp[q + Qoff][s + Soff];
-                        val += prefactor * Dpq * Drs;
-                        Dpq = Dbp[p + Poff][s + Soff];
-                        Drs = Dbp[q + Qoff][r + Roff];
-                        val += prefactor * Dpq * Drs;
-                        val *= 0.5;
-                        Ax += val * buffer[0 * stride + delta];
-                        Ay += val * buffer[1 * stride + delta];
-                        Az += val * buffer[2 * stride + delta];
-                        Cx += val * buffer[3 * stride + delta];
-                        Cy += val * buffer[4 * stride + delta];
-                        Cz += val * buffer[5 * stride + delta];
-                        Dx += val * buffer[6 * stride + delta];
-                        Dy += val * buffer[7 * stride + delta];
-                        Dz += val * buffer[8 * stride + delta];
-                        delta++;
+            int Rsize = primary_->shell(R).nfunction();
+            int Ssize = primary_->shell(S).nfunction();
+            int Rncart = primary_->shell(R).ncartesian();
+            int Sncart = primary_->shell(S).ncartesian();
+            int Roff = primary_->shell(R).function_index();
+            int Soff = primary_->shell(S).function_index();
+            int Rcenter = primary_->shell(R).ncenter();
+            int Scenter = primary_->shell(S).ncenter();
+
+            double prefactor = 1.0;
+            if (P != Q)   prefactor *= 2.0;
+            if (R != S)   prefactor *= 2.0;
+            if (PQ != RS) prefactor *= 2.0;
+
+            size_t stride = static_cast<size_t> (Pncart) * Qncart * Rncart * Sncart;
+
+            // The buffer holds the P, R and S derivatives (Ax..Az, Cx..Cz, Dx..Dz); the Q derivative
+            // follows from translational invariance. J and K are contracted in one pass over it.
+            double grad_J[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            double grad_K[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            size_t delta = 0L;
+            for (int p = 0; p < Psize; p++) {
+                const double* Dtpp = Dtp[p + Poff];
+                const double* Dapp = Dap[p + Poff];
+                const double* Dbpp = Dbp[p + Poff];
+                for (int q = 0; q < Qsize; q++) {
+                    const double* Daqp = Dap[q + Qoff];
+                    const double* Dbqp = Dbp[q + Qoff];
+                    double Jpq = (do_J ? prefactor * Dtpp[q + Qoff] : 0.0);
+                    for (int r = 0; r < Rsize; r++) {
+                        const double* Dtrp = Dtp[r + Roff];
+                        double Dapr = Dapp[r + Roff];
+                        double Daqr = Daqp[r + Roff];
+                        double Dbpr = Dbpp[r + Roff];
+                        double Dbqr = Dbqp[r + Roff];
+                        for (int s = 0; s < Ssize; s++) {
+                            double Jval = Jpq * Dtrp[s + Soff];
+                            double Kval = 0.0;
+                            if (do_K) {
+                                Kval = 0.5 * prefactor *
+                                       (Dapr * Daqp[s + Soff] + Dapp[s + Soff] * Daqr +
+                                        Dbpr * Dbqp[s + Soff] + Dbpp[s + Soff] * Dbqr);
+                            }
+                            for (int k = 0; k < 9; k++) {
+                                double g = buffer[k * stride + delta];
+                                grad_J[k] += Jval * g;
+                                grad_K[k] += Kval * g;
+                            }
+                            delta++;
+                        }
                     }
                 }
             }
-        }
-        Bx = -(Ax + Cx + Dx);
-        By = -(Ay + Cy + Dy);
-        Bz = -(Az + Cz + Dz);
-
-        Kp[Pcenter][0] += Ax;
-        Kp[Pcenter][1] += Ay;
-        Kp[Pcenter][2] += Az;
-        Kp[Qcenter][0] += Bx;
-        Kp[Qcenter][1] += By;
-        Kp[Qcenter][2] += Bz;
-        Kp[Rcenter][0] += Cx;
-        Kp[Rcenter][1] += Cy;
-        Kp[Rcenter][2] += Cz;
-        Kp[Scenter][0] += Dx;
-        Kp[Scenter][1] += Dy;
-        Kp[Scenter][2] += Dz;
 
+            for (int xyz = 0; xyz < 3; xyz++) {
+                Jp[Pcenter][xyz] += grad_J[xyz];
+                Jp[Qcenter][xyz] -= grad_J[xyz] + grad_J[3 + xyz] + grad_J[6 + xyz];
+                Jp[Rcenter][xyz] += grad_J[3 + xyz];
+                Jp[Scenter][xyz] += grad_J[6 + xyz];
+
+                Kp[Pcenter][xyz] += grad_K[xyz];
+                Kp[Qcenter][xyz] -= grad_K[xyz] + grad_K[3 + xyz] + grad_K[6 + xyz];
+                Kp[Rcenter][xyz] += grad_K[3 + xyz];
+                Kp[Scenter][xyz] += grad_K[6 + xyz];
+            }
+        }
     }
 
     for (int thread = 1; thread < nthreads; thread++) {
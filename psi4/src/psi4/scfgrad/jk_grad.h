@@ -242,7 +242,7 @@ protected:
 
     void common_init();
 
-    std::map<std::string, std::shared_ptr<Matrix> > compute1(std::vector<std::shared_ptr<TwoBodyAOInt> >& ints);
+    std::map<std::string, std::shared_ptr<Matrix> > compute1(std::vector<std::shared_ptr<TwoBodyAOInt> >& ints, bool do_J, bool do_K);
     std::map<std::string, std::shared_ptr<Matrix> > compute2(std::vector<std::shared_ptr<TwoBodyAOInt> >& ints);
 public:
     DirectJKGrad(int deriv, std::shared_ptr<BasisSet> primary);
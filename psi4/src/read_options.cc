@@ -931,6 +931,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         additional thread. -*/
         options.add_bool("AIO_DF_INTS", false);
 
+        /*- Do read the next block of DF integrals in the SAPT0 terms while the current
+        block is being used? Each blocked read then keeps two buffers of half the size. -*/
+        options.add_bool("AIO_DF_BLOCKS", true);
+
         /*- Maximum number of CPHF iterations -*/
         options.add_int("MAXITER", 50);
         /*- Do CCD dispersion correction in SAPT2+, SAPT2+(3) or SAPT2+3? !expert -*/
@@ -1309,8 +1313,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("INTS_TOLERANCE", 0.0);
         /*- The type of guess orbitals.  Defaults to ``READ`` for geometry optimizations after the first step, to
           ``CORE`` for single atoms, and to ``SAD`` otherwise. The ``HUCKEL`` guess employs on-the-fly calculations
-          like SAD, as described in doi:10.1021/acs.jctc.8b01089 which also describes the SAP guess. -*/
-        options.add_str("GUESS", "AUTO", "AUTO CORE GWH SAD SADNO SAP HUCKEL READ");
+          like SAD, as described in doi:10.1021/acs.jctc.8b01089 which also describes the SAP guess. ``SAPGAU``
+          is the SAP guess with the atomic potentials fitted to Gaussian charges, evaluated from integrals
+          instead of on a DFT grid. -*/
+        options.add_str("GUESS", "AUTO", "AUTO CORE GWH SAD SADNO SAP SAPGAU HUCKEL READ");
         /*- Mix the HOMO/LUMO in UHF or UKS to break alpha/beta spatial symmetry.
         Useful to produce broken-symmetry unrestricted solutions.
         Notice that this procedure is defined only for calculations in C1 symmetry. -*/
@@ -1518,6 +1524,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("SAD_SPIN_AVERAGE", true);
         /*- SAD guess density decomposition threshold !expert -*/
         options.add_double("SAD_CHOL_TOLERANCE", 1E-7);
+        /*- Directory in which converged atomic SAD densities are kept and reused by later computations
+        with the same element, basis sets and SAD settings. No caching if empty. !expert -*/
+        options.add_str_i("SAD_CACHE_DIR", "");
 
         /*- SUBSECTION DFT -*/
 
@@ -1700,9 +1709,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- Solver precondition type
          -*/
         options.add_str("SOLVER_PRECONDITION", "JACOBI", "SUBSPACE JACOBI NONE");
-        /*- Solver type (for interchangeable solvers)
+        /*- Solver type (for interchangeable solvers). DAVIDSON is a block Davidson for many
+        roots (CIS/TDA) that batches the new trial vectors into as few JK builds as memory allows
+        and restarts from the Ritz vectors of twice the number of roots.
          -*/
-        options.add_str("SOLVER_TYPE", "DL", "DL RAYLEIGH");
+        options.add_str("SOLVER_TYPE", "DL", "DL RAYLEIGH DAVIDSON");
         /*- Solver precondition max steps
         -*/
         options.add_int("SOLVER_PRECONDITION_MAXITER", 1);
@@ -1715,6 +1726,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         /*- Solver exact diagonal or eigenvalue difference?
         -*/
         options.add_bool("SOLVER_EXACT_DIAGONAL", false);
+        /*- Trial vector blocks with no element above this are left out of the JK
+        builds of the CPHF and TDHF products. The default screens only blocks that are exactly zero.
+        -*/
+        options.add_double("SOLVER_PRODUCT_CUTOFF", 0.0);
     }
     if (name == "CCTRANSORT" || options.read_globals()) {
         /*- MODULEDESCRIPTION Transforms and sorts integrals for CC codes. Called before (non-density-fitted) MP2 and
@@ -1811,6 +1826,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         which means that all four-index quantities with up to two virtual-orbital
         indices (e.g., $\left\langle ij | ab \right\rangle$ integrals) may be held in the cache. -*/
         options.add_int("CACHELEVEL", 2);
+        /*- The criterion used to retain/release cached data. ``LRU`` deletes the
+        least recently used item first. ``COST`` deletes the item with the
+        smallest product of access frequency and measured re-read time per unit
+        of memory, aged so that unused items eventually leave the cache. -*/
+        options.add_str("CACHETYPE", "LRU", "LRU COST");
         /*- Do Sekino-Bartlett size-extensive model-III? -*/
         options.add_bool("SEKINO", false);
         /*- Do use DIIS extrapolation to accelerate convergence? -*/
@@ -2244,8 +2264,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         cache used by the libdpd codes. A value of ``LOW`` selects a "low priority"
         scheme in which the deletion of items from the cache is based on
         pre-programmed priorities. A value of LRU selects a "least recently used"
-        scheme in which the oldest item in the cache will be the first one deleted. -*/
-        options.add_str("CACHETYPE", "LOW", "LOW LRU");
+        scheme in which the oldest item in the cache will be the first one deleted.
+        A value of ``COST`` selects a cost-aware scheme in which the item with the
+        smallest product of access frequency and measured re-read time per unit
+        of memory is deleted first; cache statistics are printed at the end. -*/
+        options.add_str("CACHETYPE", "LOW", "LOW LRU COST");
         /*- Number of threads -*/
         options.add_int("CC_NUM_THREADS", 1);
         /*- Do use DIIS extrapolation to accelerate convergence? -*/
@@ -2342,6 +2365,15 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("OPDM_RELAX", true);
         /*- Do compute one-particle density matrix? -*/
         options.add_bool("ONEPDM", false);
+        /*- Algorithm for the RHF DF-MP2 energy. LAPLACE uses a Laplace quadrature of the denominator: the
+        opposite-spin energy costs $\mathcal{O}(N^4)$ per point, and the same-spin exchange is screened over
+        localized pseudo-orbital pairs. Gradients always use the canonical algorithm. -*/
+        options.add_str("DFMP2_ENERGY_ALGORITHM", "CANONICAL", "CANONICAL LAPLACE");
+        /*- Maximum error norm of the Laplace quadrature of the denominator -*/
+        options.add_double("DFMP2_LAPLACE_DELTA", 1.0E-8);
+        /*- Truncation of the Laplace pseudo-density Cholesky factors, and pair bound [Eh] below which
+        exchange pairs are skipped -*/
+        options.add_double("DFMP2_LAPLACE_CUTOFF", 1.0E-10);
     }
     if (name == "DFEP2" || options.read_globals()) {
         /*- MODULEDESCRIPTION Performs density-fitted EP2 computations for RHF reference wavefunctions. -*/
@@ -2926,8 +2958,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_str("MP2_AMP_TYPE", "DIRECT", "DIRECT CONV");
         /*- Type of the CCSD PPL term. -*/
         options.add_str("PPL_TYPE", "AUTO", "LOW_MEM HIGH_MEM CD AUTO");
-        /*- The algorithm to handle (ia|bc) type integrals that used for (T) correction. -*/
-        options.add_str("TRIPLES_IABC_TYPE", "DISK", "INCORE AUTO DIRECT DISK");
+        /*- The algorithm to handle (ia|bc) type integrals that used for (T) correction. STREAM forms
+        the (ia|bc) of each ijk in the (T) loop from Q-blocks of the DF integrals, reading the next block
+        from disk while the current one is used, and keeps only O(V^3) of them in core. -*/
+        options.add_str("TRIPLES_IABC_TYPE", "DISK", "INCORE AUTO DIRECT DISK STREAM");
 
         /*- Do compute natural orbitals? -*/
         options.add_bool("NAT_ORBS", false);
@@ -0,0 +1,66 @@
+import pytest
+import numpy as np
+import psi4
+from .utils import compare_arrays, compare_integers, compare_values
+
+pytestmark = pytest.mark.quick
+
+
+def _build_manager(nvec, shape, seed=7):
+    diis = psi4.core.DIISManager(nvec, "pytest DIIS", psi4.core.DIISManager.RemovalPolicy.LargestError,
+                                 psi4.core.DIISManager.StoragePolicy.InCore)
+    rng = np.random.RandomState(seed)
+    states = [rng.rand(*shape) for _ in range(nvec)]
+    errors = [rng.rand(*shape) - 0.5 for _ in range(nvec)]
+
+    diis.set_error_vector_size(psi4.core.Matrix.from_array(errors[0]))
+    diis.set_vector_size(psi4.core.Matrix.from_array(states[0]))
+    for state, error in zip(states, errors):
+        diis.add_entry(psi4.core.Matrix.from_array(state), psi4.core.Matrix.from_array(error))
+
+    return diis, states, errors
+
+
+def test_diis_extrapolate_with_coefficients():
+    """extrapolate_with_coefficients() with the DIIS coefficients reproduces extrapolate(),
+    and with any other coefficients gives that combination of the subspace vectors"""
+
+    diis, states, errors = _build_manager(4, (3, 5))
+    assert compare_integers(4, diis.subspace_size(), "Subspace size")
+
+    # Error dot products, as used by ADIIS/EDIIS-type schemes
+    ref_dots = np.array([[np.vdot(ei, ej) for ej in errors] for ei in errors])
+    assert compare_arrays(ref_dots, diis.error_dot_products().np, 10, "Error vector dot products")
+
+    coefficients = diis.diis_coefficients()
+    assert compare_values(1.0, sum(coefficients), 10, "DIIS coefficients sum to one")
+
+    extrapolated = psi4.core.Matrix(3, 5)
+    diis.extrapolate(extrapolated)
+    combined = psi4.core.Matrix(3, 5)
+    diis.extrapolate_with_coefficients(coefficients, combined)
+    assert compare_arrays(extrapolated.np, combined.np, 10, "Combination with the DIIS coefficients")
+
+    blend = [0.1, 0.2, 0.3, 0.4]
+    diis.extrapolate_with_coefficients(blend, combined)
+    ref = sum(c * s for c, s in zip(blend, states))
+    assert compare_arrays(ref, combined.np, 10, "Combination with given coefficients")
+
+    with pytest.raises(Exception):
+        diis.extrapolate_with_coefficients([1.0], combined)
+
+
+def test_diis_reset_subspace():
+    """After reset_subspace() the in-core stores are rebuilt for the new entries"""
+
+    diis, states, errors = _build_manager(3, (2, 2))
+    diis.reset_subspace()
+    assert compare_integers(0, diis.subspace_size(), "Subspace size after reset")
+
+    rng = np.random.RandomState(11)
+    state = rng.rand(2, 2)
+    diis.add_entry(psi4.core.Matrix.from_array(state), psi4.core.Matrix.from_array(rng.rand(2, 2)))
+
+    extrapolated = psi4.core.Matrix(2, 2)
+    diis.extrapolate(extrapolated)
+    assert compare_arrays(state, extrapolated.np, 10, "One-vector subspace extrapolates to itself")